@@ -0,0 +1,7 @@
+CREATE TABLE IF NOT EXISTS wd_general.revoked_tokens (
+    company_id TEXT NOT NULL,
+    user_id TEXT NOT NULL,
+    revoked_before TIMESTAMPTZ NOT NULL,
+    updated TIMESTAMPTZ NOT NULL DEFAULT NOW(),
+    PRIMARY KEY (company_id, user_id)
+);
@@ -0,0 +1,16 @@
+CREATE TABLE IF NOT EXISTS wd_general.jobs (
+    id TEXT PRIMARY KEY,
+    kind TEXT NOT NULL,
+    company_id TEXT NOT NULL,
+    subject_id TEXT NOT NULL,
+    status TEXT NOT NULL DEFAULT 'pending',
+    attempts INTEGER NOT NULL DEFAULT 0,
+    run_after TIMESTAMPTZ NOT NULL DEFAULT NOW(),
+    error TEXT,
+    created TIMESTAMPTZ NOT NULL DEFAULT NOW(),
+    updated TIMESTAMPTZ NOT NULL DEFAULT NOW(),
+    UNIQUE (kind, company_id, subject_id)
+);
+
+CREATE INDEX IF NOT EXISTS idx_jobs_due ON wd_general.jobs(run_after)
+    WHERE status IN ('pending', 'running');
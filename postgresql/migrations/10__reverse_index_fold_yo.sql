@@ -0,0 +1,15 @@
+INSERT INTO ${SCHEMA}.reverse_index_terms (key)
+SELECT replace(key, 'ё', 'е') FROM ${SCHEMA}.reverse_index_terms
+WHERE key LIKE '%ё%'
+ON CONFLICT (key) DO NOTHING;
+
+INSERT INTO ${SCHEMA}.reverse_index_postings (term_id, ordinal)
+SELECT folded.id, p.ordinal
+FROM ${SCHEMA}.reverse_index_postings p
+JOIN ${SCHEMA}.reverse_index_terms t ON t.id = p.term_id
+JOIN ${SCHEMA}.reverse_index_terms folded ON folded.key = replace(t.key, 'ё', 'е')
+WHERE t.key LIKE '%ё%'
+ON CONFLICT DO NOTHING;
+
+DELETE FROM ${SCHEMA}.reverse_index_terms
+WHERE key LIKE '%ё%';
@@ -0,0 +1,53 @@
+-- Keeps notification_counters of the schema of the table in sync, once per
+-- statement so that a fan-out to many users updates each counter once.
+-- Deletes only decrement existing counters: rows removed together with their
+-- employee must not recreate the counter. Counters are locked in user_id
+-- order, so statements changing the counters of the same users concurrently
+-- do not deadlock. Every user whose counter changed is announced on the
+-- "notifications" channel as "<schema>/<user_id>".
+CREATE OR REPLACE FUNCTION count_unread_notifications()
+RETURNS TRIGGER AS $$
+DECLARE
+    deltas TEXT;
+BEGIN
+    IF TG_OP = 'INSERT' THEN
+        deltas := 'SELECT user_id, COUNT(*) AS delta FROM new_rows '
+                  'WHERE NOT is_read GROUP BY user_id';
+    ELSIF TG_OP = 'UPDATE' THEN
+        deltas := 'SELECT user_id, SUM(delta) AS delta FROM ('
+                  'SELECT user_id, CASE WHEN is_read THEN 0 ELSE 1 END AS delta FROM new_rows '
+                  'UNION ALL '
+                  'SELECT user_id, CASE WHEN is_read THEN 0 ELSE -1 END FROM old_rows'
+                  ') changes GROUP BY user_id HAVING SUM(delta) <> 0';
+    ELSE
+        deltas := 'SELECT user_id, -COUNT(*) AS delta FROM old_rows '
+                  'WHERE NOT is_read GROUP BY user_id';
+    END IF;
+
+    IF TG_OP = 'DELETE' THEN
+        EXECUTE format(
+            'SELECT 1 FROM %I.notification_counters '
+            'WHERE user_id IN (SELECT user_id FROM (%s) deltas) '
+            'ORDER BY user_id FOR UPDATE',
+            TG_TABLE_SCHEMA, deltas);
+        EXECUTE format(
+            'UPDATE %I.notification_counters counters '
+            'SET unread = counters.unread + deltas.delta '
+            'FROM (%s) deltas WHERE counters.user_id = deltas.user_id',
+            TG_TABLE_SCHEMA, deltas);
+    ELSE
+        EXECUTE format(
+            'INSERT INTO %I.notification_counters AS counters (user_id, unread) '
+            '%s ORDER BY user_id '
+            'ON CONFLICT (user_id) '
+            'DO UPDATE SET unread = counters.unread + EXCLUDED.unread',
+            TG_TABLE_SCHEMA, deltas);
+    END IF;
+
+    -- Delivered on commit to the instances listening on the channel
+    EXECUTE format(
+        'SELECT pg_notify(%L, %L || ''/'' || user_id) FROM (%s) deltas',
+        'notifications', TG_TABLE_SCHEMA, deltas);
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
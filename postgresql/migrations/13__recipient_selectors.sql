@@ -0,0 +1,3 @@
+CREATE INDEX IF NOT EXISTS idx_employee_team_by_team_id ON ${SCHEMA}.employee_team(team_id);
+
+CREATE INDEX IF NOT EXISTS idx_employee_by_subcompany ON ${SCHEMA}.employees(subcompany);
@@ -0,0 +1,56 @@
+DROP TABLE IF EXISTS ${SCHEMA}.broadcasts;
+
+-- Notification stored once for a whole audience: the company, a team or a
+-- subcompany, audience_id is NULL for the company
+CREATE TABLE IF NOT EXISTS ${SCHEMA}.broadcasts (
+    id TEXT PRIMARY KEY NOT NULL,
+    type TEXT NOT NULL,
+    text TEXT NOT NULL,
+    audience TEXT NOT NULL,
+    audience_id TEXT,
+    sender_id TEXT,
+    created TIMESTAMPTZ NOT NULL DEFAULT NOW(),
+    FOREIGN KEY (sender_id) REFERENCES ${SCHEMA}.employees (id) ON DELETE SET NULL
+);
+
+CREATE INDEX IF NOT EXISTS idx_broadcasts_feed
+ON ${SCHEMA}.broadcasts(created DESC, id DESC);
+
+DROP TABLE IF EXISTS ${SCHEMA}.broadcast_read_markers;
+
+-- Broadcasts a user has read: all created up to read_until and the ones
+-- listed in read_ids, which only keeps broadcasts newer than read_until
+CREATE TABLE IF NOT EXISTS ${SCHEMA}.broadcast_read_markers (
+    user_id TEXT PRIMARY KEY NOT NULL,
+    read_until TIMESTAMPTZ NOT NULL DEFAULT '-infinity',
+    read_ids TEXT[] NOT NULL DEFAULT ARRAY []::TEXT[],
+    FOREIGN KEY (user_id) REFERENCES ${SCHEMA}.employees (id) ON DELETE CASCADE
+);
+
+-- "<schema>/*" wakes every user of the company, the audience is resolved
+-- by the readers
+CREATE OR REPLACE FUNCTION announce_broadcasts()
+RETURNS TRIGGER AS $$
+BEGIN
+    PERFORM pg_notify('notifications', TG_TABLE_SCHEMA || '/*');
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE TRIGGER after_insert_broadcasts
+AFTER INSERT ON ${SCHEMA}.broadcasts
+FOR EACH STATEMENT
+EXECUTE FUNCTION announce_broadcasts();
+
+CREATE OR REPLACE FUNCTION announce_broadcast_reads()
+RETURNS TRIGGER AS $$
+BEGIN
+    PERFORM pg_notify('notifications', TG_TABLE_SCHEMA || '/' || NEW.user_id);
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE TRIGGER after_write_broadcast_read_markers
+AFTER INSERT OR UPDATE ON ${SCHEMA}.broadcast_read_markers
+FOR EACH ROW
+EXECUTE FUNCTION announce_broadcast_reads();
@@ -0,0 +1,18 @@
+ALTER TABLE ${SCHEMA}.employees
+ADD COLUMN IF NOT EXISTS updated TIMESTAMPTZ NOT NULL DEFAULT NOW();
+
+CREATE INDEX IF NOT EXISTS idx_employee_by_updated ON ${SCHEMA}.employees(updated);
+
+-- The org tree cache reads only the employees updated since its last update
+CREATE OR REPLACE FUNCTION touch_employees()
+RETURNS TRIGGER AS $$
+BEGIN
+    NEW.updated := NOW();
+    RETURN NEW;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE TRIGGER before_update_employees
+BEFORE UPDATE ON ${SCHEMA}.employees
+FOR EACH ROW
+EXECUTE FUNCTION touch_employees();
@@ -0,0 +1,36 @@
+ALTER TABLE ${SCHEMA}.employees
+ADD COLUMN IF NOT EXISTS created TIMESTAMPTZ;
+
+-- Employees added before the column existed have seen every broadcast
+UPDATE ${SCHEMA}.employees SET created = '-infinity' WHERE created IS NULL;
+
+ALTER TABLE ${SCHEMA}.employees
+ALTER COLUMN created SET DEFAULT NOW(),
+ALTER COLUMN created SET NOT NULL;
+
+-- Members see the broadcasts to their team sent after they joined it
+ALTER TABLE ${SCHEMA}.employee_team
+ADD COLUMN IF NOT EXISTS created TIMESTAMPTZ;
+
+UPDATE ${SCHEMA}.employee_team SET created = '-infinity' WHERE created IS NULL;
+
+ALTER TABLE ${SCHEMA}.employee_team
+ALTER COLUMN created SET DEFAULT NOW(),
+ALTER COLUMN created SET NOT NULL;
+
+-- A send is one broadcast to all the groups it selects: audience is
+-- 'company', or 'groups' for the teams and subcompanies listed on it
+ALTER TABLE ${SCHEMA}.broadcasts
+ADD COLUMN IF NOT EXISTS team_ids TEXT[] NOT NULL DEFAULT ARRAY []::TEXT[],
+ADD COLUMN IF NOT EXISTS subcompanies TEXT[] NOT NULL DEFAULT ARRAY []::TEXT[];
+
+UPDATE ${SCHEMA}.broadcasts
+SET audience = 'groups', team_ids = ARRAY[audience_id]
+WHERE audience = 'team';
+
+UPDATE ${SCHEMA}.broadcasts
+SET audience = 'groups', subcompanies = ARRAY[audience_id]
+WHERE audience = 'subcompany';
+
+ALTER TABLE ${SCHEMA}.broadcasts
+DROP COLUMN IF EXISTS audience_id;
@@ -0,0 +1,30 @@
+-- The attendance calendar reads only the actions and team memberships
+-- updated since its last update. They carry their own `updated`, so that
+-- attendance writes leave the employee rows and their indexes alone.
+ALTER TABLE ${SCHEMA}.actions
+ADD COLUMN IF NOT EXISTS updated TIMESTAMPTZ NOT NULL DEFAULT NOW();
+
+CREATE INDEX IF NOT EXISTS idx_actions_by_updated ON ${SCHEMA}.actions(updated);
+
+ALTER TABLE ${SCHEMA}.employee_team
+ADD COLUMN IF NOT EXISTS updated TIMESTAMPTZ NOT NULL DEFAULT NOW();
+
+CREATE INDEX IF NOT EXISTS idx_employee_team_by_updated ON ${SCHEMA}.employee_team(updated);
+
+CREATE OR REPLACE FUNCTION touch_rows()
+RETURNS TRIGGER AS $$
+BEGIN
+    NEW.updated := NOW();
+    RETURN NEW;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE TRIGGER before_update_actions
+BEFORE UPDATE ON ${SCHEMA}.actions
+FOR EACH ROW
+EXECUTE FUNCTION touch_rows();
+
+CREATE TRIGGER before_update_employee_team
+BEFORE UPDATE ON ${SCHEMA}.employee_team
+FOR EACH ROW
+EXECUTE FUNCTION touch_rows();
@@ -0,0 +1,38 @@
+ALTER TABLE ${SCHEMA}.employees
+ADD COLUMN ordinal INTEGER GENERATED BY DEFAULT AS IDENTITY UNIQUE;
+
+CREATE TABLE IF NOT EXISTS ${SCHEMA}.reverse_index_terms (
+    id INTEGER GENERATED ALWAYS AS IDENTITY PRIMARY KEY,
+    key TEXT NOT NULL UNIQUE
+);
+
+CREATE INDEX reverse_index_terms_trgm_idx ON ${SCHEMA}.reverse_index_terms USING GIST (key gist_trgm_ops);
+
+CREATE TABLE IF NOT EXISTS ${SCHEMA}.reverse_index_postings (
+    term_id INTEGER NOT NULL,
+    ordinal INTEGER NOT NULL,
+    PRIMARY KEY (term_id, ordinal),
+    FOREIGN KEY (term_id) REFERENCES ${SCHEMA}.reverse_index_terms (id) ON DELETE CASCADE,
+    FOREIGN KEY (ordinal) REFERENCES ${SCHEMA}.employees (ordinal) ON DELETE CASCADE
+);
+
+CREATE INDEX idx_reverse_index_postings_by_ordinal ON ${SCHEMA}.reverse_index_postings(ordinal);
+
+INSERT INTO ${SCHEMA}.reverse_index_terms (key)
+SELECT key FROM ${SCHEMA}.reverse_index
+ON CONFLICT (key) DO NOTHING;
+
+INSERT INTO ${SCHEMA}.reverse_index_postings (term_id, ordinal)
+SELECT t.id, e.ordinal
+FROM ${SCHEMA}.reverse_index ri
+JOIN ${SCHEMA}.reverse_index_terms t ON t.key = ri.key
+CROSS JOIN LATERAL unnest(ri.ids) AS employee_id
+JOIN ${SCHEMA}.employees e ON e.id = employee_id
+ON CONFLICT DO NOTHING;
+
+DELETE FROM ${SCHEMA}.reverse_index_terms t
+WHERE NOT EXISTS (
+    SELECT 1 FROM ${SCHEMA}.reverse_index_postings p WHERE p.term_id = t.id
+);
+
+DROP TABLE IF EXISTS ${SCHEMA}.reverse_index;
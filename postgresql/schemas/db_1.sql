@@ -16,6 +16,31 @@ CREATE TABLE IF NOT EXISTS wd_general.auth_tokens (
     updated TIMESTAMPTZ NOT NULL DEFAULT NOW()
 );
 
+CREATE TABLE IF NOT EXISTS wd_general.revoked_tokens (
+    company_id TEXT NOT NULL,
+    user_id TEXT NOT NULL,
+    revoked_before TIMESTAMPTZ NOT NULL,
+    updated TIMESTAMPTZ NOT NULL DEFAULT NOW(),
+    PRIMARY KEY (company_id, user_id)
+);
+
+CREATE TABLE IF NOT EXISTS wd_general.jobs (
+    id TEXT PRIMARY KEY,
+    kind TEXT NOT NULL,
+    company_id TEXT NOT NULL,
+    subject_id TEXT NOT NULL,
+    status TEXT NOT NULL DEFAULT 'pending',
+    attempts INTEGER NOT NULL DEFAULT 0,
+    run_after TIMESTAMPTZ NOT NULL DEFAULT NOW(),
+    error TEXT,
+    created TIMESTAMPTZ NOT NULL DEFAULT NOW(),
+    updated TIMESTAMPTZ NOT NULL DEFAULT NOW(),
+    UNIQUE (kind, company_id, subject_id)
+);
+
+CREATE INDEX IF NOT EXISTS idx_jobs_due ON wd_general.jobs(run_after)
+    WHERE status IN ('pending', 'running');
+
 CREATE EXTENSION pg_trgm;
 
 CREATE SCHEMA IF NOT EXISTS working_day_first;
@@ -36,10 +61,27 @@ CREATE TABLE IF NOT EXISTS working_day_first.employees (
     telegram_id TEXT,
     vk_id TEXT,
     team TEXT, -- deprecated TODO: remove
-    subcompany TEXT NOT NULL DEFAULT 'first'
+    subcompany TEXT NOT NULL DEFAULT 'first',
+    updated TIMESTAMPTZ NOT NULL DEFAULT NOW(),
+    created TIMESTAMPTZ NOT NULL DEFAULT NOW()
 );
 
 CREATE INDEX idx_employee_by_head ON working_day_first.employees(head_id);
+CREATE INDEX idx_employee_by_subcompany ON working_day_first.employees(subcompany);
+CREATE INDEX idx_employee_by_updated ON working_day_first.employees(updated);
+
+CREATE OR REPLACE FUNCTION touch_employees()
+RETURNS TRIGGER AS $$
+BEGIN
+    NEW.updated := NOW();
+    RETURN NEW;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE TRIGGER before_update_employees
+BEFORE UPDATE ON working_day_first.employees
+FOR EACH ROW
+EXECUTE FUNCTION touch_employees();
 DROP TABLE IF EXISTS working_day_first.notifications;
 
 CREATE TABLE IF NOT EXISTS working_day_first.notifications (
@@ -54,7 +96,143 @@ CREATE TABLE IF NOT EXISTS working_day_first.notifications (
     FOREIGN KEY (user_id) REFERENCES working_day_first.employees (id) ON DELETE CASCADE
 );
 
-CREATE INDEX idx_notifications_by_user_id ON working_day_first.notifications(user_id);
+CREATE INDEX idx_notifications_feed ON working_day_first.notifications(user_id, created DESC, id DESC);
+
+DROP TABLE IF EXISTS working_day_first.notification_counters;
+
+CREATE TABLE IF NOT EXISTS working_day_first.notification_counters (
+    user_id TEXT PRIMARY KEY NOT NULL,
+    unread INTEGER NOT NULL DEFAULT 0,
+    FOREIGN KEY (user_id) REFERENCES working_day_first.employees (id) ON DELETE CASCADE
+);
+
+-- Keeps notification_counters of the schema of the table in sync, once per
+-- statement so that a fan-out to many users updates each counter once.
+-- Deletes only decrement existing counters: rows removed together with their
+-- employee must not recreate the counter. Counters are locked in user_id
+-- order, so statements changing the counters of the same users concurrently
+-- do not deadlock. Every user whose counter changed is announced on the
+-- "notifications" channel as "<schema>/<user_id>".
+CREATE OR REPLACE FUNCTION count_unread_notifications()
+RETURNS TRIGGER AS $$
+DECLARE
+    deltas TEXT;
+BEGIN
+    IF TG_OP = 'INSERT' THEN
+        deltas := 'SELECT user_id, COUNT(*) AS delta FROM new_rows '
+                  'WHERE NOT is_read GROUP BY user_id';
+    ELSIF TG_OP = 'UPDATE' THEN
+        deltas := 'SELECT user_id, SUM(delta) AS delta FROM ('
+                  'SELECT user_id, CASE WHEN is_read THEN 0 ELSE 1 END AS delta FROM new_rows '
+                  'UNION ALL '
+                  'SELECT user_id, CASE WHEN is_read THEN 0 ELSE -1 END FROM old_rows'
+                  ') changes GROUP BY user_id HAVING SUM(delta) <> 0';
+    ELSE
+        deltas := 'SELECT user_id, -COUNT(*) AS delta FROM old_rows '
+                  'WHERE NOT is_read GROUP BY user_id';
+    END IF;
+
+    IF TG_OP = 'DELETE' THEN
+        EXECUTE format(
+            'SELECT 1 FROM %I.notification_counters '
+            'WHERE user_id IN (SELECT user_id FROM (%s) deltas) '
+            'ORDER BY user_id FOR UPDATE',
+            TG_TABLE_SCHEMA, deltas);
+        EXECUTE format(
+            'UPDATE %I.notification_counters counters '
+            'SET unread = counters.unread + deltas.delta '
+            'FROM (%s) deltas WHERE counters.user_id = deltas.user_id',
+            TG_TABLE_SCHEMA, deltas);
+    ELSE
+        EXECUTE format(
+            'INSERT INTO %I.notification_counters AS counters (user_id, unread) '
+            '%s ORDER BY user_id '
+            'ON CONFLICT (user_id) '
+            'DO UPDATE SET unread = counters.unread + EXCLUDED.unread',
+            TG_TABLE_SCHEMA, deltas);
+    END IF;
+
+    -- Delivered on commit to the instances listening on the channel
+    EXECUTE format(
+        'SELECT pg_notify(%L, %L || ''/'' || user_id) FROM (%s) deltas',
+        'notifications', TG_TABLE_SCHEMA, deltas);
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE TRIGGER after_insert_notifications
+AFTER INSERT ON working_day_first.notifications
+REFERENCING NEW TABLE AS new_rows
+FOR EACH STATEMENT
+EXECUTE FUNCTION count_unread_notifications();
+
+CREATE TRIGGER after_update_notifications
+AFTER UPDATE ON working_day_first.notifications
+REFERENCING OLD TABLE AS old_rows NEW TABLE AS new_rows
+FOR EACH STATEMENT
+EXECUTE FUNCTION count_unread_notifications();
+
+CREATE TRIGGER after_delete_notifications
+AFTER DELETE ON working_day_first.notifications
+REFERENCING OLD TABLE AS old_rows
+FOR EACH STATEMENT
+EXECUTE FUNCTION count_unread_notifications();
+DROP TABLE IF EXISTS working_day_first.broadcasts;
+
+-- Notification stored once for a whole audience: audience is 'company', or
+-- 'groups' for the teams and subcompanies listed on it
+CREATE TABLE IF NOT EXISTS working_day_first.broadcasts (
+    id TEXT PRIMARY KEY NOT NULL,
+    type TEXT NOT NULL,
+    text TEXT NOT NULL,
+    audience TEXT NOT NULL,
+    sender_id TEXT,
+    created TIMESTAMPTZ NOT NULL DEFAULT NOW(),
+    team_ids TEXT[] NOT NULL DEFAULT ARRAY []::TEXT[],
+    subcompanies TEXT[] NOT NULL DEFAULT ARRAY []::TEXT[],
+    FOREIGN KEY (sender_id) REFERENCES working_day_first.employees (id) ON DELETE SET NULL
+);
+
+CREATE INDEX idx_broadcasts_feed ON working_day_first.broadcasts(created DESC, id DESC);
+
+DROP TABLE IF EXISTS working_day_first.broadcast_read_markers;
+
+-- Broadcasts a user has read: all created up to read_until and the ones
+-- listed in read_ids, which only keeps broadcasts newer than read_until
+CREATE TABLE IF NOT EXISTS working_day_first.broadcast_read_markers (
+    user_id TEXT PRIMARY KEY NOT NULL,
+    read_until TIMESTAMPTZ NOT NULL DEFAULT '-infinity',
+    read_ids TEXT[] NOT NULL DEFAULT ARRAY []::TEXT[],
+    FOREIGN KEY (user_id) REFERENCES working_day_first.employees (id) ON DELETE CASCADE
+);
+
+-- "<schema>/*" wakes every user of the company, the audience is resolved
+-- by the readers
+CREATE OR REPLACE FUNCTION announce_broadcasts()
+RETURNS TRIGGER AS $$
+BEGIN
+    PERFORM pg_notify('notifications', TG_TABLE_SCHEMA || '/*');
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE TRIGGER after_insert_broadcasts
+AFTER INSERT ON working_day_first.broadcasts
+FOR EACH STATEMENT
+EXECUTE FUNCTION announce_broadcasts();
+
+CREATE OR REPLACE FUNCTION announce_broadcast_reads()
+RETURNS TRIGGER AS $$
+BEGIN
+    PERFORM pg_notify('notifications', TG_TABLE_SCHEMA || '/' || NEW.user_id);
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE TRIGGER after_write_broadcast_read_markers
+AFTER INSERT OR UPDATE ON working_day_first.broadcast_read_markers
+FOR EACH ROW
+EXECUTE FUNCTION announce_broadcast_reads();
 DROP TABLE IF EXISTS working_day_first.actions;
 
 CREATE TABLE IF NOT EXISTS working_day_first.actions (
@@ -66,10 +244,25 @@ CREATE TABLE IF NOT EXISTS working_day_first.actions (
     status TEXT,
     underlying_action_id TEXT,
     blocking_actions_ids TEXT[] NOT NULL DEFAULT ARRAY []::TEXT[],
+    updated TIMESTAMPTZ NOT NULL DEFAULT NOW(),
     FOREIGN KEY (user_id) REFERENCES working_day_first.employees (id) ON DELETE CASCADE
 );
 
 CREATE INDEX idx_actions_by_user_id ON working_day_first.actions(user_id);
+CREATE INDEX idx_actions_by_updated ON working_day_first.actions(updated);
+
+CREATE OR REPLACE FUNCTION touch_rows()
+RETURNS TRIGGER AS $$
+BEGIN
+    NEW.updated := NOW();
+    RETURN NEW;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE TRIGGER before_update_actions
+BEFORE UPDATE ON working_day_first.actions
+FOR EACH ROW
+EXECUTE FUNCTION touch_rows();
 
 CREATE INDEX idx_actions_by_user_id_start_date ON working_day_first.actions(user_id ASC, start_date ASC);
 
@@ -145,11 +338,21 @@ DROP TABLE IF EXISTS working_day_first.employee_team;
 CREATE TABLE IF NOT EXISTS working_day_first.employee_team (
   employee_id TEXT NOT NULL,
   team_id TEXT NOT NULL,
+  created TIMESTAMPTZ NOT NULL DEFAULT NOW(),
+  updated TIMESTAMPTZ NOT NULL DEFAULT NOW(),
   PRIMARY KEY (employee_id, team_id),
   FOREIGN KEY (employee_id) REFERENCES working_day_first.employees (id) ON DELETE CASCADE,
   FOREIGN KEY (team_id) REFERENCES working_day_first.teams (id) ON DELETE CASCADE
 );
 
+CREATE INDEX idx_employee_team_by_team_id ON working_day_first.employee_team(team_id);
+CREATE INDEX idx_employee_team_by_updated ON working_day_first.employee_team(updated);
+
+CREATE TRIGGER before_update_employee_team
+BEFORE UPDATE ON working_day_first.employee_team
+FOR EACH ROW
+EXECUTE FUNCTION touch_rows();
+
 CREATE TYPE wd_general.inventory_item AS (
     name TEXT,
     description TEXT,
@@ -158,3 +361,56 @@ CREATE TYPE wd_general.inventory_item AS (
 
 ALTER TABLE working_day_first.employees
 ADD COLUMN inventory wd_general.inventory_item[] NOT NULL DEFAULT ARRAY[]::wd_general.inventory_item[];
+ALTER TABLE working_day_first.employees
+ADD COLUMN ordinal INTEGER GENERATED BY DEFAULT AS IDENTITY UNIQUE;
+
+CREATE TABLE IF NOT EXISTS working_day_first.reverse_index_terms (
+    id INTEGER GENERATED ALWAYS AS IDENTITY PRIMARY KEY,
+    key TEXT NOT NULL UNIQUE
+);
+
+CREATE INDEX reverse_index_terms_trgm_idx ON working_day_first.reverse_index_terms USING GIST (key gist_trgm_ops);
+
+CREATE TABLE IF NOT EXISTS working_day_first.reverse_index_postings (
+    term_id INTEGER NOT NULL,
+    ordinal INTEGER NOT NULL,
+    PRIMARY KEY (term_id, ordinal),
+    FOREIGN KEY (term_id) REFERENCES working_day_first.reverse_index_terms (id) ON DELETE CASCADE,
+    FOREIGN KEY (ordinal) REFERENCES working_day_first.employees (ordinal) ON DELETE CASCADE
+);
+
+CREATE INDEX idx_reverse_index_postings_by_ordinal ON working_day_first.reverse_index_postings(ordinal);
+
+INSERT INTO working_day_first.reverse_index_terms (key)
+SELECT key FROM working_day_first.reverse_index
+ON CONFLICT (key) DO NOTHING;
+
+INSERT INTO working_day_first.reverse_index_postings (term_id, ordinal)
+SELECT t.id, e.ordinal
+FROM working_day_first.reverse_index ri
+JOIN working_day_first.reverse_index_terms t ON t.key = ri.key
+CROSS JOIN LATERAL unnest(ri.ids) AS employee_id
+JOIN working_day_first.employees e ON e.id = employee_id
+ON CONFLICT DO NOTHING;
+
+DELETE FROM working_day_first.reverse_index_terms t
+WHERE NOT EXISTS (
+    SELECT 1 FROM working_day_first.reverse_index_postings p WHERE p.term_id = t.id
+);
+
+DROP TABLE IF EXISTS working_day_first.reverse_index;
+INSERT INTO working_day_first.reverse_index_terms (key)
+SELECT replace(key, 'ё', 'е') FROM working_day_first.reverse_index_terms
+WHERE key LIKE '%ё%'
+ON CONFLICT (key) DO NOTHING;
+
+INSERT INTO working_day_first.reverse_index_postings (term_id, ordinal)
+SELECT folded.id, p.ordinal
+FROM working_day_first.reverse_index_postings p
+JOIN working_day_first.reverse_index_terms t ON t.id = p.term_id
+JOIN working_day_first.reverse_index_terms folded ON folded.key = replace(t.key, 'ё', 'е')
+WHERE t.key LIKE '%ё%'
+ON CONFLICT DO NOTHING;
+
+DELETE FROM working_day_first.reverse_index_terms
+WHERE key LIKE '%ё%';
@@ -0,0 +1,188 @@
+import asyncio
+import os
+import shutil
+import socket
+import subprocess
+import xmlrpc.client
+from concurrent.futures import ThreadPoolExecutor
+
+
+class QueueFull(Exception):
+    pass
+
+
+class ConverterWorker:
+    """One long-lived headless office instance driven through unoserver.
+
+    Every instance has its own profile directory, office refuses to run two
+    instances over one profile.
+    """
+
+    def __init__(self, index, base_port, python):
+        self.index = index
+        self.port = base_port + 2 * index
+        self.uno_port = base_port + 2 * index + 1
+        self.profile = f'/tmp/converter_profile_{index}'
+        self.python = python
+        self.process = None
+        self.ready = asyncio.Event()
+        self.busy = False
+        self.conversions = 0
+        self.restarts = 0
+
+    async def start(self):
+        self.process = await asyncio.create_subprocess_exec(
+            self.python, '-m', 'unoserver.server',
+            '--interface', '127.0.0.1',
+            '--port', str(self.port),
+            '--uno-port', str(self.uno_port),
+            '--user-installation', 'file://' + self.profile,
+            stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+
+    async def stop(self):
+        self.ready.clear()
+        if self.is_alive():
+            self.process.terminate()
+            try:
+                await asyncio.wait_for(self.process.wait(), 10)
+            except asyncio.TimeoutError:
+                self.process.kill()
+                await self.process.wait()
+        self.process = None
+
+    async def restart(self):
+        await self.stop()
+        # A crashed instance can leave a lock in its profile
+        await asyncio.to_thread(
+            shutil.rmtree, self.profile, ignore_errors=True)
+        self.restarts += 1
+        await self.start()
+
+    def is_alive(self):
+        return self.process is not None and self.process.returncode is None
+
+    def is_healthy(self):
+        if not self.is_alive():
+            return False
+        try:
+            with socket.create_connection(('127.0.0.1', self.port), timeout=1):
+                return True
+        except OSError:
+            return False
+
+    def convert(self, docx_path, pdf_path):
+        proxy = xmlrpc.client.ServerProxy(
+            f'http://127.0.0.1:{self.port}', allow_none=True)
+        proxy.convert(docx_path, None, pdf_path, 'pdf')
+
+
+class ConverterPool:
+    """Queue of DOCX to PDF conversions served by a pool of warm workers.
+
+    A worker takes a conversion only while its instance answers, the health
+    check restarts instances that died or stopped listening. A conversion
+    that times out or loses its connection restarts its worker as well.
+    """
+
+    def __init__(self, size, max_queue, timeout, health_interval,
+                 base_port=2100, python='/usr/bin/python3'):
+        self.workers = [ConverterWorker(index, base_port, python)
+                        for index in range(size)]
+        self.queue = asyncio.Queue(maxsize=max_queue)
+        self.timeout = timeout
+        self.health_interval = health_interval
+        self.executor = ThreadPoolExecutor(max_workers=size)
+        self.tasks = []
+
+    @classmethod
+    def from_env(cls):
+        size = int(os.environ.get('CONVERTER_WORKERS', os.cpu_count() or 1))
+        return cls(
+            size=size,
+            max_queue=int(os.environ.get('CONVERTER_MAX_QUEUE', 4 * size)),
+            timeout=float(os.environ.get('CONVERTER_TIMEOUT', 60)),
+            health_interval=float(
+                os.environ.get('CONVERTER_HEALTH_INTERVAL', 5)))
+
+    async def start(self, app):
+        for worker in self.workers:
+            await worker.start()
+        self.tasks = [asyncio.create_task(self._serve(worker))
+                      for worker in self.workers]
+        self.tasks.append(asyncio.create_task(self._check_health()))
+
+    async def stop(self, app):
+        for task in self.tasks:
+            task.cancel()
+        await asyncio.gather(*self.tasks, return_exceptions=True)
+        await asyncio.gather(*(worker.stop() for worker in self.workers))
+        self.executor.shutdown(wait=False)
+
+    def depth(self):
+        return self.queue.qsize()
+
+    def status(self):
+        return {
+            'queued': self.depth(),
+            'max_queue': self.queue.maxsize,
+            'workers': [{
+                'index': worker.index,
+                'ready': worker.ready.is_set(),
+                'busy': worker.busy,
+                'conversions': worker.conversions,
+                'restarts': worker.restarts,
+            } for worker in self.workers],
+        }
+
+    async def convert(self, docx_path, pdf_path):
+        future = asyncio.get_running_loop().create_future()
+        try:
+            self.queue.put_nowait((docx_path, pdf_path, future))
+        except asyncio.QueueFull:
+            raise QueueFull()
+        await future
+
+    async def _serve(self, worker):
+        loop = asyncio.get_running_loop()
+        while True:
+            await worker.ready.wait()
+            docx_path, pdf_path, future = await self.queue.get()
+            if future.done():
+                # The request was cancelled while queued
+                continue
+
+            worker.busy = True
+            try:
+                await asyncio.wait_for(
+                    loop.run_in_executor(
+                        self.executor, worker.convert, docx_path, pdf_path),
+                    self.timeout)
+                worker.conversions += 1
+                if not future.done():
+                    future.set_result(None)
+            except (asyncio.TimeoutError, OSError) as e:
+                await worker.restart()
+                if not future.done():
+                    future.set_exception(e)
+            except Exception as e:
+                if not future.done():
+                    future.set_exception(e)
+            finally:
+                worker.busy = False
+
+    async def _check_health(self):
+        loop = asyncio.get_running_loop()
+        while True:
+            for worker in self.workers:
+                if worker.busy:
+                    continue
+                if not worker.is_alive():
+                    await worker.restart()
+                healthy = await loop.run_in_executor(None, worker.is_healthy)
+                if healthy:
+                    worker.ready.set()
+                else:
+                    worker.ready.clear()
+            await asyncio.sleep(
+                self.health_interval if all(
+                    worker.ready.is_set() for worker in self.workers) else 0.5)
@@ -1,23 +1,19 @@
+import asyncio
+import glob
+import os
 import xml.etree.ElementTree as ET
 from docx import Document
 from docx.oxml.ns import nsdecls
 from docx.oxml import parse_xml
 from datetime import datetime
-import subprocess
 from aiohttp import web
 from sign_document.stamp import create_stamp, StampData
 from s3_client.aws_utils import upload_and_presign
-from threading import Lock
+from .converter_pool import QueueFull
 
-mutex = Lock()
-
-def convert_docx_to_pdf(docx_path, output_pdf_path):
-    with mutex:
-        cmd = [
-            'libreoffice', '--headless', '--convert-to', 'pdf', '--outdir',
-            output_pdf_path, docx_path
-        ]
-        subprocess.run(cmd, check=True)
+# Seconds a caller waits before sending a document again when the converter
+# queue is full
+RETRY_AFTER = 5
 
 
 def plural_form(number, first, second, third):
@@ -78,7 +74,11 @@ def replace_macros_in_word(doc_path, replacements, output_path):
     doc.save(output_path)
 
 def delete_tmp_files(file_key):
-    subprocess.run(['rm', '-rf', '/tmp/' + file_key + '*'])
+    for path in glob.glob('/tmp/' + glob.escape(file_key) + '*'):
+        try:
+            os.remove(path)
+        except FileNotFoundError:
+            pass
 
 
 async def generate_document(request):
@@ -156,20 +156,59 @@ async def generate_document(request):
 
         file_name = file_key + '.docx'
         output_path_word = '/tmp/' + file_name
-        replace_macros_in_word("generate_document/templates/" + company_id + "_" + request_type + ".docx",
-                                replacements, output_path_word)
+        await asyncio.get_running_loop().run_in_executor(
+            None, replace_macros_in_word,
+            "generate_document/templates/" + company_id + "_" + request_type + ".docx",
+            replacements, output_path_word)
 
-        output_path_pdf = '/tmp/' + file_key + '.pdf'
+        stamp_data = StampData(now_date, employee_initials, company_name, employee_id, file_key)
+        return await publish_pdf(request.app['converter_pool'], file_key, stamp_data)
 
-        convert_docx_to_pdf(output_path_word, '/tmp')
+    except Exception as e:
+        return web.Response(status=500, text=str(e))
 
-        output_path_pdf_signed = '/tmp/' + file_key + '_signed.pdf'
-        stamp_data = StampData(now_date, employee_initials, company_name, employee_id, file_key)
-        create_stamp(output_path_pdf, output_path_pdf_signed, stamp_data)
 
-        url = upload_and_presign(output_path_pdf_signed, file_key + '.pdf')
-        delete_tmp_files(file_key)
-        return web.Response(status=200, content_type='text/plain', text=url)
+async def convert_document(request):
+    """Converts a DOCX rendered by the main service to a stamped PDF."""
+    try:
+        query = request.rel_url.query
+        file_key = query['file_key']
+        now_date = datetime.today().strftime('%d.%m.%Y')
+        stamp_data = StampData(now_date, query['employee_initials'],
+                               query.get('company_name', ""),
+                               query['employee_id'], file_key)
+
+        with open('/tmp/' + file_key + '.docx', 'wb') as docx:
+            docx.write(await request.read())
+
+        return await publish_pdf(request.app['converter_pool'], file_key, stamp_data)
 
     except Exception as e:
         return web.Response(status=500, text=str(e))
+
+
+async def publish_pdf(pool, file_key, stamp_data):
+    """Converts /tmp/<file_key>.docx, stamps it and uploads it as <file_key>.pdf."""
+    output_path_word = '/tmp/' + file_key + '.docx'
+    output_path_pdf = '/tmp/' + file_key + '.pdf'
+    output_path_pdf_signed = '/tmp/' + file_key + '_signed.pdf'
+    loop = asyncio.get_running_loop()
+    try:
+        try:
+            await pool.convert(output_path_word, output_path_pdf)
+        except QueueFull:
+            return web.Response(status=503, text='Converter queue is full',
+                                headers={'Retry-After': str(RETRY_AFTER),
+                                         'X-Queue-Depth': str(pool.depth())})
+
+        # Stamping and uploading block, they must not hold up the loop the
+        # converter workers and the other requests are served from
+        await loop.run_in_executor(None, create_stamp, output_path_pdf,
+                                   output_path_pdf_signed, stamp_data)
+        url = await loop.run_in_executor(None, upload_and_presign,
+                                         output_path_pdf_signed,
+                                         file_key + '.pdf')
+        return web.Response(status=200, content_type='text/plain', text=url,
+                            headers={'X-Queue-Depth': str(pool.depth())})
+    finally:
+        delete_tmp_files(file_key)
@@ -1,18 +1,22 @@
 from aiohttp import web
-from generate_document.generate import generate_document
+from generate_document.converter_pool import ConverterPool
+from generate_document.generate import convert_document, generate_document
 from sign_document.sign import sign_document
-import subprocess
 
 
-cmd = [
-    'libreoffice', '--headless', '--convert-to', 'pdf', '--outdir',
-    '/tmp', 'generate_document/templates/esv_create.docx'
-]
-subprocess.run(cmd, check=True)
-subprocess.run(['rm', '/tmp/esv_create.pdf'])
+async def converter_queue(request):
+    return web.json_response(request.app['converter_pool'].status())
+
+
+converter_pool = ConverterPool.from_env()
 
 app = web.Application()
+app['converter_pool'] = converter_pool
+app.on_startup.append(converter_pool.start)
+app.on_cleanup.append(converter_pool.stop)
 app.add_routes([web.post('/document/generate', generate_document)])
+app.add_routes([web.post('/document/convert', convert_document)])
 app.add_routes([web.post('/document/sign', sign_document)])
+app.add_routes([web.get('/document/queue', converter_queue)])
 
 web.run_app(app, host='0.0.0.0', port=3000)
@@ -1,11 +1,20 @@
+import os
+
 import boto3
 
+# The storage can be replaced with a local MinIO through the environment
+ENDPOINT_URL = os.environ.get('S3_ENDPOINT_URL', 'https://storage.yandexcloud.net')
+DOCUMENTS_BUCKET = os.environ.get('S3_DOCUMENTS_BUCKET', 'working-day-documents')
+
+# Every part of a multipart upload but the last one is at least this large
+MIN_PART_SIZE = 5 * 1024 * 1024
+
 storage_client = None
 
 def get_boto_session():
     boto_session = boto3.session.Session(
-        aws_access_key_id='YCAJESGfHPZvOGYgqBjDkrLCZ',
-        aws_secret_access_key='YCOFwp-4AxDaEEKeDBPx6YVuvU8Bqx-Z3hcQdIR8'
+        aws_access_key_id=os.environ.get('S3_ACCESS_KEY_ID', 'YCAJESGfHPZvOGYgqBjDkrLCZ'),
+        aws_secret_access_key=os.environ.get('S3_SECRET_ACCESS_KEY', 'YCOFwp-4AxDaEEKeDBPx6YVuvU8Bqx-Z3hcQdIR8')
     )
     return boto_session
 
@@ -16,23 +25,64 @@ def get_storage_client():
 
     storage_client = get_boto_session().client(
         service_name='s3',
-        endpoint_url='https://storage.yandexcloud.net',
+        endpoint_url=ENDPOINT_URL,
         region_name='ru-central1'
     )
     return storage_client
 
 def download_file(file_key, path_to_file):
     storage_client = get_storage_client()
-    bucket = 'working-day-documents'
+    bucket = DOCUMENTS_BUCKET
     storage_client.download_file(bucket, file_key, path_to_file)
 
 def upload_file(file_path, object_name):
     storage_client = get_storage_client()
-    bucket = 'working-day-documents'
+    bucket = DOCUMENTS_BUCKET
     storage_client.upload_file(file_path, bucket, object_name)
 
 def upload_and_presign(file_path, object_name):
     client = get_storage_client()
-    bucket = 'working-day-documents'
+    bucket = DOCUMENTS_BUCKET
     client.upload_file(file_path, bucket, object_name)
     return client.generate_presigned_url('get_object', Params={'Bucket': bucket, 'Key': object_name}, ExpiresIn=3600)
+
+def get_etag(file_key):
+    storage_client = get_storage_client()
+    return storage_client.head_object(Bucket=DOCUMENTS_BUCKET, Key=file_key)['ETag']
+
+def upload_appended(file_key, etag, size, path_to_file, object_name):
+    """Uploads the file at `path_to_file`, whose first `size` bytes are the
+    object `file_key`, as `object_name`.
+
+    The storage copies the unchanged prefix on its side, only the appended
+    bytes are sent. Objects below the minimal part size are sent as a whole.
+    """
+    storage_client = get_storage_client()
+    if size < MIN_PART_SIZE:
+        storage_client.upload_file(path_to_file, DOCUMENTS_BUCKET, object_name)
+        return
+
+    upload_id = storage_client.create_multipart_upload(
+        Bucket=DOCUMENTS_BUCKET, Key=object_name)['UploadId']
+    try:
+        prefix = storage_client.upload_part_copy(
+            Bucket=DOCUMENTS_BUCKET, Key=object_name, UploadId=upload_id,
+            PartNumber=1,
+            CopySource={'Bucket': DOCUMENTS_BUCKET, 'Key': file_key},
+            CopySourceIfMatch=etag,
+            CopySourceRange=f'bytes=0-{size - 1}')
+        with open(path_to_file, 'rb') as file:
+            file.seek(size)
+            suffix = storage_client.upload_part(
+                Bucket=DOCUMENTS_BUCKET, Key=object_name, UploadId=upload_id,
+                PartNumber=2, Body=file.read())
+        storage_client.complete_multipart_upload(
+            Bucket=DOCUMENTS_BUCKET, Key=object_name, UploadId=upload_id,
+            MultipartUpload={'Parts': [
+                {'PartNumber': 1, 'ETag': prefix['CopyPartResult']['ETag']},
+                {'PartNumber': 2, 'ETag': suffix['ETag']},
+            ]})
+    except Exception:
+        storage_client.abort_multipart_upload(
+            Bucket=DOCUMENTS_BUCKET, Key=object_name, UploadId=upload_id)
+        raise
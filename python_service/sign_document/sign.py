@@ -1,19 +1,112 @@
 from aiohttp import web
+import asyncio
+import contextlib
+import hashlib
+import os
+import shutil
 import uuid
-import subprocess
+from collections import OrderedDict
 from datetime import datetime
-from .stamp import create_stamp, StampData
-from s3_client.aws_utils import download_file, upload_file
+from .stamp import append_stamp, StampData
+from s3_client.aws_utils import download_file, get_etag, upload_appended
+
+CACHE_DIR = os.environ.get('SIGN_CACHE_DIR', '/tmp/sign_cache')
+CACHE_SIZE = int(os.environ.get('SIGN_CACHE_SIZE', '64'))
+
+
+class OriginalsCache:
+    # Исходные документы, скачанные для подписи. Документ на подпись
+    # рассылается многим сотрудникам, поэтому он скачивается один раз
+    # и переиспользуется, пока его ETag в хранилище не изменился
+
+    def __init__(self, directory, size):
+        self.directory = directory
+        self.size = size
+        self.entries = OrderedDict()
+        self.locks = {}
+        # Число запросов, читающих локальную копию, по ее пути
+        self.users = {}
+        os.makedirs(directory, exist_ok=True)
+
+    @contextlib.asynccontextmanager
+    async def use(self, file_key):
+        # Путь к локальной копии и ETag документа. Копия не удаляется,
+        # пока запрос ее использует
+        path, etag = await self.fetch(file_key)
+        self.users[path] = self.users.get(path, 0) + 1
+        self.evict()
+        try:
+            yield path, etag
+        finally:
+            self.users[path] -= 1
+            if self.users[path] == 0:
+                del self.users[path]
+                entry = self.entries.get(file_key)
+                if entry is None or entry[0] != path:
+                    # Копия вытеснена или заменена новой версией
+                    remove_file(path)
+                self.evict()
+
+    async def fetch(self, file_key):
+        loop = asyncio.get_running_loop()
+        lock = self.locks.setdefault(file_key, asyncio.Lock())
+        async with lock:
+            etag = await loop.run_in_executor(None, get_etag, file_key)
+            entry = self.entries.get(file_key)
+            if entry is not None and entry[1] == etag:
+                self.entries.move_to_end(file_key)
+                return entry
+
+            # Каждая версия документа хранится в своем файле, поэтому
+            # новая версия не подменяет файл, который еще читается
+            version = hashlib.sha256((file_key + '\0' + etag).encode()).hexdigest()
+            path = os.path.join(self.directory, version + '.pdf')
+            part = path + '.' + str(uuid.uuid4()) + '.part'
+            await loop.run_in_executor(None, download_file, file_key, part)
+            os.replace(part, path)
+            if entry is not None and entry[0] != path and entry[0] not in self.users:
+                remove_file(entry[0])
+            self.entries[file_key] = (path, etag)
+            self.entries.move_to_end(file_key)
+            return path, etag
+
+    def evict(self):
+        # Копии, которые читаются или скачиваются, остаются в кэше
+        for file_key in list(self.entries):
+            if len(self.entries) <= self.size:
+                break
+            path, _ = self.entries[file_key]
+            lock = self.locks.get(file_key)
+            if path in self.users or (lock is not None and lock.locked()):
+                continue
+            del self.entries[file_key]
+            self.locks.pop(file_key, None)
+            remove_file(path)
+
+
+def remove_file(path):
+    if os.path.exists(path):
+        os.remove(path)
+
+
+originals = OriginalsCache(CACHE_DIR, CACHE_SIZE)
+
+
+def stamp_and_upload(original, etag, path_to_new_pdf, file_key, signed_file_key, stamp_data):
+    shutil.copyfile(original, path_to_new_pdf)
+    size = os.path.getsize(path_to_new_pdf)
+    if not append_stamp(path_to_new_pdf, stamp_data):
+        # Файл переписан целиком, общего префикса с исходным нет
+        size = 0
+    upload_appended(file_key, etag, size, path_to_new_pdf, signed_file_key)
+
 
 async def sign_document(request):
+    path_to_new_pdf = '/tmp/' + str(uuid.uuid4()) + '.pdf'
     try:
         data = await request.json()
-        
-        path_to_pdf = '/tmp/' + str(uuid.uuid4()) + '.pdf'
-        file_key = data['file_key']
-        download_file(file_key, path_to_pdf)
 
-        path_to_new_pdf = '/tmp/' + str(uuid.uuid4()) + '.pdf'
+        file_key = data['file_key']
 
         date = datetime.today().strftime('%d.%m.%Y')
         employee_id = data['employee_id']
@@ -28,14 +121,13 @@ async def sign_document(request):
         signed_file_key = data['signed_file_key']
 
         stamp_data = StampData(date, employee_initials, organization, employee_id, signed_file_key[0:-4], sign_type)
-        create_stamp(path_to_pdf, path_to_new_pdf, stamp_data)
-
-        upload_file(path_to_new_pdf, signed_file_key)
-
-        subprocess.run(['rm', path_to_pdf])
-        subprocess.run(['rm', path_to_new_pdf])
+        async with originals.use(file_key) as (original, etag):
+            await asyncio.get_running_loop().run_in_executor(
+                None, stamp_and_upload, original, etag, path_to_new_pdf, file_key, signed_file_key, stamp_data)
 
         return web.Response(status=200, content_type='text/plain', text=signed_file_key)
     except Exception as e:
-        return web.Response(status=500, text=str(e))    
-    
\ No newline at end of file
+        return web.Response(status=500, text=str(e))
+    finally:
+        if os.path.exists(path_to_new_pdf):
+            os.remove(path_to_new_pdf)
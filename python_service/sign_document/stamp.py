@@ -1,3 +1,5 @@
+import os
+
 import fitz
 
 def get_stamp_text(stamp_data):
@@ -29,10 +31,7 @@ def get_stamp_borders(page_width, page_height, stamp_height = 200, stamp_width =
     return(x1, y1, x2, y2)
 
 
-def create_stamp(path_to_pdf, path_to_new_pdf, stamp_data):
-    
-    doc = fitz.open(path_to_pdf)
-    
+def draw_stamp(doc, stamp_data):
     page_number = 0
     page = doc.load_page(page_number)
 
@@ -52,6 +51,12 @@ def create_stamp(path_to_pdf, path_to_new_pdf, stamp_data):
                         fontname="F0", color=stamp_color,
                         align=0)
 
+
+def create_stamp(path_to_pdf, path_to_new_pdf, stamp_data):
+    
+    doc = fitz.open(path_to_pdf)
+    draw_stamp(doc, stamp_data)
+
     # Сохранить изменения в новый файл
     doc.save(path_to_new_pdf)
 
@@ -61,6 +66,27 @@ def create_stamp(path_to_pdf, path_to_new_pdf, stamp_data):
     return("200")
 
 
+def append_stamp(path_to_pdf, stamp_data):
+    # Дописывает штамп в конец файла инкрементальным обновлением,
+    # исходные байты документа не меняются.
+    # Возвращает False, если файл пришлось пересохранить целиком
+    doc = fitz.open(path_to_pdf)
+    draw_stamp(doc, stamp_data)
+    try:
+        doc.saveIncr()
+        return True
+    except Exception:
+        # Зашифрованные и восстановленные при открытии файлы
+        # нельзя дописать, сохраняем полную копию
+        doc.save(path_to_pdf + '.full')
+        doc.close()
+        os.replace(path_to_pdf + '.full', path_to_pdf)
+        return False
+    finally:
+        if not doc.is_closed:
+            doc.close()
+
+
 class StampData:    
     def __init__(self, date, name,
                  organization, user_id, document_id, sign_type = "Простая ЭП"):
@@ -1,8 +1,9 @@
 /// [auth checker declaration]
 #include "auth_bearer.hpp"
-#include "user_info_cache.hpp"
+#include "token_signer.hpp"
+#include "token_store.hpp"
 
-#include <algorithm>
+#include "core/read_routing/component.hpp"
 
 namespace auth {
 
@@ -11,13 +12,14 @@ class AuthCheckerBearer final
  public:
   using AuthCheckResult = userver::server::handlers::auth::AuthCheckResult;
 
-  AuthCheckerBearer(
-      const AuthCache& auth_cache,
-      std::vector<userver::server::auth::UserScope> required_scopes,
-      userver::storages::postgres::ClusterPtr pg_cluster)
-      : auth_cache_(auth_cache),
-        required_scopes_(std::move(required_scopes)),
-        pg_cluster_(pg_cluster) {}
+  AuthCheckerBearer(const TokenStore& token_store,
+                    const TokenSigner& token_signer,
+                    const core::read_routing::ReadRouter& read_router,
+                    ScopeMask required_scopes)
+      : token_store_(token_store),
+        token_signer_(token_signer),
+        read_router_(read_router),
+        required_scopes_(required_scopes) {}
 
   [[nodiscard]] AuthCheckResult CheckAuth(
       const userver::server::http::HttpRequest& request,
@@ -26,9 +28,10 @@ class AuthCheckerBearer final
   [[nodiscard]] bool SupportsUserAuth() const noexcept override { return true; }
 
  private:
-  const AuthCache& auth_cache_;
-  const std::vector<userver::server::auth::UserScope> required_scopes_;
-  userver::storages::postgres::ClusterPtr pg_cluster_;
+  const TokenStore& token_store_;
+  const TokenSigner& token_signer_;
+  const core::read_routing::ReadRouter& read_router_;
+  const ScopeMask required_scopes_;
 };
 /// [auth checker declaration]
 
@@ -59,48 +62,22 @@ AuthCheckerBearer::AuthCheckResult AuthCheckerBearer::CheckAuth(
   /// [auth checker definition 2]
 
   /// [auth checker definition 3]
-  const userver::server::auth::UserAuthInfo::Ticket token{auth_value.data() +
-                                                          bearer_sep_pos + 1};
-  const auto cache_snapshot = auth_cache_.Get();
-
-  auto it = cache_snapshot->find(token);
-  std::optional<UserDbInfo> not_cached_info;
-  if (it == cache_snapshot->end()) {
-    LOG_INFO() << "Trying to search token in database";
-    auto result = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kMaster,
-        static_cast<std::string>(AuthCachePolicy::kQuery) + " WHERE token = $1",
-        token);
-    if (result.IsEmpty()) {
-      LOG_INFO() << "Search of token in database was unsuccessful";
-      return AuthCheckResult{AuthCheckResult::Status::kForbidden};
-    }
-    LOG_INFO() << "Search of token in database was successful";
-    not_cached_info =
-        result.AsSingleRow<UserDbInfo>(userver::storages::postgres::kRowTag);
+  const std::string_view token =
+      std::string_view{auth_value}.substr(bearer_sep_pos + 1);
+  const auto found =
+      IsSignedToken(token)
+          ? token_signer_.Verify(token)
+          : token_store_.Find(userver::server::auth::UserAuthInfo::Ticket{
+                std::string(token)});
+  if (!found.has_value()) {
+    return AuthCheckResult{AuthCheckResult::Status::kForbidden};
   }
   /// [auth checker definition 3]
 
   /// [auth checker definition 4]
-  UserDbInfo info;
-  if (not_cached_info.has_value()) {
-    info = not_cached_info.value();
-  } else {
-    info = it->second;
-  }
-
-  std::set<std::string> user_scopes(info.scopes.begin(), info.scopes.end());
-  std::set<std::string> required_scopes;
-  for (auto& scope : required_scopes_) {
-    required_scopes.insert(scope.GetValue());
-  }
-
-  std::vector<std::string> intersection;
-  std::set_intersection(user_scopes.begin(), user_scopes.end(),
-                        required_scopes.begin(), required_scopes.end(),
-                        std::back_inserter(intersection));
+  const auto& info = found.value();
 
-  if (intersection.empty()) {
+  if ((info.scopes & required_scopes_) == 0) {
     return AuthCheckResult{
         AuthCheckResult::Status::kForbidden, {}, "Not enough permissions"};
   }
@@ -108,19 +85,11 @@ AuthCheckerBearer::AuthCheckResult AuthCheckerBearer::CheckAuth(
 
   /// [auth checker definition 5]
   request_context.SetData("user_id", info.user_id);
-  std::string user_role = "user";
-  if (std::find(info.scopes.begin(), info.scopes.end(), "superuser") !=
-      info.scopes.end()) {
-    user_role = "superuser";
-  } else if (std::find(info.scopes.begin(), info.scopes.end(), "admin") !=
-             info.scopes.end()) {
-    user_role = "admin";
-  } else if (std::find(info.scopes.begin(), info.scopes.end(), "manager") !=
-             info.scopes.end()) {
-    user_role = "manager";
-  }
-  request_context.SetData("user_role", user_role);
+  request_context.SetData("user_role", ToRole(info.scopes));
   request_context.SetData("company_id", info.company_id);
+  request_context.SetData("read_host",
+                          read_router_.ReadHost(request, info.company_id,
+                                                 info.user_id));
   return {};
 }
 /// [auth checker definition 5]
@@ -131,11 +100,15 @@ userver::server::handlers::auth::AuthCheckerBasePtr CheckerFactory::operator()(
     const userver::server::handlers::auth::HandlerAuthConfig& auth_config,
     const userver::server::handlers::auth::AuthCheckerSettings&) const {
   auto scopes = auth_config["scopes"].As<userver::server::auth::UserScopes>({});
-  const auto& auth_cache = context.FindComponent<AuthCache>();
+  const auto& token_store = context.FindComponent<TokenStore>();
+  const auto& token_signer = context.FindComponent<TokenSigner>();
+  const auto& read_router =
+      context.FindComponent<core::read_routing::ReadRouter>();
   return std::make_shared<AuthCheckerBearer>(
-      auth_cache, std::move(scopes),
-      context.FindComponent<userver::components::Postgres>("key-value")
-          .GetCluster());
+      token_store, token_signer, read_router,
+      ToScopeMask(scopes, [](const userver::server::auth::UserScope& scope) {
+        return std::string_view{scope.GetValue()};
+      }));
 }
 /// [auth checker factory definition]
 
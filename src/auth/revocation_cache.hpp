@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+
+#include <userver/cache/base_postgres_cache.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
+
+namespace auth {
+
+// Signed tokens of an employee issued before `revoked_before` are rejected
+struct Revocation {
+  std::string key;
+  userver::storages::postgres::TimePointTz revoked_before;
+};
+
+inline std::string RevocationKey(std::string_view company_id,
+                                 std::string_view user_id) {
+  std::string key;
+  key.reserve(company_id.size() + 1 + user_id.size());
+  key.append(company_id).append("/").append(user_id);
+  return key;
+}
+
+struct RevocationCachePolicy {
+  static constexpr std::string_view kName = "auth-revocation-cache";
+
+  using ValueType = Revocation;
+  static constexpr auto kKeyMember = &Revocation::key;
+  static constexpr const char* kQuery =
+      "SELECT company_id || '/' || user_id, revoked_before "
+      "FROM wd_general.revoked_tokens";
+  static constexpr const char* kUpdatedField = "updated";
+  using UpdatedFieldType = userver::storages::postgres::TimePointTz;
+};
+
+using RevocationCache =
+    userver::components::PostgreCache<RevocationCachePolicy>;
+
+}  // namespace auth
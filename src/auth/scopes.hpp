@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace auth {
+
+// Scopes of a token as bits, a handler accepts the token if it has any of
+// the handler's scopes
+using ScopeMask = std::uint32_t;
+
+inline constexpr ScopeMask kUserScope = 1 << 0;
+inline constexpr ScopeMask kManagerScope = 1 << 1;
+inline constexpr ScopeMask kAdminScope = 1 << 2;
+inline constexpr ScopeMask kSuperuserScope = 1 << 3;
+
+// Stored in the request context as "user_role"
+enum class Role : std::uint8_t { kUser, kManager, kAdmin, kSuperuser };
+
+// Unknown scopes have no bit and never grant access
+constexpr ScopeMask ToScopeBit(std::string_view scope) {
+  if (scope == "user") {
+    return kUserScope;
+  }
+  if (scope == "manager") {
+    return kManagerScope;
+  }
+  if (scope == "admin") {
+    return kAdminScope;
+  }
+  if (scope == "superuser") {
+    return kSuperuserScope;
+  }
+  return 0;
+}
+
+template <class Scopes, class Projection>
+ScopeMask ToScopeMask(const Scopes& scopes, Projection projection) {
+  ScopeMask mask = 0;
+  for (const auto& scope : scopes) {
+    mask |= ToScopeBit(projection(scope));
+  }
+  return mask;
+}
+
+template <class Scopes>
+ScopeMask ToScopeMask(const Scopes& scopes) {
+  return ToScopeMask(scopes, [](std::string_view scope) { return scope; });
+}
+
+// The most privileged role among the scopes
+constexpr Role ToRole(ScopeMask mask) {
+  if (mask & kSuperuserScope) {
+    return Role::kSuperuser;
+  }
+  if (mask & kAdminScope) {
+    return Role::kAdmin;
+  }
+  if (mask & kManagerScope) {
+    return Role::kManager;
+  }
+  return Role::kUser;
+}
+
+}  // namespace auth
@@ -0,0 +1,24 @@
+#include "scopes.hpp"
+
+#include <string>
+#include <vector>
+
+#include <userver/utest/utest.hpp>
+
+UTEST(Scopes, Mask) {
+  const std::vector<std::string> scopes = {"user", "admin", "unknown"};
+  EXPECT_EQ(auth::ToScopeMask(scopes), auth::kUserScope | auth::kAdminScope);
+  EXPECT_EQ(auth::ToScopeMask(std::vector<std::string>{}), 0);
+  EXPECT_EQ(auth::ToScopeBit("unknown"), 0);
+}
+
+UTEST(Scopes, Role) {
+  EXPECT_EQ(auth::ToRole(0), auth::Role::kUser);
+  EXPECT_EQ(auth::ToRole(auth::kUserScope), auth::Role::kUser);
+  EXPECT_EQ(auth::ToRole(auth::kUserScope | auth::kManagerScope),
+            auth::Role::kManager);
+  EXPECT_EQ(auth::ToRole(auth::kManagerScope | auth::kAdminScope),
+            auth::Role::kAdmin);
+  EXPECT_EQ(auth::ToRole(auth::kAdminScope | auth::kSuperuserScope),
+            auth::Role::kSuperuser);
+}
@@ -0,0 +1,128 @@
+#include "signed_token.hpp"
+
+#include <stdexcept>
+
+#include <userver/crypto/algorithm.hpp>
+#include <userver/crypto/base64.hpp>
+#include <userver/crypto/hash.hpp>
+
+#include "core/json_compatible/struct.hpp"
+
+namespace auth {
+
+namespace {
+
+struct TokenPayload : public JsonCompatible<TokenPayload> {
+  REGISTER_STRUCT_FIELD(user_id, std::string, "sub");
+  REGISTER_STRUCT_FIELD(company_id, std::string, "cid");
+  REGISTER_STRUCT_FIELD(scopes, ScopeMask, "scp");
+  REGISTER_STRUCT_FIELD(issued, int64_t, "iat");
+  REGISTER_STRUCT_FIELD(expires, int64_t, "exp");
+
+  JSON_FIELDS(user_id, company_id, scopes, issued, expires);
+};
+
+int64_t ToSeconds(std::chrono::system_clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+             time.time_since_epoch())
+      .count();
+}
+
+std::chrono::system_clock::time_point FromSeconds(int64_t seconds) {
+  return std::chrono::system_clock::time_point{std::chrono::seconds{seconds}};
+}
+
+std::string Signature(std::string_view signed_part, std::string_view key) {
+  return userver::crypto::base64::Base64UrlEncode(
+      userver::crypto::hash::HmacSha256(
+          key, signed_part, userver::crypto::hash::OutputEncoding::kBinary),
+      userver::crypto::base64::Pad::kWithout);
+}
+
+}  // namespace
+
+TokenKeys::TokenKeys(const userver::formats::json::Value& secdist_doc) {
+  const auto& section = secdist_doc["auth_token_keys"];
+  if (section.IsMissing()) {
+    return;
+  }
+  current = section["current"].As<std::string>();
+  keys = section["keys"].As<std::unordered_map<std::string, std::string>>();
+  for (const auto& [key_id, key] : keys) {
+    if (key_id.empty() || key_id.find('.') != std::string::npos) {
+      throw std::runtime_error("Bad auth token key id '" + key_id + "'");
+    }
+  }
+  if (!keys.count(current)) {
+    throw std::runtime_error("No auth token key '" + current + "'");
+  }
+}
+
+bool IsSignedToken(std::string_view token) {
+  return token.substr(0, kSignedTokenPrefix.size()) == kSignedTokenPrefix;
+}
+
+std::string SignToken(const SignedTokenClaims& claims, std::string_view key_id,
+                      std::string_view key) {
+  TokenPayload payload;
+  payload.user_id = claims.user_id;
+  payload.company_id = claims.company_id;
+  payload.scopes = claims.scopes;
+  payload.issued = ToSeconds(claims.issued);
+  payload.expires = ToSeconds(claims.expires);
+
+  auto token = std::string(kSignedTokenPrefix);
+  token.append(key_id).append(".").append(
+      userver::crypto::base64::Base64UrlEncode(
+          payload.ToJsonString(), userver::crypto::base64::Pad::kWithout));
+  const auto signature = Signature(token, key);
+  token.append(".").append(signature);
+  return token;
+}
+
+std::optional<SignedTokenClaims> VerifyToken(
+    std::string_view token,
+    const std::unordered_map<std::string, std::string>& keys,
+    std::chrono::system_clock::time_point now) {
+  if (!IsSignedToken(token)) {
+    return std::nullopt;
+  }
+
+  const auto key_end = token.find('.', kSignedTokenPrefix.size());
+  const auto signature_begin = token.rfind('.');
+  if (key_end == std::string_view::npos || key_end == signature_begin) {
+    return std::nullopt;
+  }
+  const auto key_id = token.substr(kSignedTokenPrefix.size(),
+                                   key_end - kSignedTokenPrefix.size());
+  auto key = keys.find(std::string(key_id));
+  if (key == keys.end()) {
+    return std::nullopt;
+  }
+
+  const auto signed_part = token.substr(0, signature_begin);
+  if (!userver::crypto::algorithm::AreStringsEqualConstTime(
+          Signature(signed_part, key->second),
+          token.substr(signature_begin + 1))) {
+    return std::nullopt;
+  }
+
+  TokenPayload payload;
+  try {
+    payload.ParseRegisteredFields(userver::crypto::base64::Base64UrlDecode(
+        signed_part.substr(key_end + 1)));
+  } catch (const std::exception&) {
+    return std::nullopt;
+  }
+
+  SignedTokenClaims claims{std::move(payload.user_id),
+                           std::move(payload.company_id), payload.scopes,
+                           FromSeconds(payload.issued),
+                           FromSeconds(payload.expires)};
+  if (claims.expires <= now) {
+    return std::nullopt;
+  }
+  return claims;
+}
+
+}  // namespace auth
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <userver/formats/json/value.hpp>
+
+#include "scopes.hpp"
+
+namespace auth {
+
+// Self-contained access token:
+//   wd1.<key id>.<base64url payload>.<base64url HMAC-SHA256 of the rest>
+// It is checked without any lookup, opaque tokens never start with "wd1."
+inline constexpr std::string_view kSignedTokenPrefix = "wd1.";
+
+struct SignedTokenClaims {
+  std::string user_id;
+  std::string company_id;
+  ScopeMask scopes = 0;
+  std::chrono::system_clock::time_point issued;
+  std::chrono::system_clock::time_point expires;
+};
+
+// "auth_token_keys" secdist section:
+//   {"current": "<key id>", "keys": {"<key id>": "<secret>", ...}}
+// New tokens are signed with the current key, tokens signed with any of the
+// keys are accepted. A key is rotated by adding a new one, making it current
+// and dropping the old one once its tokens have expired. Without the section
+// only opaque tokens are issued.
+struct TokenKeys {
+  explicit TokenKeys(const userver::formats::json::Value& secdist_doc);
+
+  std::string current;
+  std::unordered_map<std::string, std::string> keys;
+};
+
+bool IsSignedToken(std::string_view token);
+
+std::string SignToken(const SignedTokenClaims& claims, std::string_view key_id,
+                      std::string_view key);
+
+// Claims of a well-formed token with a valid signature that has not expired
+std::optional<SignedTokenClaims> VerifyToken(
+    std::string_view token,
+    const std::unordered_map<std::string, std::string>& keys,
+    std::chrono::system_clock::time_point now);
+
+}  // namespace auth
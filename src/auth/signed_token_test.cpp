@@ -0,0 +1,61 @@
+#include "signed_token.hpp"
+
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+using std::chrono::hours;
+
+const std::chrono::system_clock::time_point kIssued{
+    std::chrono::seconds{1689897600}};
+
+const std::unordered_map<std::string, std::string> kKeys = {
+    {"old", "old secret"}, {"new", "new secret"}};
+
+auth::SignedTokenClaims Claims() {
+  return {"first_id", "first", auth::kUserScope | auth::kAdminScope, kIssued,
+          kIssued + hours{24}};
+}
+
+}  // namespace
+
+UTEST(SignedToken, RoundTrip) {
+  const auto token = auth::SignToken(Claims(), "new", "new secret");
+  EXPECT_TRUE(auth::IsSignedToken(token));
+  EXPECT_EQ(token.rfind("wd1.new.", 0), 0);
+
+  const auto claims = auth::VerifyToken(token, kKeys, kIssued + hours{1});
+  ASSERT_TRUE(claims.has_value());
+  EXPECT_EQ(claims->user_id, "first_id");
+  EXPECT_EQ(claims->company_id, "first");
+  EXPECT_EQ(claims->scopes, auth::kUserScope | auth::kAdminScope);
+  EXPECT_EQ(claims->issued, kIssued);
+  EXPECT_EQ(claims->expires, kIssued + hours{24});
+
+  // Tokens of a previous key are accepted while the key is listed
+  EXPECT_TRUE(auth::VerifyToken(auth::SignToken(Claims(), "old", "old secret"),
+                                kKeys, kIssued)
+                  .has_value());
+}
+
+UTEST(SignedToken, Rejected) {
+  const auto token = auth::SignToken(Claims(), "new", "new secret");
+
+  EXPECT_FALSE(auth::VerifyToken(token, kKeys, kIssued + hours{24}));
+  EXPECT_FALSE(auth::VerifyToken(token, {{"old", "old secret"}}, kIssued));
+  EXPECT_FALSE(auth::VerifyToken(auth::SignToken(Claims(), "new", "guess"),
+                                 kKeys, kIssued));
+  EXPECT_FALSE(auth::VerifyToken(token + "x", kKeys, kIssued));
+  EXPECT_FALSE(auth::VerifyToken("wd1.new", kKeys, kIssued));
+  EXPECT_FALSE(auth::VerifyToken("wd1.new.", kKeys, kIssued));
+  EXPECT_FALSE(auth::VerifyToken("first_token", kKeys, kIssued));
+  EXPECT_FALSE(auth::IsSignedToken("first_token"));
+
+  // Payload swapped between two validly signed tokens
+  auto other_claims = Claims();
+  other_claims.scopes |= auth::kSuperuserScope;
+  const auto other = auth::SignToken(other_claims, "new", "new secret");
+  const auto forged = other.substr(0, other.rfind('.')) +
+                      token.substr(token.rfind('.'));
+  EXPECT_FALSE(auth::VerifyToken(forged, kKeys, kIssued));
+}
@@ -0,0 +1,65 @@
+#include "token_signer.hpp"
+
+#include <userver/utils/datetime.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+namespace auth {
+
+TokenSigner::TokenSigner(const userver::components::ComponentConfig& config,
+                         const userver::components::ComponentContext& context)
+    : LoggableComponentBase(config, context),
+      secdist_(context.FindComponent<userver::components::Secdist>()),
+      revocation_cache_(context.FindComponent<RevocationCache>()),
+      token_ttl_(config["token-ttl"].As<std::chrono::seconds>()) {}
+
+std::optional<std::string> TokenSigner::Issue(const UserDbInfo& info) const {
+  const auto secdist = secdist_.GetSnapshot();
+  const auto& keys = secdist->Get<TokenKeys>();
+  if (keys.current.empty()) {
+    return std::nullopt;
+  }
+
+  const auto now = userver::utils::datetime::Now();
+  return SignToken({info.user_id, info.company_id, info.scopes, now,
+                    now + token_ttl_},
+                   keys.current, keys.keys.at(keys.current));
+}
+
+std::optional<UserDbInfo> TokenSigner::Verify(std::string_view token) const {
+  auto claims = [&] {
+    const auto secdist = secdist_.GetSnapshot();
+    return VerifyToken(token, secdist->Get<TokenKeys>().keys,
+                       userver::utils::datetime::Now());
+  }();
+  if (!claims.has_value()) {
+    return std::nullopt;
+  }
+
+  const auto revocations = revocation_cache_.Get();
+  auto it =
+      revocations->find(RevocationKey(claims->company_id, claims->user_id));
+  if (it != revocations->end() &&
+      claims->issued < it->second.revoked_before.GetUnderlying()) {
+    return std::nullopt;
+  }
+
+  return UserDbInfo{
+      userver::server::auth::UserAuthInfo::Ticket{std::string(token)},
+      std::move(claims->user_id), claims->scopes,
+      std::move(claims->company_id)};
+}
+
+userver::yaml_config::Schema TokenSigner::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::LoggableComponentBase>(R"(
+type: object
+description: Signed access tokens, keys are in the auth_token_keys secdist
+additionalProperties: false
+properties:
+    token-ttl:
+        type: string
+        description: lifetime of an issued token
+)");
+}
+
+}  // namespace auth
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/storages/secdist/component.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+#include "revocation_cache.hpp"
+#include "signed_token.hpp"
+#include "user_info_cache.hpp"
+
+namespace auth {
+
+// Issues and checks signed tokens with the keys from secdist, which are read
+// on every call so that rotated keys are picked up without a restart
+class TokenSigner final : public userver::components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName = "auth-token-signer";
+
+  TokenSigner(const userver::components::ComponentConfig& config,
+              const userver::components::ComponentContext& context);
+
+  // std::nullopt if there is no signing key
+  std::optional<std::string> Issue(const UserDbInfo& info) const;
+
+  // Token owner if the token is valid and has not been revoked
+  std::optional<UserDbInfo> Verify(std::string_view token) const;
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  const userver::components::Secdist& secdist_;
+  const RevocationCache& revocation_cache_;
+  const std::chrono::seconds token_ttl_;
+};
+
+}  // namespace auth
@@ -0,0 +1,117 @@
+#include "token_store.hpp"
+
+#include <mutex>
+
+#include <userver/logging/log.hpp>
+#include <userver/storages/postgres/component.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/scope_guard.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+namespace auth {
+
+TokenStore::TokenStore(const userver::components::ComponentConfig& config,
+                       const userver::components::ComponentContext& context)
+    : LoggableComponentBase(config, context),
+      auth_cache_(context.FindComponent<AuthCache>()),
+      pg_cluster_(
+          context.FindComponent<userver::components::Postgres>("key-value")
+              .GetCluster()),
+      unknown_token_ttl_(
+          config["unknown-token-ttl"].As<std::chrono::milliseconds>()),
+      issued_(config["issued-tokens-max-size"].As<size_t>()),
+      unknown_(config["unknown-tokens-max-size"].As<size_t>()) {}
+
+void TokenStore::Add(UserDbInfo info) {
+  std::lock_guard lock(mutex_);
+  unknown_.Erase(info.token);
+  auto token = info.token;
+  issued_.Put(token, std::move(info));
+}
+
+std::optional<UserDbInfo> TokenStore::Find(const Ticket& token) const {
+  {
+    const auto snapshot = auth_cache_.Get();
+    auto it = snapshot->find(token);
+    if (it != snapshot->end()) {
+      return it->second;
+    }
+  }
+
+  Lookup lookup;
+  bool is_owner = false;
+  {
+    std::lock_guard lock(mutex_);
+    if (const auto* info = issued_.Get(token)) {
+      return *info;
+    }
+    if (const auto* expires = unknown_.Get(token)) {
+      if (*expires > std::chrono::steady_clock::now()) {
+        return std::nullopt;
+      }
+      unknown_.Erase(token);
+    }
+
+    // Concurrent misses of one token wait for a single query
+    auto [it, inserted] = lookups_.try_emplace(token);
+    if (inserted) {
+      it->second =
+          userver::utils::SharedAsync("auth_token_lookup", [this, token] {
+            return FetchFromMaster(token);
+          });
+      is_owner = true;
+    }
+    lookup = it->second;
+  }
+
+  userver::utils::ScopeGuard erase_lookup([this, &token, is_owner] {
+    if (is_owner) {
+      std::lock_guard lock(mutex_);
+      lookups_.erase(token);
+    }
+  });
+  return lookup.Get();
+}
+
+std::optional<UserDbInfo> TokenStore::FetchFromMaster(
+    const Ticket& token) const {
+  LOG_INFO() << "Trying to search token in database";
+  auto result = pg_cluster_->Execute(
+      userver::storages::postgres::ClusterHostType::kMaster,
+      static_cast<std::string>(AuthCachePolicy::kQuery) + " WHERE token = $1",
+      token);
+
+  std::lock_guard lock(mutex_);
+  if (result.IsEmpty()) {
+    LOG_INFO() << "Search of token in database was unsuccessful";
+    unknown_.Put(token, std::chrono::steady_clock::now() + unknown_token_ttl_);
+    return std::nullopt;
+  }
+  LOG_INFO() << "Search of token in database was successful";
+  auto info = Convert(
+      result.AsSingleRow<UserDbRow>(userver::storages::postgres::kRowTag),
+      userver::formats::parse::To<UserDbInfo>{});
+  issued_.Put(token, info);
+  return info;
+}
+
+userver::yaml_config::Schema TokenStore::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::LoggableComponentBase>(R"(
+type: object
+description: Bearer tokens issued after the last auth-pg-cache update
+additionalProperties: false
+properties:
+    issued-tokens-max-size:
+        type: integer
+        description: how many recently issued tokens to keep
+    unknown-tokens-max-size:
+        type: integer
+        description: how many unknown tokens to remember
+    unknown-token-ttl:
+        type: string
+        description: how long an unknown token is rejected without a query
+)");
+}
+
+}  // namespace auth
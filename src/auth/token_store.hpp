@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <unordered_map>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/shared_task_with_result.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+#include "user_info_cache.hpp"
+
+namespace auth {
+
+// Resolves bearer tokens on top of the auth-pg-cache snapshot, which only
+// sees tokens issued before its last update. Tokens issued since then are
+// written through by the authorize handler, tokens missing everywhere are
+// looked up in the master once per token and remembered as unknown for a
+// while.
+class TokenStore final : public userver::components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName = "auth-token-store";
+
+  using Ticket = userver::server::auth::UserAuthInfo::Ticket;
+
+  TokenStore(const userver::components::ComponentConfig& config,
+             const userver::components::ComponentContext& context);
+
+  void Add(UserDbInfo info);
+
+  std::optional<UserDbInfo> Find(const Ticket& token) const;
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  using Lookup =
+      userver::engine::SharedTaskWithResult<std::optional<UserDbInfo>>;
+
+  template <class Value>
+  using TicketMap =
+      userver::cache::LruMap<Ticket, Value, std::hash<Ticket>,
+                             userver::crypto::algorithm::
+                                 StringsEqualConstTimeComparator>;
+
+  std::optional<UserDbInfo> FetchFromMaster(const Ticket& token) const;
+
+  const AuthCache& auth_cache_;
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+  const std::chrono::milliseconds unknown_token_ttl_;
+
+  mutable userver::engine::Mutex mutex_;
+  mutable TicketMap<UserDbInfo> issued_;
+  mutable TicketMap<std::chrono::steady_clock::time_point> unknown_;
+  mutable std::unordered_map<
+      Ticket, Lookup, std::hash<Ticket>,
+      userver::crypto::algorithm::StringsEqualConstTimeComparator>
+      lookups_;
+};
+
+}  // namespace auth
@@ -5,22 +5,39 @@
 
 #include <userver/cache/base_postgres_cache.hpp>
 #include <userver/crypto/algorithm.hpp>
+#include <userver/formats/parse/to.hpp>
 #include <userver/server/auth/user_auth_info.hpp>
 #include <userver/storages/postgres/io/array_types.hpp>
 
+#include "scopes.hpp"
+
 namespace auth {
 
-struct UserDbInfo {
+struct UserDbRow {
   userver::server::auth::UserAuthInfo::Ticket token;
   std::string user_id;
   std::vector<std::string> scopes;
   std::string company_id;
 };
 
+struct UserDbInfo {
+  userver::server::auth::UserAuthInfo::Ticket token;
+  std::string user_id;
+  ScopeMask scopes = 0;
+  std::string company_id;
+};
+
+inline UserDbInfo Convert(UserDbRow&& row,
+                          userver::formats::parse::To<UserDbInfo>) {
+  return {std::move(row.token), std::move(row.user_id),
+          ToScopeMask(row.scopes), std::move(row.company_id)};
+}
+
 struct AuthCachePolicy {
   static constexpr std::string_view kName = "auth-pg-cache";
 
   using ValueType = UserDbInfo;
+  using RawValueType = UserDbRow;
   static constexpr auto kKeyMember = &UserDbInfo::token;
   static constexpr const char* kQuery =
       "SELECT token, user_id, scopes, company_id FROM wd_general.auth_tokens";
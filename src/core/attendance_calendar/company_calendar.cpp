@@ -0,0 +1,207 @@
+#include "company_calendar.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+
+namespace core::attendance_calendar {
+
+namespace {
+
+using Days = std::chrono::duration<int64_t, std::ratio<86400>>;
+
+constexpr auto kDay = std::chrono::hours{24};
+constexpr auto kLastMinute = std::chrono::minutes{1439};
+
+struct DayRange {
+  int64_t first;
+  int64_t last;
+};
+
+int64_t DayOf(TimePoint time) {
+  return std::chrono::floor<Days>(time.time_since_epoch()).count();
+}
+
+// Number of whole or partial days from start to end, an absence covers the
+// days of start, start + 24h, ... while they are before its end
+int64_t DaysCount(TimePoint start, TimePoint end) {
+  if (end <= start) {
+    return 0;
+  }
+  return std::chrono::ceil<Days>(end - start).count();
+}
+
+bool LessByStart(const CalendarAction& lhs, const CalendarAction& rhs) {
+  return lhs.start_date < rhs.start_date;
+}
+
+// Actions with start in from..to
+std::pair<std::vector<CalendarAction>::const_iterator,
+          std::vector<CalendarAction>::const_iterator>
+StartingWithin(const std::vector<CalendarAction>& actions, TimePoint from,
+               TimePoint to) {
+  const auto begin = std::lower_bound(
+      actions.begin(), actions.end(), from,
+      [](const CalendarAction& action, TimePoint time) {
+        return action.start_date < time;
+      });
+  const auto end =
+      std::upper_bound(begin, actions.end(), to,
+                       [](TimePoint time, const CalendarAction& action) {
+                         return time < action.start_date;
+                       });
+  return {begin, end};
+}
+
+}  // namespace
+
+void CompanyCalendar::UpsertEmployee(EmployeeRecord record) {
+  Employee employee{std::move(record.employee), std::move(record.teams)};
+  for (auto& action : record.actions) {
+    if (action.type == "attendance") {
+      employee.attendances.push_back(std::move(action));
+    } else if (action.type == "overtime") {
+      employee.overtimes.push_back(std::move(action));
+    } else {
+      employee.absences.push_back(std::move(action));
+    }
+  }
+  std::sort(employee.attendances.begin(), employee.attendances.end(),
+            LessByStart);
+  std::sort(employee.absences.begin(), employee.absences.end(), LessByStart);
+  std::sort(employee.overtimes.begin(), employee.overtimes.end(), LessByStart);
+
+  std::lock_guard lock(mutex_);
+  auto it = employees_.find(employee.card.id);
+  if (it != employees_.end()) {
+    UnlinkTeams(it->second);
+  }
+  for (const auto& team_id : employee.teams) {
+    team_members_[team_id].insert(employee.card.id);
+  }
+  const auto employee_id = employee.card.id;
+  employees_.insert_or_assign(employee_id, std::move(employee));
+}
+
+void CompanyCalendar::RemoveEmployee(const std::string& employee_id) {
+  std::lock_guard lock(mutex_);
+  auto it = employees_.find(employee_id);
+  if (it == employees_.end()) {
+    return;
+  }
+  UnlinkTeams(it->second);
+  employees_.erase(it);
+}
+
+std::vector<std::string> CompanyCalendar::GetTeams(
+    const std::string& employee_id) const {
+  std::shared_lock lock(mutex_);
+  auto it = employees_.find(employee_id);
+  if (it == employees_.end()) {
+    return {};
+  }
+  return it->second.teams;
+}
+
+void CompanyCalendar::ForEachEntry(
+    const std::vector<std::string>& team_ids, TimePoint from, TimePoint to,
+    const std::function<void(const CalendarEntry&)>& on_entry) const {
+  std::shared_lock lock(mutex_);
+
+  // Employees of several requested teams are listed once
+  std::set<std::string_view> employee_ids;
+  for (const auto& team_id : team_ids) {
+    auto it = team_members_.find(team_id);
+    if (it != team_members_.end()) {
+      employee_ids.insert(it->second.begin(), it->second.end());
+    }
+  }
+
+  for (const auto employee_id : employee_ids) {
+    VisitEmployee(employees_.at(std::string(employee_id)), from, to, on_entry);
+  }
+}
+
+size_t CompanyCalendar::EmployeesCount() const {
+  std::shared_lock lock(mutex_);
+  return employees_.size();
+}
+
+void CompanyCalendar::UnlinkTeams(const Employee& employee) {
+  for (const auto& team_id : employee.teams) {
+    auto it = team_members_.find(team_id);
+    if (it == team_members_.end()) {
+      continue;
+    }
+    it->second.erase(employee.card.id);
+    if (it->second.empty()) {
+      team_members_.erase(it);
+    }
+  }
+}
+
+void CompanyCalendar::VisitEmployee(
+    const Employee& employee, TimePoint from, TimePoint to,
+    const std::function<void(const CalendarEntry&)>& on_entry) const {
+  // Absences overlapping from..to, sorted by start so the first one starting
+  // after `to` ends the scan
+  std::vector<const CalendarAction*> absences;
+  std::vector<DayRange> absent_days;
+  for (const auto& absence : employee.absences) {
+    if (absence.start_date > to) {
+      break;
+    }
+    if (absence.end_date < from) {
+      continue;
+    }
+    absences.push_back(&absence);
+    const auto days = DaysCount(absence.start_date, absence.end_date);
+    if (days > 0) {
+      const auto first = DayOf(absence.start_date);
+      absent_days.push_back({first, first + days - 1});
+    }
+  }
+
+  const auto is_absent = [&absent_days](TimePoint time) {
+    const auto day = DayOf(time);
+    return std::any_of(
+        absent_days.begin(), absent_days.end(),
+        [day](const DayRange& range) {
+          return range.first <= day && day <= range.last;
+        });
+  };
+
+  const auto [attendances_begin, attendances_end] =
+      StartingWithin(employee.attendances, from, to);
+  if (attendances_begin == attendances_end) {
+    on_entry({employee.card, std::nullopt, std::nullopt, std::nullopt});
+  }
+  for (auto it = attendances_begin; it != attendances_end; ++it) {
+    if (!is_absent(it->start_date)) {
+      on_entry({employee.card, it->start_date, it->end_date, std::nullopt});
+    }
+  }
+
+  for (const auto* absence : absences) {
+    const auto days = DaysCount(absence->start_date, absence->end_date);
+    const int64_t first =
+        absence->start_date < from
+            ? std::chrono::ceil<Days>(from - absence->start_date).count()
+            : 0;
+    for (int64_t i = first; i < days; ++i) {
+      const auto day = absence->start_date + i * kDay;
+      if (day > to) {
+        break;
+      }
+      on_entry({employee.card, day, day + kLastMinute, absence->type});
+    }
+  }
+
+  const auto [overtimes_begin, overtimes_end] =
+      StartingWithin(employee.overtimes, from, to);
+  for (auto it = overtimes_begin; it != overtimes_end; ++it) {
+    on_entry({employee.card, it->start_date, it->end_date, it->type});
+  }
+}
+
+}  // namespace core::attendance_calendar
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/engine/shared_mutex.hpp>
+
+namespace core::attendance_calendar {
+
+using TimePoint = std::chrono::system_clock::time_point;
+
+struct CalendarEmployee {
+  std::string id;
+  std::string name;
+  std::string surname;
+  std::optional<std::string> patronymic;
+  std::string subcompany;
+};
+
+// Attendances regardless of status, approved absences and overtimes
+struct CalendarAction {
+  std::string type;
+  TimePoint start_date;
+  TimePoint end_date;
+};
+
+struct EmployeeRecord {
+  CalendarEmployee employee;
+  std::vector<std::string> teams;
+  std::vector<CalendarAction> actions;
+};
+
+// One item of the attendance list, absences are split into days
+struct CalendarEntry {
+  const CalendarEmployee& employee;
+  std::optional<TimePoint> start_date;
+  std::optional<TimePoint> end_date;
+  std::optional<std::string> abscence_type;
+};
+
+// Attendance calendar of one company. Actions of every employee are kept
+// sorted by start, so a from..to query walks every employee of the requested
+// teams once without touching the database.
+class CompanyCalendar {
+ public:
+  void UpsertEmployee(EmployeeRecord record);
+
+  void RemoveEmployee(const std::string& employee_id);
+
+  std::vector<std::string> GetTeams(const std::string& employee_id) const;
+
+  // Calls on_entry for every employee of the teams in employee id order:
+  // attendances starting in from..to unless the employee is absent that day
+  // (or a single entry without dates if there are none), days of absences
+  // within from..to and overtimes starting in from..to
+  void ForEachEntry(
+      const std::vector<std::string>& team_ids, TimePoint from, TimePoint to,
+      const std::function<void(const CalendarEntry&)>& on_entry) const;
+
+  size_t EmployeesCount() const;
+
+ private:
+  struct Employee {
+    CalendarEmployee card;
+    std::vector<std::string> teams;
+    std::vector<CalendarAction> attendances;
+    std::vector<CalendarAction> absences;
+    std::vector<CalendarAction> overtimes;
+  };
+
+  void UnlinkTeams(const Employee& employee);
+
+  void VisitEmployee(
+      const Employee& employee, TimePoint from, TimePoint to,
+      const std::function<void(const CalendarEntry&)>& on_entry) const;
+
+  mutable userver::engine::SharedMutex mutex_;
+
+  std::unordered_map<std::string, Employee> employees_;
+  std::unordered_map<std::string, std::set<std::string>> team_members_;
+};
+
+}  // namespace core::attendance_calendar
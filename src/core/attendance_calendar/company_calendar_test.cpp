@@ -0,0 +1,102 @@
+#include "company_calendar.hpp"
+
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+using core::attendance_calendar::CalendarEntry;
+using core::attendance_calendar::CompanyCalendar;
+using core::attendance_calendar::TimePoint;
+
+// Hours since 2023-07-21T00:00:00Z
+TimePoint At(int hours) {
+  return TimePoint{std::chrono::seconds{1689897600}} +
+         std::chrono::hours{hours};
+}
+
+struct Entry {
+  std::string employee_id;
+  std::optional<TimePoint> start_date;
+  std::optional<TimePoint> end_date;
+  std::optional<std::string> type;
+
+  bool operator==(const Entry&) const = default;
+};
+
+std::vector<Entry> Entries(const CompanyCalendar& calendar,
+                           const std::vector<std::string>& teams,
+                           TimePoint from, TimePoint to) {
+  std::vector<Entry> entries;
+  calendar.ForEachEntry(teams, from, to, [&](const CalendarEntry& entry) {
+    entries.push_back({entry.employee.id, entry.start_date, entry.end_date,
+                       entry.abscence_type});
+  });
+  return entries;
+}
+
+}  // namespace
+
+UTEST(AttendanceCalendar, Attendances) {
+  CompanyCalendar calendar;
+  calendar.UpsertEmployee({{"a", "A", "A"},
+                           {"t1", "t2"},
+                           {{"attendance", At(34), At(42)},
+                            {"attendance", At(10), At(18)},
+                            {"attendance", At(100), At(108)}}});
+  calendar.UpsertEmployee({{"b", "B", "B"}, {"t2"}, {}});
+  calendar.UpsertEmployee({{"c", "C", "C"}, {"t3"}, {}});
+
+  EXPECT_EQ(Entries(calendar, {"t1", "t2"}, At(0), At(48)),
+            (std::vector<Entry>{{"a", At(10), At(18)},
+                                {"a", At(34), At(42)},
+                                {"b"}}));
+  EXPECT_EQ(Entries(calendar, {"t1"}, At(48), At(72)),
+            (std::vector<Entry>{{"a"}}));
+  EXPECT_EQ(calendar.GetTeams("a"), (std::vector<std::string>{"t1", "t2"}));
+  EXPECT_TRUE(Entries(calendar, {"t4"}, At(0), At(48)).empty());
+}
+
+UTEST(AttendanceCalendar, Absences) {
+  using std::chrono::minutes;
+
+  CompanyCalendar calendar;
+  calendar.UpsertEmployee(
+      {{"a", "A", "A"},
+       {"t"},
+       {{"attendance", At(10), At(18)},
+        {"attendance", At(34), At(42)},
+        {"sick_leave", At(24), At(48) + minutes{1439}},
+        {"overtime", At(20), At(22)}}});
+  calendar.UpsertEmployee(
+      {{"b", "B", "B"},
+       {"t"},
+       {{"unpaid_vacation", At(-480), At(216) + minutes{1439}}}});
+
+  EXPECT_EQ(
+      Entries(calendar, {"t"}, At(0), At(48)),
+      (std::vector<Entry>{
+          {"a", At(10), At(18)},
+          {"a", At(24), At(24) + minutes{1439}, "sick_leave"},
+          {"a", At(48), At(48) + minutes{1439}, "sick_leave"},
+          {"a", At(20), At(22), "overtime"},
+          {"b"},
+          {"b", At(0), At(0) + minutes{1439}, "unpaid_vacation"},
+          {"b", At(24), At(24) + minutes{1439}, "unpaid_vacation"},
+          {"b", At(48), At(48) + minutes{1439}, "unpaid_vacation"}}));
+}
+
+UTEST(AttendanceCalendar, Updates) {
+  CompanyCalendar calendar;
+  calendar.UpsertEmployee(
+      {{"a", "A", "A"}, {"t1"}, {{"attendance", At(10), At(18)}}});
+  calendar.UpsertEmployee({{"a", "A", "A"}, {"t2"}, {}});
+
+  EXPECT_TRUE(Entries(calendar, {"t1"}, At(0), At(24)).empty());
+  EXPECT_EQ(Entries(calendar, {"t2"}, At(0), At(24)),
+            (std::vector<Entry>{{"a"}}));
+  EXPECT_EQ(calendar.EmployeesCount(), 1);
+
+  calendar.RemoveEmployee("a");
+  EXPECT_TRUE(Entries(calendar, {"t2"}, At(0), At(24)).empty());
+  EXPECT_EQ(calendar.EmployeesCount(), 0);
+}
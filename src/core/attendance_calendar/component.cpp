@@ -0,0 +1,333 @@
+#define USERVER_POSTGRES_ENABLE_LEGACY_TIMESTAMP 1
+
+#include "component.hpp"
+
+#include <mutex>
+
+#include <userver/logging/log.hpp>
+#include <userver/storages/postgres/component.hpp>
+#include <userver/storages/postgres/io/array_types.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include "core/tenant_query/query.hpp"
+
+namespace core::attendance_calendar {
+
+namespace {
+
+struct TeamRow {
+  std::string employee_id;
+  std::string team_id;
+};
+
+struct ActionRow {
+  std::string employee_id;
+  std::string type;
+  TimePoint start_date;
+  TimePoint end_date;
+};
+
+const core::tenant_query::TenantQuery kSelectEmployee{
+    "attendance_calendar_select_employee",
+    "SELECT id, name, surname, patronymic, subcompany "
+    "FROM {schema}.employees "
+    "WHERE id = $1"};
+
+const core::tenant_query::TenantQuery kSelectEmployeeTeams{
+    "attendance_calendar_select_employee_teams",
+    "SELECT team_id "
+    "FROM {schema}.employee_team "
+    "WHERE employee_id = $1"};
+
+// Pending and denied absences never show up in the calendar
+const core::tenant_query::TenantQuery kSelectEmployeeActions{
+    "attendance_calendar_select_employee_actions",
+    "SELECT type, start_date, end_date "
+    "FROM {schema}.actions "
+    "WHERE user_id = $1 AND (type = 'attendance' OR status = 'approved')"};
+
+const core::tenant_query::TenantQuery kSelectEmployees{
+    "attendance_calendar_select_employees",
+    "SELECT id, name, surname, patronymic, subcompany "
+    "FROM {schema}.employees"};
+
+const core::tenant_query::TenantQuery kSelectTeams{
+    "attendance_calendar_select_teams",
+    "SELECT employee_id, team_id "
+    "FROM {schema}.employee_team"};
+
+const core::tenant_query::TenantQuery kSelectActions{
+    "attendance_calendar_select_actions",
+    "SELECT user_id, type, start_date, end_date "
+    "FROM {schema}.actions "
+    "WHERE type = 'attendance' OR status = 'approved'"};
+
+// Actions and team memberships carry their own `updated`, an employee any
+// of them changed for is reloaded as a whole. Deleted rows leave nothing
+// behind: actions shown in the calendar are only deleted together with an
+// insert for the same employee, removed employees go through the
+// write-through and the full updates
+const core::tenant_query::TenantQuery kSelectChangedEmployees{
+    "attendance_calendar_select_changed_employees",
+    "SELECT id FROM {schema}.employees WHERE updated > $1 "
+    "UNION "
+    "SELECT employee_id FROM {schema}.employee_team WHERE updated > $1 "
+    "UNION "
+    "SELECT user_id FROM {schema}.actions WHERE updated > $1"};
+
+const core::tenant_query::TenantQuery kSelectEmployeesById{
+    "attendance_calendar_select_employees_by_id",
+    "SELECT id, name, surname, patronymic, subcompany "
+    "FROM {schema}.employees "
+    "WHERE id = ANY($1)"};
+
+const core::tenant_query::TenantQuery kSelectTeamsById{
+    "attendance_calendar_select_teams_by_id",
+    "SELECT employee_id, team_id "
+    "FROM {schema}.employee_team "
+    "WHERE employee_id = ANY($1)"};
+
+const core::tenant_query::TenantQuery kSelectActionsById{
+    "attendance_calendar_select_actions_by_id",
+    "SELECT user_id, type, start_date, end_date "
+    "FROM {schema}.actions "
+    "WHERE user_id = ANY($1) AND (type = 'attendance' OR status = 'approved')"};
+
+}  // namespace
+
+AttendanceCalendar::AttendanceCalendar(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context)
+    : CachingComponentBase(config, context),
+      pg_cluster_(
+          context.FindComponent<userver::components::Postgres>("key-value")
+              .GetCluster()),
+      update_correction_(
+          config["update-correction"].As<std::chrono::milliseconds>(
+              std::chrono::seconds{10})) {
+  StartPeriodicUpdates();
+}
+
+AttendanceCalendar::~AttendanceCalendar() { StopPeriodicUpdates(); }
+
+void AttendanceCalendar::ForEachTeamEntry(
+    const std::string& company_id, const std::string& employee_id,
+    TimePoint from, TimePoint to,
+    const std::function<void(const CalendarEntry&)>& on_entry) const {
+  const auto snapshot = Get();
+  auto it = snapshot->companies.find(company_id);
+  if (it == snapshot->companies.end()) {
+    return;
+  }
+  const auto& calendar = *it->second;
+  calendar.ForEachEntry(calendar.GetTeams(employee_id), from, to, on_entry);
+}
+
+void AttendanceCalendar::RefreshEmployee(const std::string& company_id,
+                                         const std::string& employee_id) {
+  auto employee_result = pg_cluster_->Execute(
+      userver::storages::postgres::ClusterHostType::kMaster,
+      kSelectEmployee.For(company_id), employee_id);
+  if (employee_result.IsEmpty()) {
+    RemoveEmployee(company_id, employee_id);
+    return;
+  }
+
+  EmployeeRecord record;
+  record.employee = employee_result.AsSingleRow<CalendarEmployee>(
+      userver::storages::postgres::kRowTag);
+
+  record.teams =
+      pg_cluster_
+          ->Execute(userver::storages::postgres::ClusterHostType::kMaster,
+                    kSelectEmployeeTeams.For(company_id), employee_id)
+          .AsContainer<std::vector<std::string>>();
+
+  record.actions =
+      pg_cluster_
+          ->Execute(userver::storages::postgres::ClusterHostType::kMaster,
+                    kSelectEmployeeActions.For(company_id), employee_id)
+          .AsContainer<std::vector<CalendarAction>>(
+              userver::storages::postgres::kRowTag);
+
+  WriteThrough(company_id, [record = std::move(record)](
+                               CompanyCalendar& calendar) {
+    calendar.UpsertEmployee(record);
+  });
+}
+
+void AttendanceCalendar::RemoveEmployee(const std::string& company_id,
+                                        const std::string& employee_id) {
+  WriteThrough(company_id, [employee_id](CompanyCalendar& calendar) {
+    calendar.RemoveEmployee(employee_id);
+  });
+}
+
+void AttendanceCalendar::Update(
+    userver::cache::UpdateType type,
+    const std::chrono::system_clock::time_point& last_update,
+    const std::chrono::system_clock::time_point& /*now*/,
+    userver::cache::UpdateStatisticsScope& stats_scope) {
+  auto schemas = pg_cluster_->Execute(
+      userver::storages::postgres::ClusterHostType::kSlave,
+      "SELECT substr(schema_name, 13) "
+      "FROM information_schema.schemata "
+      "WHERE schema_name LIKE 'working\\_day\\_%'");
+
+  // Rows committed after the previous update may carry an earlier `updated`
+  // and the replica may lag behind, so the window starts a bit earlier
+  const userver::storages::postgres::TimePointTz updated_after{
+      last_update - update_correction_};
+  std::unordered_map<std::string, std::shared_ptr<CompanyCalendar>> known;
+  if (type == userver::cache::UpdateType::kIncremental) {
+    known = Get()->companies;
+  }
+
+  CompanyCalendars calendars;
+  for (const auto& company_id :
+       schemas.AsContainer<std::vector<std::string>>()) {
+    auto it = known.find(company_id);
+    std::shared_ptr<CompanyCalendar> calendar;
+    std::unordered_map<std::string, EmployeeRecord> records;
+    if (it != known.end()) {
+      calendar = it->second;
+      records = LoadRecords(company_id, updated_after, stats_scope);
+    } else {
+      calendar = std::make_shared<CompanyCalendar>();
+      records = LoadRecords(company_id, std::nullopt, stats_scope);
+    }
+    for (auto& [employee_id, record] : records) {
+      calendar->UpsertEmployee(std::move(record));
+    }
+    calendars.companies.emplace(company_id, std::move(calendar));
+  }
+
+  std::lock_guard journal_lock(journal_mutex_);
+  for (const auto& [company_id, write] : journal_) {
+    auto& calendar = calendars.companies[company_id];
+    if (!calendar) {
+      calendar = std::make_shared<CompanyCalendar>();
+    }
+    write(*calendar);
+  }
+  journal_.clear();
+
+  size_t employees_count = 0;
+  for (const auto& [company_id, calendar] : calendars.companies) {
+    employees_count += calendar->EmployeesCount();
+  }
+
+  std::lock_guard lock(set_mutex_);
+  Set(std::move(calendars));
+  stats_scope.Finish(employees_count);
+}
+
+std::unordered_map<std::string, EmployeeRecord>
+AttendanceCalendar::LoadRecords(
+    const std::string& company_id,
+    const std::optional<userver::storages::postgres::TimePointTz>&
+        updated_after,
+    userver::cache::UpdateStatisticsScope& stats_scope) const {
+  const auto host = userver::storages::postgres::ClusterHostType::kSlave;
+  std::optional<std::vector<std::string>> changed_ids;
+  if (updated_after.has_value()) {
+    changed_ids =
+        pg_cluster_
+            ->Execute(host, kSelectChangedEmployees.For(company_id),
+                      *updated_after)
+            .AsContainer<std::vector<std::string>>();
+    if (changed_ids->empty()) {
+      return {};
+    }
+  }
+
+  auto employees_result =
+      changed_ids.has_value()
+          ? pg_cluster_->Execute(host, kSelectEmployeesById.For(company_id),
+                                 *changed_ids)
+          : pg_cluster_->Execute(host, kSelectEmployees.For(company_id));
+  if (employees_result.IsEmpty()) {
+    return {};
+  }
+  auto teams_result =
+      changed_ids.has_value()
+          ? pg_cluster_->Execute(host, kSelectTeamsById.For(company_id),
+                                 *changed_ids)
+          : pg_cluster_->Execute(host, kSelectTeams.For(company_id));
+  auto actions_result =
+      changed_ids.has_value()
+          ? pg_cluster_->Execute(host, kSelectActionsById.For(company_id),
+                                 *changed_ids)
+          : pg_cluster_->Execute(host, kSelectActions.For(company_id));
+  stats_scope.IncreaseDocumentsReadCount(
+      employees_result.Size() + teams_result.Size() + actions_result.Size());
+
+  std::unordered_map<std::string, EmployeeRecord> records;
+  for (auto& employee :
+       employees_result.AsContainer<std::vector<CalendarEmployee>>(
+           userver::storages::postgres::kRowTag)) {
+    auto employee_id = employee.id;
+    records[std::move(employee_id)].employee = std::move(employee);
+  }
+
+  for (auto& row : teams_result.AsContainer<std::vector<TeamRow>>(
+           userver::storages::postgres::kRowTag)) {
+    if (auto it = records.find(row.employee_id); it != records.end()) {
+      it->second.teams.push_back(std::move(row.team_id));
+    }
+  }
+
+  for (auto& row : actions_result.AsContainer<std::vector<ActionRow>>(
+           userver::storages::postgres::kRowTag)) {
+    if (auto it = records.find(row.employee_id); it != records.end()) {
+      it->second.actions.push_back(
+          {std::move(row.type), row.start_date, row.end_date});
+    }
+  }
+  return records;
+}
+
+std::shared_ptr<CompanyCalendar> AttendanceCalendar::GetOrCreateCompany(
+    const std::string& company_id) {
+  {
+    const auto snapshot = Get();
+    auto it = snapshot->companies.find(company_id);
+    if (it != snapshot->companies.end()) {
+      return it->second;
+    }
+  }
+
+  std::lock_guard lock(set_mutex_);
+  auto calendars = *Get();
+  auto [it, inserted] = calendars.companies.emplace(
+      company_id, std::make_shared<CompanyCalendar>());
+  auto calendar = it->second;
+  if (inserted) {
+    LOG_INFO() << "Created attendance calendar for company " << company_id;
+    Set(std::move(calendars));
+  }
+  return calendar;
+}
+
+void AttendanceCalendar::WriteThrough(const std::string& company_id,
+                                      Write write) {
+  std::lock_guard lock(journal_mutex_);
+  write(*GetOrCreateCompany(company_id));
+  journal_.emplace_back(company_id, std::move(write));
+}
+
+userver::yaml_config::Schema AttendanceCalendar::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::CachingComponentBase<CompanyCalendars>>(R"(
+type: object
+description: In-memory attendance calendar of every company
+additionalProperties: false
+properties:
+    update-correction:
+        type: string
+        description: lookback of incremental updates past the previous one
+        defaultDescription: 10s
+)");
+}
+
+}  // namespace core::attendance_calendar
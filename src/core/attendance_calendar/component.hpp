@@ -0,0 +1,88 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <userver/cache/caching_component_base.hpp>
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+#include "company_calendar.hpp"
+
+namespace core::attendance_calendar {
+
+struct CompanyCalendars {
+  std::unordered_map<std::string, std::shared_ptr<CompanyCalendar>> companies;
+};
+
+// Per-company attendance calendars. Fully reloaded on full updates,
+// incremental updates reload the employees whose row, actions or teams moved
+// their `updated`. Handlers that change
+// actions, employees or teams refresh the touched employee right after their
+// transaction commits, refreshes since the last update are applied again to
+// the calendars it sets.
+class AttendanceCalendar final
+    : public userver::components::CachingComponentBase<CompanyCalendars> {
+ public:
+  static constexpr std::string_view kName = "attendance-calendar";
+
+  AttendanceCalendar(const userver::components::ComponentConfig& config,
+                     const userver::components::ComponentContext& context);
+
+  ~AttendanceCalendar() override;
+
+  // Entries of the employees of every team `employee_id` is a member of
+  void ForEachTeamEntry(
+      const std::string& company_id, const std::string& employee_id,
+      TimePoint from, TimePoint to,
+      const std::function<void(const CalendarEntry&)>& on_entry) const;
+
+  // Reloads the employee from the master, removes it if it no longer exists
+  void RefreshEmployee(const std::string& company_id,
+                       const std::string& employee_id);
+
+  void RemoveEmployee(const std::string& company_id,
+                      const std::string& employee_id);
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  void Update(userver::cache::UpdateType type,
+              const std::chrono::system_clock::time_point& last_update,
+              const std::chrono::system_clock::time_point& now,
+              userver::cache::UpdateStatisticsScope& stats_scope) override;
+
+  // All employees of the company, or the ones changed after `updated_after`
+  std::unordered_map<std::string, EmployeeRecord> LoadRecords(
+      const std::string& company_id,
+      const std::optional<userver::storages::postgres::TimePointTz>&
+          updated_after,
+      userver::cache::UpdateStatisticsScope& stats_scope) const;
+
+  std::shared_ptr<CompanyCalendar> GetOrCreateCompany(
+      const std::string& company_id);
+
+  using Write = std::function<void(CompanyCalendar&)>;
+
+  void WriteThrough(const std::string& company_id, Write write);
+
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+  const std::chrono::milliseconds update_correction_;
+  userver::engine::Mutex set_mutex_;
+
+  // Refreshes since the last Set, taken before set_mutex_
+  userver::engine::Mutex journal_mutex_;
+  std::vector<std::pair<std::string, Write>> journal_;
+};
+
+}  // namespace core::attendance_calendar
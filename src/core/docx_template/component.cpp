@@ -0,0 +1,93 @@
+#include "component.hpp"
+
+#include <filesystem>
+
+#include <userver/fs/blocking/read.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+namespace core::docx_template {
+
+namespace {
+
+std::string TemplateName(std::string_view company_id, std::string_view type) {
+  std::string name{company_id};
+  name.append("_").append(type);
+  return name;
+}
+
+}  // namespace
+
+TemplateStore::TemplateStore(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context)
+    : LoggableComponentBase(config, context),
+      default_company_(
+          config["default-company"].As<std::optional<std::string>>()),
+      subcompanies_(
+          config["subcompanies"]
+              .As<std::unordered_map<std::string, std::string>>({})) {
+  const auto directory = config["templates-dir"].As<std::string>();
+  for (const auto& file : std::filesystem::directory_iterator(directory)) {
+    const auto& path = file.path();
+    if (!file.is_regular_file() || path.extension() != ".docx") {
+      continue;
+    }
+    templates_.emplace(
+        path.stem().string(),
+        DocxTemplate{userver::fs::blocking::ReadFileContents(path.string())});
+  }
+  LOG_INFO() << "Loaded " << templates_.size() << " document templates from "
+             << directory;
+}
+
+const DocxTemplate* TemplateStore::Find(std::string_view company_id,
+                                        std::string_view subcompany,
+                                        std::string_view type) const {
+  const auto prefix = subcompanies_.find(std::string(subcompany));
+  if (prefix != subcompanies_.end()) {
+    if (const auto* found = FindByName(TemplateName(prefix->second, type))) {
+      return found;
+    }
+  }
+  if (const auto* found = FindByName(TemplateName(company_id, type))) {
+    return found;
+  }
+  if (const auto* found = FindByName(std::string(type))) {
+    return found;
+  }
+  if (default_company_.has_value()) {
+    return FindByName(TemplateName(*default_company_, type));
+  }
+  return nullptr;
+}
+
+const DocxTemplate* TemplateStore::FindByName(const std::string& name) const {
+  const auto it = templates_.find(name);
+  return it != templates_.end() ? &it->second : nullptr;
+}
+
+userver::yaml_config::Schema TemplateStore::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::LoggableComponentBase>(R"(
+type: object
+description: DOCX templates of the documents
+additionalProperties: false
+properties:
+    templates-dir:
+        type: string
+        description: directory with the .docx templates
+    default-company:
+        type: string
+        description: company whose templates serve companies without their own
+    subcompanies:
+        type: object
+        description: prefixes of the subcompanies with templates of their own
+        properties: {}
+        additionalProperties:
+            type: string
+            description: prefix of the templates of the subcompany
+)");
+}
+
+}  // namespace core::docx_template
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+#include "template.hpp"
+
+namespace core::docx_template {
+
+// DOCX templates of the documents, every `.docx` of `templates-dir` is
+// parsed once at start. The template of a document type for a company is
+// `<company_id>_<type>.docx`, with `<type>.docx` and the templates of
+// `default-company` used for companies without their own. A subcompany
+// listed in `subcompanies` has templates of its own prefix.
+class TemplateStore final : public userver::components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName = "docx-templates";
+
+  TemplateStore(const userver::components::ComponentConfig& config,
+                const userver::components::ComponentContext& context);
+
+  // nullptr if there is no template of the type for the company
+  const DocxTemplate* Find(std::string_view company_id,
+                           std::string_view subcompany,
+                           std::string_view type) const;
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  const DocxTemplate* FindByName(const std::string& name) const;
+
+  const std::optional<std::string> default_company_;
+  const std::unordered_map<std::string, std::string> subcompanies_;
+  std::unordered_map<std::string, DocxTemplate> templates_;
+};
+
+}  // namespace core::docx_template
@@ -0,0 +1,39 @@
+#include "converter.hpp"
+
+#include <userver/http/url.hpp>
+#include <userver/logging/log.hpp>
+
+namespace core::docx_template {
+
+namespace {
+
+const std::string kQueueDepthHeader = "X-Queue-Depth";
+
+}  // namespace
+
+std::shared_ptr<userver::clients::http::Response> RequestPdf(
+    userver::clients::http::Client& http_client, const std::string& url,
+    std::string_view file_key, const PdfStamp& stamp, std::string docx,
+    std::chrono::milliseconds timeout) {
+  const auto request_url =
+      url + "?file_key=" + userver::http::UrlEncode(file_key) +
+      "&employee_id=" + userver::http::UrlEncode(stamp.employee_id) +
+      "&employee_initials=" +
+      userver::http::UrlEncode(stamp.employee_initials) +
+      "&company_name=" + userver::http::UrlEncode(stamp.company_name);
+
+  auto response = http_client.CreateRequest()
+                      .post(request_url, std::move(docx))
+                      .retry(2)  // retry once in case of error
+                      .timeout(timeout)
+                      .perform();  // start performing the request
+
+  const auto& headers = response->headers();
+  const auto queue_depth = headers.find(kQueueDepthHeader);
+  if (queue_depth != headers.end()) {
+    LOG_INFO() << "Document converter queue depth: " << queue_depth->second;
+  }
+  return response;
+}
+
+}  // namespace core::docx_template
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <userver/clients/http/client.hpp>
+#include <userver/clients/http/response.hpp>
+
+namespace core::docx_template {
+
+// Signature stamp the document service puts on the PDF
+struct PdfStamp {
+  std::string employee_id, employee_initials, company_name;
+};
+
+inline constexpr int kConverterBusyStatus = 503;
+
+// Sends a rendered DOCX to the document service at `url`, which converts it
+// to a stamped PDF stored as `<file_key>.pdf` and answers with a download
+// link. The service answers kConverterBusyStatus with Retry-After when its
+// converters are saturated. The response is returned as is.
+std::shared_ptr<userver::clients::http::Response> RequestPdf(
+    userver::clients::http::Client& http_client, const std::string& url,
+    std::string_view file_key, const PdfStamp& stamp, std::string docx,
+    std::chrono::milliseconds timeout);
+
+}  // namespace core::docx_template
@@ -0,0 +1,212 @@
+#include "template.hpp"
+
+#include <algorithm>
+#include <optional>
+
+namespace core::docx_template {
+
+namespace {
+
+constexpr std::string_view kDocumentPart = "word/document.xml";
+constexpr std::string_view kTextClose = "</w:t>";
+
+// Content of a <w:t> element, positions in the document
+struct TextNode {
+  size_t begin, end;
+};
+
+bool IsMacroNameChar(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') || c == '_';
+}
+
+// Calls `on_paragraph` with the text nodes of every paragraph in order. A
+// paragraph nested into another one, e.g. in a text box, splits it.
+template <typename OnParagraph>
+void ForEachParagraph(std::string_view xml, OnParagraph on_paragraph) {
+  std::vector<TextNode> nodes;
+  const auto flush = [&] {
+    if (!nodes.empty()) {
+      on_paragraph(nodes);
+      nodes.clear();
+    }
+  };
+
+  for (auto pos = xml.find('<'); pos != std::string_view::npos;
+       pos = xml.find('<', pos)) {
+    const auto tag_end = xml.find('>', pos);
+    if (tag_end == std::string_view::npos) {
+      break;
+    }
+    auto tag = xml.substr(pos + 1, tag_end - pos - 1);
+    const bool closing = !tag.empty() && tag.front() == '/';
+    const bool empty = !tag.empty() && tag.back() == '/';
+    if (closing) {
+      tag.remove_prefix(1);
+    }
+    const auto name = tag.substr(0, tag.find_first_of(" /"));
+    pos = tag_end + 1;
+
+    if (name == "w:p") {
+      flush();
+    } else if (name == "w:t" && !closing && !empty) {
+      const auto close = xml.find(kTextClose, pos);
+      if (close == std::string_view::npos) {
+        break;
+      }
+      nodes.push_back({pos, close});
+      pos = close + kTextClose.size();
+    }
+  }
+  flush();
+}
+
+// Calls `on_macro(nodes, first, last, begin, end)` for every macro of the
+// document in order. The macro starts at `begin` in nodes[first] and ends
+// before `end` in nodes[last], both positions are in the document.
+template <typename OnMacro>
+void ForEachMacro(std::string_view xml, OnMacro on_macro) {
+  ForEachParagraph(xml, [&](const std::vector<TextNode>& nodes) {
+    std::string text;
+    std::vector<size_t> starts;
+    for (const auto& node : nodes) {
+      starts.push_back(text.size());
+      text.append(xml.substr(node.begin, node.end - node.begin));
+    }
+    const auto node_of = [&](size_t offset) -> size_t {
+      return std::upper_bound(starts.begin(), starts.end(), offset) -
+             starts.begin() - 1;
+    };
+
+    for (auto open = text.find('%'); open != std::string::npos;) {
+      const auto close = text.find('%', open + 1);
+      if (close == std::string::npos) {
+        break;
+      }
+      if (close == open + 1 ||
+          !std::all_of(text.begin() + open + 1, text.begin() + close,
+                       IsMacroNameChar)) {
+        // The closing `%` may open the next macro
+        open = close;
+        continue;
+      }
+
+      const auto first = node_of(open);
+      const auto last = node_of(close);
+      on_macro(nodes, first, last, nodes[first].begin + open - starts[first],
+               nodes[last].begin + close + 1 - starts[last]);
+      open = text.find('%', close + 1);
+    }
+  });
+}
+
+// Moves every macro split over several text nodes into its first node
+std::string JoinSplitMacros(std::string_view xml) {
+  struct Edit {
+    size_t begin, end;
+    std::string text;
+  };
+  std::vector<Edit> edits;
+  ForEachMacro(xml, [&](const std::vector<TextNode>& nodes, size_t first,
+                        size_t last, size_t begin, size_t end) {
+    if (first == last) {
+      return;
+    }
+    std::string macro;
+    for (auto i = first; i <= last; ++i) {
+      const auto piece_begin = i == first ? begin : nodes[i].begin;
+      const auto piece_end = i == last ? end : nodes[i].end;
+      macro.append(xml.substr(piece_begin, piece_end - piece_begin));
+      edits.push_back({piece_begin, piece_end, {}});
+    }
+    edits[edits.size() - (last - first + 1)].text = std::move(macro);
+  });
+
+  std::string joined;
+  joined.reserve(xml.size());
+  size_t pos = 0;
+  for (const auto& edit : edits) {
+    joined.append(xml.substr(pos, edit.begin - pos)).append(edit.text);
+    pos = edit.end;
+  }
+  joined.append(xml.substr(pos));
+  return joined;
+}
+
+void AppendEscaped(std::string& out, std::string_view value) {
+  for (const auto c : value) {
+    switch (c) {
+      case '&':
+        out.append("&amp;");
+        break;
+      case '<':
+        out.append("&lt;");
+        break;
+      case '>':
+        out.append("&gt;");
+        break;
+      case '"':
+        out.append("&quot;");
+        break;
+      case '\'':
+        out.append("&apos;");
+        break;
+      default:
+        out.push_back(c);
+    }
+  }
+}
+
+}  // namespace
+
+DocxTemplate::DocxTemplate(std::string_view archive) {
+  std::optional<std::string> document;
+  for (const auto& entry : ReadZip(archive)) {
+    if (entry.name == kDocumentPart) {
+      document = Extract(entry);
+      document_name_ = entry.name;
+      document_time_ = entry.time;
+      document_date_ = entry.date;
+    } else {
+      entries_.AddCompressed(entry);
+    }
+  }
+  if (!document.has_value()) {
+    throw ZipError("Archive has no " + std::string(kDocumentPart));
+  }
+
+  const auto xml = JoinSplitMacros(*document);
+  size_t literal_begin = 0;
+  ForEachMacro(xml, [&](const std::vector<TextNode>&, size_t, size_t,
+                        size_t begin, size_t end) {
+    literals_.emplace_back(xml, literal_begin, begin - literal_begin);
+    macros_.emplace_back(xml, begin + 1, end - begin - 2);
+    literal_begin = end;
+  });
+  literals_.emplace_back(xml, literal_begin);
+  for (const auto& literal : literals_) {
+    literals_size_ += literal.size();
+  }
+}
+
+std::string DocxTemplate::Render(const Macros& macros) const {
+  std::string document;
+  document.reserve(literals_size_);
+  for (size_t i = 0; i < macros_.size(); ++i) {
+    document.append(literals_[i]);
+    const auto value = macros.find(macros_[i]);
+    if (value != macros.end()) {
+      AppendEscaped(document, value->second);
+    } else {
+      document.append("%").append(macros_[i]).append("%");
+    }
+  }
+  document.append(literals_.back());
+
+  auto writer = entries_;
+  writer.AddDeflated(document_name_, document, document_time_,
+                     document_date_);
+  return std::move(writer).Finish();
+}
+
+}  // namespace core::docx_template
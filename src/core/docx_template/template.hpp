@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "zip.hpp"
+
+namespace core::docx_template {
+
+// Values of the macros, `%name%` in a template stands for the value of
+// "name". Macros without a value are left as they are.
+using Macros = std::unordered_map<std::string, std::string>;
+
+// DOCX file with `%name%` macros in the text of word/document.xml.
+//
+// The archive is parsed once. Macros that the editor split over several
+// runs are joined into the first run, the document is cut into literal
+// pieces around the macros and all other entries are kept compressed, so a
+// render only escapes the values and deflates the document part.
+class DocxTemplate {
+ public:
+  explicit DocxTemplate(std::string_view archive);
+
+  std::string Render(const Macros& macros) const;
+
+  const std::vector<std::string>& MacroNames() const { return macros_; }
+
+ private:
+  ZipWriter entries_;
+  std::string document_name_;
+  uint16_t document_time_, document_date_;
+
+  // literals_[i] precedes macros_[i], the last literal ends the document
+  std::vector<std::string> literals_;
+  std::vector<std::string> macros_;
+  size_t literals_size_ = 0;
+};
+
+}  // namespace core::docx_template
@@ -0,0 +1,93 @@
+#include "template.hpp"
+
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+using core::docx_template::DocxTemplate;
+
+std::string Document(std::string_view body) {
+  return "<?xml version=\"1.0\"?><w:document><w:body>" + std::string(body) +
+         "</w:body></w:document>";
+}
+
+std::string Docx(std::string_view document_xml) {
+  core::docx_template::ZipWriter writer;
+  writer.AddDeflated("[Content_Types].xml", "<Types/>");
+  writer.AddDeflated("word/document.xml", document_xml);
+  writer.AddDeflated("word/styles.xml", "<w:styles/>");
+  return std::move(writer).Finish();
+}
+
+std::string RenderedDocument(const DocxTemplate& docx_template,
+                             const core::docx_template::Macros& macros) {
+  const auto archive = docx_template.Render(macros);
+  for (const auto& entry : core::docx_template::ReadZip(archive)) {
+    if (entry.name == "word/document.xml") {
+      return core::docx_template::Extract(entry);
+    }
+  }
+  return {};
+}
+
+}  // namespace
+
+UTEST(DocxTemplate, ZipRoundTrip) {
+  const auto archive = Docx(Document(""));
+  const auto entries = core::docx_template::ReadZip(archive);
+  ASSERT_EQ(entries.size(), 3u);
+  EXPECT_EQ(entries[0].name, "[Content_Types].xml");
+  EXPECT_EQ(core::docx_template::Extract(entries[0]), "<Types/>");
+
+  core::docx_template::ZipWriter copy;
+  for (const auto& entry : entries) {
+    copy.AddCompressed(entry);
+  }
+  EXPECT_EQ(std::move(copy).Finish(), archive);
+
+  EXPECT_THROW(core::docx_template::ReadZip("not a zip archive at all"),
+               core::docx_template::ZipError);
+  EXPECT_THROW(core::docx_template::ReadZip(archive.substr(20)),
+               core::docx_template::ZipError);
+}
+
+UTEST(DocxTemplate, Render) {
+  const DocxTemplate docx_template{Docx(Document(
+      "<w:p><w:r><w:t>Dear %name% %surname%,</w:t></w:r></w:p>"
+      "<w:p><w:r><w:t xml:space=\"preserve\">50% off for %name%</w:t></w:r>"
+      "</w:p>"))};
+  EXPECT_EQ(docx_template.MacroNames(),
+            (std::vector<std::string>{"name", "surname", "name"}));
+
+  EXPECT_EQ(
+      RenderedDocument(docx_template, {{"name", "A&B"}, {"surname", "<C>"}}),
+      Document("<w:p><w:r><w:t>Dear A&amp;B &lt;C&gt;,</w:t></w:r></w:p>"
+               "<w:p><w:r><w:t xml:space=\"preserve\">50% off for A&amp;B"
+               "</w:t></w:r></w:p>"));
+
+  // Macros without a value are kept
+  EXPECT_EQ(RenderedDocument(docx_template, {{"name", "A"}}),
+            Document("<w:p><w:r><w:t>Dear A %surname%,</w:t></w:r></w:p>"
+                     "<w:p><w:r><w:t xml:space=\"preserve\">50% off for A"
+                     "</w:t></w:r></w:p>"));
+}
+
+UTEST(DocxTemplate, SplitMacros) {
+  const DocxTemplate docx_template{Docx(Document(
+      "<w:p><w:r><w:t>From %start_</w:t></w:r><w:r><w:rPr><w:b/></w:rPr>"
+      "<w:t>da</w:t></w:r><w:r><w:t>te% to %end_date%</w:t></w:r></w:p>"
+      "<w:p><w:r><w:t>100%</w:t></w:r></w:p>"
+      "<w:p><w:r><w:t>sure%</w:t></w:r></w:p>"))};
+  EXPECT_EQ(docx_template.MacroNames(),
+            (std::vector<std::string>{"start_date", "end_date"}));
+
+  // Pieces of a macro are removed from the runs after the first one, a `%`
+  // is not paired across paragraphs
+  EXPECT_EQ(
+      RenderedDocument(docx_template,
+                       {{"start_date", "01.07.2023"}, {"end_date", "14.07"}}),
+      Document("<w:p><w:r><w:t>From 01.07.2023</w:t></w:r><w:r><w:rPr><w:b/>"
+               "</w:rPr><w:t></w:t></w:r><w:r><w:t> to 14.07</w:t></w:r>"
+               "</w:p><w:p><w:r><w:t>100%</w:t></w:r></w:p>"
+               "<w:p><w:r><w:t>sure%</w:t></w:r></w:p>"));
+}
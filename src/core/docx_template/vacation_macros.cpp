@@ -0,0 +1,111 @@
+#include "vacation_macros.hpp"
+
+#include <userver/utils/datetime.hpp>
+
+namespace core::docx_template {
+
+namespace {
+
+std::string FormatDate(VacationDocument::TimePoint date) {
+  return userver::utils::datetime::Timestring(date, "UTC", "%d.%m.%Y");
+}
+
+// First character of a UTF-8 string
+std::string_view FirstLetter(std::string_view text) {
+  if (text.empty()) {
+    return text;
+  }
+  const auto lead = static_cast<unsigned char>(text.front());
+  size_t size = 1;
+  if (lead >= 0xf0) {
+    size = 4;
+  } else if (lead >= 0xe0) {
+    size = 3;
+  } else if (lead >= 0xc0) {
+    size = 2;
+  }
+  return text.substr(0, size);
+}
+
+std::string_view DaysWord(int64_t days) {
+  const auto last_two = days % 100;
+  const auto last = days % 10;
+  if (last_two >= 10 && last_two <= 20) {
+    return "календарных дней";
+  }
+  if (last == 1) {
+    return "календарный день";
+  }
+  if (last >= 2 && last <= 4) {
+    return "календарных дня";
+  }
+  return "календарных дней";
+}
+
+}  // namespace
+
+std::string Initials(std::string_view surname, std::string_view name,
+                     const std::optional<std::string>& patronymic) {
+  std::string initials{surname};
+  initials.append(" ").append(FirstLetter(name)).append(".");
+  if (patronymic.has_value() && !patronymic->empty()) {
+    initials.append(FirstLetter(*patronymic)).append(".");
+  }
+  return initials;
+}
+
+std::string Duration(VacationDocument::TimePoint start,
+                     VacationDocument::TimePoint end) {
+  const auto days = (std::chrono::floor<std::chrono::days>(end) -
+                     std::chrono::floor<std::chrono::days>(start))
+                        .count() +
+                    1;
+  auto duration = std::to_string(days);
+  duration.append(" ").append(DaysWord(days));
+  return duration;
+}
+
+Macros VacationMacros(const VacationDocument& document,
+                      VacationDocument::TimePoint today) {
+  Macros macros{
+      {"employee_name", document.employee_name},
+      {"employee_surname", document.employee_surname},
+      {"employee_patronymic", document.employee_patronymic.value_or("")},
+      {"employee_position", document.employee_position.value_or("")},
+      {"employee_initials",
+       Initials(document.employee_surname, document.employee_name,
+                document.employee_patronymic)},
+      {"head_name", document.head_name},
+      {"head_surname", document.head_surname},
+      {"head_patronymic", document.head_patronymic.value_or("")},
+      {"head_position", document.head_position.value_or("")},
+      {"head_initials", Initials(document.head_surname, document.head_name,
+                                 document.head_patronymic)},
+      {"start_date", FormatDate(document.start_date)},
+      {"end_date", FormatDate(document.end_date)},
+      {"duration", Duration(document.start_date, document.end_date)},
+      {"now_date", FormatDate(today)},
+      {"first_start_date", ""},
+      {"first_end_date", ""},
+      {"first_duration", ""},
+      {"second_start_date", ""},
+      {"second_end_date", ""},
+      {"second_duration", ""},
+  };
+
+  if (document.first_start_date && document.first_end_date) {
+    macros["first_start_date"] = FormatDate(*document.first_start_date);
+    macros["first_end_date"] = FormatDate(*document.first_end_date);
+    macros["first_duration"] =
+        Duration(*document.first_start_date, *document.first_end_date);
+  }
+  if (document.second_start_date && document.second_end_date) {
+    macros["second_start_date"] = FormatDate(*document.second_start_date);
+    macros["second_end_date"] = FormatDate(*document.second_end_date);
+    macros["second_duration"] =
+        Duration(*document.second_start_date, *document.second_end_date);
+  }
+  return macros;
+}
+
+}  // namespace core::docx_template
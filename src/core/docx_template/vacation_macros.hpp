@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "template.hpp"
+
+namespace core::docx_template {
+
+// Fields of the vacation request documents, dates are days in UTC
+struct VacationDocument {
+  using TimePoint = std::chrono::system_clock::time_point;
+
+  std::string employee_name, employee_surname;
+  std::optional<std::string> employee_patronymic, employee_position;
+  std::string head_name, head_surname;
+  std::optional<std::string> head_patronymic, head_position;
+  TimePoint start_date, end_date;
+
+  // Parts of a split vacation
+  std::optional<TimePoint> first_start_date, first_end_date;
+  std::optional<TimePoint> second_start_date, second_end_date;
+};
+
+// "Surname N.P."
+std::string Initials(std::string_view surname, std::string_view name,
+                     const std::optional<std::string>& patronymic);
+
+// Length of a vacation with both ends included, "14 календарных дней"
+std::string Duration(VacationDocument::TimePoint start,
+                     VacationDocument::TimePoint end);
+
+// Macros of the vacation templates, `today` is the date of the document
+Macros VacationMacros(const VacationDocument& document,
+                      VacationDocument::TimePoint today);
+
+}  // namespace core::docx_template
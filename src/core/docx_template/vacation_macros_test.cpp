@@ -0,0 +1,33 @@
+#include "vacation_macros.hpp"
+
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+using std::chrono::days;
+
+const core::docx_template::VacationDocument::TimePoint kJuly10{
+    std::chrono::seconds{1688947200}};
+
+}  // namespace
+
+UTEST(VacationMacros, Initials) {
+  EXPECT_EQ(core::docx_template::Initials("Иванов", "Пётр", "Сергеевич"),
+            "Иванов П.С.");
+  EXPECT_EQ(core::docx_template::Initials("Smith", "John", std::nullopt),
+            "Smith J.");
+  EXPECT_EQ(core::docx_template::Initials("Smith", "John", ""), "Smith J.");
+}
+
+UTEST(VacationMacros, Duration) {
+  EXPECT_EQ(core::docx_template::Duration(kJuly10, kJuly10),
+            "1 календарный день");
+  EXPECT_EQ(core::docx_template::Duration(kJuly10, kJuly10 + days{2}),
+            "3 календарных дня");
+  EXPECT_EQ(core::docx_template::Duration(kJuly10, kJuly10 + days{11}),
+            "12 календарных дней");
+  EXPECT_EQ(core::docx_template::Duration(kJuly10, kJuly10 + days{20}),
+            "21 календарный день");
+  EXPECT_EQ(core::docx_template::Duration(kJuly10, kJuly10 + days{24}),
+            "25 календарных дней");
+}
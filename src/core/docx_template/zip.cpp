@@ -0,0 +1,246 @@
+#include "zip.hpp"
+
+#include <limits>
+
+#include <zlib.h>
+
+namespace core::docx_template {
+
+namespace {
+
+constexpr uint32_t kLocalHeaderSignature = 0x04034b50;
+constexpr uint32_t kCentralHeaderSignature = 0x02014b50;
+constexpr uint32_t kEndOfDirectorySignature = 0x06054b50;
+
+constexpr size_t kLocalHeaderSize = 30;
+constexpr size_t kCentralHeaderSize = 46;
+constexpr size_t kEndOfDirectorySize = 22;
+constexpr size_t kMaxCommentSize = 0xffff;
+
+constexpr uint16_t kVersionNeeded = 20;
+constexpr uint16_t kEncryptedFlag = 1;
+constexpr uint16_t kUtf8NameFlag = 1 << 11;
+
+uint16_t Read16(std::string_view data, size_t pos) {
+  if (pos + 2 > data.size()) {
+    throw ZipError("Archive is truncated");
+  }
+  return static_cast<uint8_t>(data[pos]) |
+         static_cast<uint8_t>(data[pos + 1]) << 8;
+}
+
+uint32_t Read32(std::string_view data, size_t pos) {
+  return Read16(data, pos) | static_cast<uint32_t>(Read16(data, pos + 2))
+                                 << 16;
+}
+
+std::string_view Slice(std::string_view data, size_t pos, size_t size) {
+  if (pos > data.size() || size > data.size() - pos) {
+    throw ZipError("Archive is truncated");
+  }
+  return data.substr(pos, size);
+}
+
+void Write16(std::string& out, uint16_t value) {
+  out.push_back(static_cast<char>(value & 0xff));
+  out.push_back(static_cast<char>(value >> 8));
+}
+
+void Write32(std::string& out, uint32_t value) {
+  Write16(out, static_cast<uint16_t>(value & 0xffff));
+  Write16(out, static_cast<uint16_t>(value >> 16));
+}
+
+uint32_t Crc32(std::string_view data) {
+  return static_cast<uint32_t>(
+      crc32(0, reinterpret_cast<const Bytef*>(data.data()),
+            static_cast<uInt>(data.size())));
+}
+
+uint32_t CheckedSize(size_t size) {
+  if (size > std::numeric_limits<uint32_t>::max()) {
+    throw ZipError("Entry is too large");
+  }
+  return static_cast<uint32_t>(size);
+}
+
+size_t FindEndOfDirectory(std::string_view archive) {
+  if (archive.size() < kEndOfDirectorySize) {
+    throw ZipError("Not a zip archive");
+  }
+  const auto last = archive.size() - kEndOfDirectorySize;
+  const auto first =
+      last > kMaxCommentSize ? last - kMaxCommentSize : size_t{0};
+  for (auto pos = last + 1; pos-- > first;) {
+    if (Read32(archive, pos) == kEndOfDirectorySignature) {
+      return pos;
+    }
+  }
+  throw ZipError("Not a zip archive");
+}
+
+}  // namespace
+
+std::vector<ZipEntry> ReadZip(std::string_view archive) {
+  const auto end = FindEndOfDirectory(archive);
+  const auto count = Read16(archive, end + 10);
+  const auto directory_offset = Read32(archive, end + 16);
+  if (count == 0xffff || directory_offset == 0xffffffff) {
+    throw ZipError("Zip64 archives are not supported");
+  }
+
+  std::vector<ZipEntry> entries;
+  entries.reserve(count);
+  size_t pos = directory_offset;
+  for (size_t i = 0; i < count; ++i) {
+    if (Read32(archive, pos) != kCentralHeaderSignature) {
+      throw ZipError("Central directory is malformed");
+    }
+    const auto flags = Read16(archive, pos + 8);
+    if (flags & kEncryptedFlag) {
+      throw ZipError("Encrypted entries are not supported");
+    }
+
+    ZipEntry entry;
+    entry.method = Read16(archive, pos + 10);
+    entry.time = Read16(archive, pos + 12);
+    entry.date = Read16(archive, pos + 14);
+    entry.crc32 = Read32(archive, pos + 16);
+    const auto compressed_size = Read32(archive, pos + 20);
+    entry.size = Read32(archive, pos + 24);
+    const auto name_size = Read16(archive, pos + 28);
+    const auto extra_size = Read16(archive, pos + 30);
+    const auto comment_size = Read16(archive, pos + 32);
+    const auto local_offset = Read32(archive, pos + 42);
+    entry.name = Slice(archive, pos + kCentralHeaderSize, name_size);
+    pos += kCentralHeaderSize + name_size + extra_size + comment_size;
+
+    if (Read32(archive, local_offset) != kLocalHeaderSignature) {
+      throw ZipError("Local header of " + entry.name + " is malformed");
+    }
+    const auto data_offset = local_offset + kLocalHeaderSize +
+                             Read16(archive, local_offset + 26) +
+                             Read16(archive, local_offset + 28);
+    entry.data = Slice(archive, data_offset, compressed_size);
+    entries.push_back(std::move(entry));
+  }
+  return entries;
+}
+
+std::string Extract(const ZipEntry& entry) {
+  std::string content;
+  if (entry.method == kStored) {
+    content = entry.data;
+  } else if (entry.method == kDeflated) {
+    content.resize(entry.size);
+    z_stream stream{};
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+      throw ZipError("Failed to start inflating " + entry.name);
+    }
+    stream.next_in =
+        reinterpret_cast<Bytef*>(const_cast<char*>(entry.data.data()));
+    stream.avail_in = static_cast<uInt>(entry.data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(content.data());
+    stream.avail_out = static_cast<uInt>(content.size());
+    const auto status = inflate(&stream, Z_FINISH);
+    const auto inflated = stream.total_out;
+    inflateEnd(&stream);
+    if (status != Z_STREAM_END || inflated != entry.size) {
+      throw ZipError("Failed to inflate " + entry.name);
+    }
+  } else {
+    throw ZipError("Compression method of " + entry.name +
+                   " is not supported");
+  }
+
+  if (Crc32(content) != entry.crc32) {
+    throw ZipError("Checksum of " + entry.name + " does not match");
+  }
+  return content;
+}
+
+void ZipWriter::AddCompressed(const ZipEntry& entry) {
+  Add({entry.name, entry.method, entry.time, entry.date, entry.crc32,
+       CheckedSize(entry.data.size()), entry.size, 0},
+      entry.data);
+}
+
+void ZipWriter::AddDeflated(std::string_view name, std::string_view content,
+                            uint16_t time, uint16_t date) {
+  z_stream stream{};
+  if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw ZipError("Failed to start deflating " + std::string(name));
+  }
+  std::string compressed(deflateBound(&stream, content.size()), '\0');
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(content.data()));
+  stream.avail_in = static_cast<uInt>(content.size());
+  stream.next_out = reinterpret_cast<Bytef*>(compressed.data());
+  stream.avail_out = static_cast<uInt>(compressed.size());
+  const auto status = deflate(&stream, Z_FINISH);
+  compressed.resize(stream.total_out);
+  deflateEnd(&stream);
+  if (status != Z_STREAM_END) {
+    throw ZipError("Failed to deflate " + std::string(name));
+  }
+
+  Add({std::string(name), kDeflated, time, date, Crc32(content),
+       CheckedSize(compressed.size()), CheckedSize(content.size()), 0},
+      compressed);
+}
+
+void ZipWriter::Add(Record record, std::string_view data) {
+  record.offset = CheckedSize(archive_.size());
+  Write32(archive_, kLocalHeaderSignature);
+  Write16(archive_, kVersionNeeded);
+  Write16(archive_, kUtf8NameFlag);
+  Write16(archive_, record.method);
+  Write16(archive_, record.time);
+  Write16(archive_, record.date);
+  Write32(archive_, record.crc32);
+  Write32(archive_, record.compressed_size);
+  Write32(archive_, record.size);
+  Write16(archive_, static_cast<uint16_t>(record.name.size()));
+  Write16(archive_, 0);
+  archive_.append(record.name);
+  archive_.append(data);
+  records_.push_back(std::move(record));
+}
+
+std::string ZipWriter::Finish() && {
+  const auto directory_offset = CheckedSize(archive_.size());
+  for (const auto& record : records_) {
+    Write32(archive_, kCentralHeaderSignature);
+    Write16(archive_, kVersionNeeded);
+    Write16(archive_, kVersionNeeded);
+    Write16(archive_, kUtf8NameFlag);
+    Write16(archive_, record.method);
+    Write16(archive_, record.time);
+    Write16(archive_, record.date);
+    Write32(archive_, record.crc32);
+    Write32(archive_, record.compressed_size);
+    Write32(archive_, record.size);
+    Write16(archive_, static_cast<uint16_t>(record.name.size()));
+    Write16(archive_, 0);
+    Write16(archive_, 0);
+    Write16(archive_, 0);
+    Write16(archive_, 0);
+    Write32(archive_, 0);
+    Write32(archive_, record.offset);
+    archive_.append(record.name);
+  }
+  const auto directory_size =
+      CheckedSize(archive_.size() - directory_offset);
+
+  Write32(archive_, kEndOfDirectorySignature);
+  Write16(archive_, 0);
+  Write16(archive_, 0);
+  Write16(archive_, static_cast<uint16_t>(records_.size()));
+  Write16(archive_, static_cast<uint16_t>(records_.size()));
+  Write32(archive_, directory_size);
+  Write32(archive_, directory_offset);
+  Write16(archive_, 0);
+  return std::move(archive_);
+}
+
+}  // namespace core::docx_template
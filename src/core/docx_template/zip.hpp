@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace core::docx_template {
+
+class ZipError : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+inline constexpr uint16_t kStored = 0;
+inline constexpr uint16_t kDeflated = 8;
+
+// Entry of an archive as it is stored, `data` is the compressed content and
+// points into the archive
+struct ZipEntry {
+  std::string name;
+  uint16_t method;
+  uint16_t time, date;
+  uint32_t crc32;
+  uint32_t size;
+  std::string_view data;
+};
+
+// Entries listed in the central directory of `archive`. Encrypted entries
+// and zip64 archives are not supported.
+std::vector<ZipEntry> ReadZip(std::string_view archive);
+
+// Uncompressed content of the entry, checked against its crc
+std::string Extract(const ZipEntry& entry);
+
+// Builds an archive in memory. A copy of a writer shares nothing with the
+// original, so a prefix of entries can be written once and completed many
+// times.
+class ZipWriter {
+ public:
+  // Adds the entry of another archive without recompressing it
+  void AddCompressed(const ZipEntry& entry);
+
+  void AddDeflated(std::string_view name, std::string_view content,
+                   uint16_t time = 0, uint16_t date = kMinDate);
+
+  std::string Finish() &&;
+
+ private:
+  // 1980-01-01, the earliest date of the format
+  static constexpr uint16_t kMinDate = (1 << 5) | 1;
+
+  struct Record {
+    std::string name;
+    uint16_t method, time, date;
+    uint32_t crc32, compressed_size, size, offset;
+  };
+
+  void Add(Record record, std::string_view data);
+
+  std::string archive_;
+  std::vector<Record> records_;
+};
+
+}  // namespace core::docx_template
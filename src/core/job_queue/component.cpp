@@ -0,0 +1,277 @@
+#include "component.hpp"
+
+#include <mutex>
+
+#include <userver/logging/log.hpp>
+#include <userver/storages/postgres/component.hpp>
+#include <userver/storages/postgres/io/array_types.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/uuid4.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include "retry.hpp"
+
+namespace core::job_queue {
+
+namespace {
+
+// A running job whose run_after has passed lost its worker. It is claimed
+// again while it has attempts left, otherwise the same statement marks it
+// as failed so that it does not stay running forever
+const userver::storages::postgres::Query kClaimJob{
+    "WITH expired AS ("
+    "UPDATE wd_general.jobs "
+    "SET status = 'failed', "
+    "error = COALESCE(error, 'Worker lost on the last attempt'), "
+    "updated = NOW() "
+    "WHERE kind = ANY($1) AND status = 'running' "
+    "AND run_after <= NOW() AND attempts >= $3) "
+    "UPDATE wd_general.jobs "
+    "SET status = 'running', attempts = attempts + 1, "
+    "run_after = NOW() + $2 * INTERVAL '1 millisecond', updated = NOW() "
+    "WHERE id = ("
+    "SELECT id FROM wd_general.jobs "
+    "WHERE kind = ANY($1) AND status IN ('pending', 'running') "
+    "AND run_after <= NOW() AND attempts < $3 "
+    "ORDER BY run_after "
+    "LIMIT 1 "
+    "FOR UPDATE SKIP LOCKED) "
+    "RETURNING id, kind, company_id, subject_id, attempts",
+    userver::storages::postgres::Query::Name{"job_queue_claim"}};
+
+// The completion, failure and postponement only apply to the run that
+// claimed the job: once the lease is lost and the job is claimed again, its
+// attempts no longer match
+const userver::storages::postgres::Query kCompleteJob{
+    "UPDATE wd_general.jobs "
+    "SET status = 'done', error = NULL, updated = NOW() "
+    "WHERE id = $1 AND status = 'running' AND attempts = $2",
+    userver::storages::postgres::Query::Name{"job_queue_complete"}};
+
+const userver::storages::postgres::Query kFailJob{
+    "UPDATE wd_general.jobs "
+    "SET status = CASE WHEN attempts >= $2 THEN 'failed' ELSE 'pending' END, "
+    "run_after = NOW() + $3 * INTERVAL '1 millisecond', error = $4, "
+    "updated = NOW() "
+    "WHERE id = $1 AND status = 'running' AND attempts = $5",
+    userver::storages::postgres::Query::Name{"job_queue_fail"}};
+
+// Gives back the attempt taken by the claim
+const userver::storages::postgres::Query kPostponeJob{
+    "UPDATE wd_general.jobs "
+    "SET status = 'pending', attempts = attempts - 1, "
+    "run_after = NOW() + $2 * INTERVAL '1 millisecond', error = $3, "
+    "updated = NOW() "
+    "WHERE id = $1 AND status = 'running' AND attempts = $4",
+    userver::storages::postgres::Query::Name{"job_queue_postpone"}};
+
+// A finished or failed job of the subject is run again from scratch, a
+// pending or running one is left as it is
+const userver::storages::postgres::Query kInsertJob{
+    "INSERT INTO wd_general.jobs (id, kind, company_id, subject_id) "
+    "VALUES ($1, $2, $3, $4) "
+    "ON CONFLICT (kind, company_id, subject_id) DO UPDATE "
+    "SET status = 'pending', attempts = 0, run_after = NOW(), error = NULL, "
+    "updated = NOW() "
+    "WHERE jobs.status IN ('done', 'failed')",
+    userver::storages::postgres::Query::Name{"job_queue_insert"}};
+
+const userver::storages::postgres::Query kSelectStatus{
+    "SELECT id, status, attempts, error "
+    "FROM wd_general.jobs "
+    "WHERE kind = $1 AND company_id = $2 AND subject_id = $3",
+    userver::storages::postgres::Query::Name{"job_queue_status"}};
+
+void LogLostLease(const Job& job, std::string_view outcome) {
+  LOG_WARNING() << "Job " << job.kind << " " << job.id << " lost its lease "
+                << "on attempt " << job.attempts << ", its " << outcome
+                << " is dropped";
+}
+
+}  // namespace
+
+JobQueue::JobQueue(const userver::components::ComponentConfig& config,
+                   const userver::components::ComponentContext& context)
+    : LoggableComponentBase(config, context),
+      pg_cluster_(
+          context.FindComponent<userver::components::Postgres>("key-value")
+              .GetCluster()),
+      workers_count_(config["workers"].As<size_t>()),
+      poll_interval_(config["poll-interval"].As<std::chrono::milliseconds>()),
+      lease_(config["lease"].As<std::chrono::milliseconds>()),
+      max_attempts_(config["max-attempts"].As<int>()),
+      retry_delay_(config["retry-delay"].As<std::chrono::milliseconds>()),
+      max_retry_delay_(
+          config["max-retry-delay"].As<std::chrono::milliseconds>()) {}
+
+void JobQueue::RegisterHandler(std::string kind, Handler handler) {
+  kinds_.push_back(kind);
+  handlers_.emplace(std::move(kind), std::move(handler));
+}
+
+void JobQueue::Enqueue(userver::storages::postgres::Transaction& trx,
+                       std::string_view kind, std::string_view company_id,
+                       std::string_view subject_id) const {
+  trx.Execute(kInsertJob, userver::utils::generators::GenerateUuid(), kind,
+              company_id, subject_id);
+}
+
+void JobQueue::Notify() {
+  {
+    std::lock_guard lock(mutex_);
+    ++pending_wakeups_;
+  }
+  wakeup_.NotifyOne();
+}
+
+std::optional<JobStatus> JobQueue::GetStatus(
+    std::string_view kind, std::string_view company_id,
+    std::string_view subject_id) const {
+  auto result = pg_cluster_->Execute(
+      userver::storages::postgres::ClusterHostType::kMaster, kSelectStatus,
+      kind, company_id, subject_id);
+  if (result.IsEmpty()) {
+    return std::nullopt;
+  }
+  return result.AsSingleRow<JobStatus>(userver::storages::postgres::kRowTag);
+}
+
+void JobQueue::OnAllComponentsLoaded() {
+  if (handlers_.empty()) {
+    return;
+  }
+  workers_.reserve(workers_count_);
+  for (size_t i = 0; i < workers_count_; ++i) {
+    workers_.push_back(
+        userver::utils::CriticalAsync("job-queue-worker", [this] {
+          RunWorker();
+        }));
+  }
+}
+
+void JobQueue::OnAllComponentsAreStopping() {
+  // Handlers belong to other components, so the jobs in flight are finished
+  // before any of them is destroyed
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  wakeup_.NotifyAll();
+  for (auto& worker : workers_) {
+    worker.Get();
+  }
+  workers_.clear();
+}
+
+void JobQueue::RunWorker() {
+  while (true) {
+    std::optional<Job> job;
+    try {
+      job = Claim();
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Failed to claim a job: " << ex;
+    }
+
+    if (job.has_value()) {
+      Run(*job);
+    } else if (!WaitForJobs()) {
+      return;
+    }
+  }
+}
+
+std::optional<Job> JobQueue::Claim() const {
+  auto result = pg_cluster_->Execute(
+      userver::storages::postgres::ClusterHostType::kMaster, kClaimJob, kinds_,
+      static_cast<int64_t>(lease_.count()), max_attempts_);
+  if (result.IsEmpty()) {
+    return std::nullopt;
+  }
+  return result.AsSingleRow<Job>(userver::storages::postgres::kRowTag);
+}
+
+void JobQueue::Run(const Job& job) const {
+  try {
+    handlers_.at(job.kind)(job);
+    const auto result = pg_cluster_->Execute(
+        userver::storages::postgres::ClusterHostType::kMaster, kCompleteJob,
+        job.id, job.attempts);
+    if (result.RowsAffected() == 0) {
+      LogLostLease(job, "completion");
+    }
+    return;
+  } catch (const RetryLater& ex) {
+    LOG_INFO() << "Job " << job.kind << " " << job.id << " is postponed for "
+               << ex.Delay().count() << "ms: " << ex.what();
+    try {
+      const auto result = pg_cluster_->Execute(
+          userver::storages::postgres::ClusterHostType::kMaster, kPostponeJob,
+          job.id, static_cast<int64_t>(ex.Delay().count()),
+          std::string(ex.what()), job.attempts);
+      if (result.RowsAffected() == 0) {
+        LogLostLease(job, "postponement");
+      }
+    } catch (const std::exception& postpone_ex) {
+      LOG_ERROR() << "Failed to postpone job " << job.id << ": "
+                  << postpone_ex;
+    }
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Job " << job.kind << " " << job.id << " failed on "
+                  << "attempt " << job.attempts << ": " << ex;
+    try {
+      const auto delay =
+          RetryDelay(job.attempts, retry_delay_, max_retry_delay_);
+      const auto result = pg_cluster_->Execute(
+          userver::storages::postgres::ClusterHostType::kMaster, kFailJob,
+          job.id, max_attempts_, static_cast<int64_t>(delay.count()),
+          std::string(ex.what()), job.attempts);
+      if (result.RowsAffected() == 0) {
+        LogLostLease(job, "failure");
+      }
+    } catch (const std::exception& fail_ex) {
+      // The lease runs out and the job is claimed again
+      LOG_ERROR() << "Failed to record the failure of job " << job.id << ": "
+                  << fail_ex;
+    }
+  }
+}
+
+bool JobQueue::WaitForJobs() {
+  std::unique_lock lock(mutex_);
+  wakeup_.WaitFor(lock, poll_interval_,
+                  [this] { return stopping_ || pending_wakeups_ != 0; });
+  if (pending_wakeups_ != 0) {
+    --pending_wakeups_;
+  }
+  return !stopping_;
+}
+
+userver::yaml_config::Schema JobQueue::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::LoggableComponentBase>(R"(
+type: object
+description: Database backed queue of background jobs
+additionalProperties: false
+properties:
+    workers:
+        type: integer
+        description: how many jobs an instance runs at once
+    poll-interval:
+        type: string
+        description: how often an idle worker looks for due jobs
+    lease:
+        type: string
+        description: how long a claimed job is kept from other workers
+    max-attempts:
+        type: integer
+        description: runs of a job before it is marked as failed
+    retry-delay:
+        type: string
+        description: delay before the first retry, doubled for every next one
+    max-retry-delay:
+        type: string
+        description: upper bound of the delay between retries
+)");
+}
+
+}  // namespace core::job_queue
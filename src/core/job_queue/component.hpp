@@ -0,0 +1,105 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/transaction.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+#include "retry.hpp"
+
+namespace core::job_queue {
+
+struct Job {
+  std::string id, kind, company_id, subject_id;
+  int attempts;
+};
+
+struct JobStatus {
+  std::string id, status;
+  int attempts;
+  std::optional<std::string> error;
+};
+
+// Jobs are rows of wd_general.jobs, so they survive restarts and are shared
+// by all instances. A fixed number of workers per instance claim due jobs
+// with SKIP LOCKED and run the handler registered for their kind. A failed
+// job is retried with exponential backoff up to max-attempts times, a job
+// whose worker died is claimed again once its lease runs out, or marked as
+// failed if that was its last attempt. The outcome of a run is only recorded
+// while the job is still running under the attempt it was claimed with, so
+// a worker that outlived its lease cannot overwrite the run that replaced
+// it. A handler throws RetryLater to put its job back without using up an
+// attempt.
+class JobQueue final : public userver::components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName = "job-queue";
+
+  using Handler = std::function<void(const Job&)>;
+
+  JobQueue(const userver::components::ComponentConfig& config,
+           const userver::components::ComponentContext& context);
+
+  // Must be called from the constructor of a component, workers only run
+  // the kinds registered before all components are loaded
+  void RegisterHandler(std::string kind, Handler handler);
+
+  // Adds the job within the caller's transaction. A pending or running job
+  // of the same kind and subject is kept, a done or failed one is reset and
+  // runs again under its id
+  void Enqueue(userver::storages::postgres::Transaction& trx,
+               std::string_view kind, std::string_view company_id,
+               std::string_view subject_id) const;
+
+  // Wakes a worker of this instance, call it once the enqueuing transaction
+  // is committed
+  void Notify();
+
+  std::optional<JobStatus> GetStatus(std::string_view kind,
+                                     std::string_view company_id,
+                                     std::string_view subject_id) const;
+
+  void OnAllComponentsLoaded() override;
+
+  void OnAllComponentsAreStopping() override;
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  void RunWorker();
+  std::optional<Job> Claim() const;
+  void Run(const Job& job) const;
+  bool WaitForJobs();
+
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+  const size_t workers_count_;
+  const std::chrono::milliseconds poll_interval_;
+  const std::chrono::milliseconds lease_;
+  const int max_attempts_;
+  const std::chrono::milliseconds retry_delay_;
+  const std::chrono::milliseconds max_retry_delay_;
+
+  std::unordered_map<std::string, Handler> handlers_;
+  std::vector<std::string> kinds_;
+
+  userver::engine::Mutex mutex_;
+  userver::engine::ConditionVariable wakeup_;
+  size_t pending_wakeups_ = 0;
+  bool stopping_ = false;
+
+  std::vector<userver::engine::TaskWithResult<void>> workers_;
+};
+
+}  // namespace core::job_queue
@@ -0,0 +1,29 @@
+#include "retry.hpp"
+
+#include <algorithm>
+#include <charconv>
+
+namespace core::job_queue {
+
+std::chrono::milliseconds RetryDelay(int attempts,
+                                     std::chrono::milliseconds base,
+                                     std::chrono::milliseconds max) {
+  auto delay = base;
+  for (int i = 1; i < attempts && delay < max; ++i) {
+    delay *= 2;
+  }
+  return std::min(delay, max);
+}
+
+std::chrono::milliseconds ParseRetryAfter(
+    std::string_view header, std::chrono::milliseconds fallback) {
+  int seconds = 0;
+  const auto* end = header.data() + header.size();
+  const auto [ptr, ec] = std::from_chars(header.data(), end, seconds);
+  if (header.empty() || ec != std::errc{} || ptr != end || seconds < 0) {
+    return fallback;
+  }
+  return std::chrono::seconds{seconds};
+}
+
+}  // namespace core::job_queue
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace core::job_queue {
+
+// Delay before the next run of a job that failed `attempts` times: `base`
+// doubled after every failed attempt, never more than `max`
+std::chrono::milliseconds RetryDelay(int attempts,
+                                     std::chrono::milliseconds base,
+                                     std::chrono::milliseconds max);
+
+// Thrown by a job handler when the job can not run yet, e.g. the service it
+// calls is saturated. The job runs again after `delay` and the attempt is
+// not counted against max-attempts.
+class RetryLater : public std::runtime_error {
+ public:
+  RetryLater(const std::string& what, std::chrono::milliseconds delay)
+      : std::runtime_error(what), delay_(delay) {}
+
+  std::chrono::milliseconds Delay() const { return delay_; }
+
+ private:
+  std::chrono::milliseconds delay_;
+};
+
+// Delay of a Retry-After header given in seconds, `fallback` if the header
+// is missing or is not a number of seconds
+std::chrono::milliseconds ParseRetryAfter(std::string_view header,
+                                          std::chrono::milliseconds fallback);
+
+}  // namespace core::job_queue
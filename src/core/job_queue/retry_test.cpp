@@ -0,0 +1,42 @@
+#include "retry.hpp"
+
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+using std::chrono::milliseconds;
+using std::chrono::minutes;
+using std::chrono::seconds;
+
+}  // namespace
+
+UTEST(JobQueueRetry, Doubles) {
+  EXPECT_EQ(core::job_queue::RetryDelay(1, seconds{10}, minutes{10}),
+            seconds{10});
+  EXPECT_EQ(core::job_queue::RetryDelay(2, seconds{10}, minutes{10}),
+            seconds{20});
+  EXPECT_EQ(core::job_queue::RetryDelay(4, seconds{10}, minutes{10}),
+            seconds{80});
+}
+
+UTEST(JobQueueRetry, Capped) {
+  EXPECT_EQ(core::job_queue::RetryDelay(7, seconds{10}, minutes{10}),
+            minutes{10});
+  EXPECT_EQ(core::job_queue::RetryDelay(1000, seconds{10}, minutes{10}),
+            minutes{10});
+  EXPECT_EQ(core::job_queue::RetryDelay(1, minutes{20}, minutes{10}),
+            minutes{10});
+  EXPECT_EQ(core::job_queue::RetryDelay(0, milliseconds{100}, minutes{10}),
+            milliseconds{100});
+}
+
+UTEST(JobQueueRetry, RetryAfter) {
+  EXPECT_EQ(core::job_queue::ParseRetryAfter("5", seconds{1}), seconds{5});
+  EXPECT_EQ(core::job_queue::ParseRetryAfter("0", seconds{1}), seconds{0});
+  EXPECT_EQ(core::job_queue::ParseRetryAfter("", seconds{1}), seconds{1});
+  EXPECT_EQ(core::job_queue::ParseRetryAfter("-3", seconds{1}), seconds{1});
+  EXPECT_EQ(core::job_queue::ParseRetryAfter("5s", seconds{1}), seconds{1});
+  EXPECT_EQ(core::job_queue::ParseRetryAfter(
+                "Wed, 21 Oct 2015 07:28:00 GMT", seconds{1}),
+            seconds{1});
+}
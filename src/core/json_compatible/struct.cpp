@@ -1,27 +1,387 @@
 #include "struct.hpp"
 
-#include <optional>
-#include <vector>
+#include <cmath>
+#include <cstdint>
 
-#include <nlohmann/json.hpp>
+namespace detail {
 
-void JsonCompatible::ParseRegisteredFields(const std::string& body) {
-  if (body.empty()) {
-    return;
+namespace {
+
+constexpr char kHexDigits[] = "0123456789abcdef";
+
+bool IsWhitespace(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+int HexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+// Raw control characters are not allowed in strings, the rest has to be
+// well-formed UTF-8: no overlong forms, surrogates or code points past
+// U+10FFFF
+bool IsValidStringRun(std::string_view run) {
+  size_t i = 0;
+  while (i < run.size()) {
+    const auto c = static_cast<unsigned char>(run[i]);
+    if (c < 0x80) {
+      if (c < 0x20) {
+        return false;
+      }
+      ++i;
+      continue;
+    }
+
+    size_t length = 0;
+    uint32_t code_point = 0;
+    uint32_t min_code_point = 0;
+    if ((c & 0xE0) == 0xC0) {
+      length = 2;
+      code_point = c & 0x1F;
+      min_code_point = 0x80;
+    } else if ((c & 0xF0) == 0xE0) {
+      length = 3;
+      code_point = c & 0x0F;
+      min_code_point = 0x800;
+    } else if ((c & 0xF8) == 0xF0) {
+      length = 4;
+      code_point = c & 0x07;
+      min_code_point = 0x10000;
+    } else {
+      return false;
+    }
+    if (i + length > run.size()) {
+      return false;
+    }
+    for (size_t j = 1; j < length; ++j) {
+      const auto next = static_cast<unsigned char>(run[i + j]);
+      if ((next & 0xC0) != 0x80) {
+        return false;
+      }
+      code_point = (code_point << 6) | (next & 0x3F);
+    }
+    if (code_point < min_code_point || code_point > 0x10FFFF ||
+        (code_point >= 0xD800 && code_point < 0xE000)) {
+      return false;
+    }
+    i += length;
+  }
+  return true;
+}
+
+void AppendUtf8(std::string& result, uint32_t code_point) {
+  if (code_point < 0x80) {
+    result += static_cast<char>(code_point);
+  } else if (code_point < 0x800) {
+    result += static_cast<char>(0xC0 | (code_point >> 6));
+    result += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else if (code_point < 0x10000) {
+    result += static_cast<char>(0xE0 | (code_point >> 12));
+    result += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    result += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else {
+    result += static_cast<char>(0xF0 | (code_point >> 18));
+    result += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+    result += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    result += static_cast<char>(0x80 | (code_point & 0x3F));
+  }
+}
+
+}  // namespace
+
+void JsonReader::ReadString(std::string& result) {
+  Expect('"');
+  result.clear();
+  while (true) {
+    // Copy the unescaped run at once
+    const auto end = input_.find_first_of("\"\\", pos_);
+    if (end == std::string_view::npos) {
+      Fail("unterminated string");
+    }
+    const auto run = input_.substr(pos_, end - pos_);
+    if (!IsValidStringRun(run)) {
+      Fail("invalid character in string");
+    }
+    result.append(run);
+    pos_ = end + 1;
+    if (input_[end] == '"') {
+      return;
+    }
+    AppendEscape(result);
+  }
+}
+
+std::string_view JsonReader::ReadKey() {
+  Expect('"');
+  const auto end = input_.find_first_of("\"\\", pos_);
+  if (end != std::string_view::npos && input_[end] == '"') {
+    const auto key = input_.substr(pos_, end - pos_);
+    if (!IsValidStringRun(key)) {
+      Fail("invalid character in string");
+    }
+    pos_ = end + 1;
+    return key;
+  }
+  --pos_;
+  ReadString(buffer_);
+  return buffer_;
+}
+
+void JsonReader::AppendEscape(std::string& result) {
+  if (pos_ >= input_.size()) {
+    Fail("unterminated string");
+  }
+  const char escaped = input_[pos_++];
+  switch (escaped) {
+    case '"':
+    case '\\':
+    case '/':
+      result += escaped;
+      return;
+    case 'b':
+      result += '\b';
+      return;
+    case 'f':
+      result += '\f';
+      return;
+    case 'n':
+      result += '\n';
+      return;
+    case 'r':
+      result += '\r';
+      return;
+    case 't':
+      result += '\t';
+      return;
+    case 'u':
+      break;
+    default:
+      Fail("invalid escape");
+  }
+
+  const auto read_code_unit = [this] {
+    if (pos_ + 4 > input_.size()) {
+      Fail("invalid unicode escape");
+    }
+    uint32_t code_unit = 0;
+    for (size_t i = 0; i < 4; ++i) {
+      const int digit = HexValue(input_[pos_++]);
+      if (digit < 0) {
+        Fail("invalid unicode escape");
+      }
+      code_unit = (code_unit << 4) | digit;
+    }
+    return code_unit;
+  };
+
+  uint32_t code_point = read_code_unit();
+  if (code_point >= 0xD800 && code_point < 0xDC00) {
+    if (input_.substr(pos_, 2) != "\\u") {
+      Fail("unpaired surrogate");
+    }
+    pos_ += 2;
+    const uint32_t low = read_code_unit();
+    if (low < 0xDC00 || low >= 0xE000) {
+      Fail("unpaired surrogate");
+    }
+    code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+  } else if (code_point >= 0xDC00 && code_point < 0xE000) {
+    Fail("unpaired surrogate");
+  }
+  AppendUtf8(result, code_point);
+}
+
+bool JsonReader::ReadBool() {
+  SkipWhitespace();
+  if (input_.substr(pos_, 4) == "true") {
+    pos_ += 4;
+    return true;
+  }
+  if (input_.substr(pos_, 5) == "false") {
+    pos_ += 5;
+    return false;
+  }
+  Fail("expected boolean");
+}
+
+std::string_view JsonReader::ReadNumber() {
+  SkipWhitespace();
+  const size_t begin = pos_;
+  if (pos_ < input_.size() && input_[pos_] == '-') {
+    ++pos_;
+  }
+  const size_t digits = pos_;
+  while (pos_ < input_.size() &&
+         (IsDigit(input_[pos_]) || input_[pos_] == '.' ||
+          input_[pos_] == 'e' || input_[pos_] == 'E' || input_[pos_] == '+' ||
+          input_[pos_] == '-')) {
+    ++pos_;
+  }
+  if (pos_ == digits || !IsDigit(input_[digits])) {
+    Fail("expected number");
+  }
+  return input_.substr(begin, pos_ - begin);
+}
+
+double JsonReader::ParseDouble(std::string_view token) const {
+  double value = 0;
+  const auto result =
+      std::from_chars(token.data(), token.data() + token.size(), value);
+  if (result.ec != std::errc{} || result.ptr != token.data() + token.size()) {
+    Fail("invalid number");
+  }
+  return value;
+}
+
+bool JsonReader::TryReadNull() {
+  SkipWhitespace();
+  if (input_.substr(pos_, 4) == "null") {
+    pos_ += 4;
+    return true;
   }
-  auto json = nlohmann::json::parse(body);
-  for (auto& lambda : lambdas_parse_) {
-    lambda(json);
+  return false;
+}
+
+void JsonReader::SkipValue() {
+  switch (Peek()) {
+    case '{':
+      ReadObject([this](std::string_view) { SkipValue(); });
+      return;
+    case '[':
+      ReadArray([this] { SkipValue(); });
+      return;
+    case '"':
+      ReadKey();
+      return;
+    case 't':
+    case 'f':
+      ReadBool();
+      return;
+    case 'n':
+      if (!TryReadNull()) {
+        Fail("expected null");
+      }
+      return;
+    default:
+      ReadNumber();
   }
 }
 
-nlohmann::json JsonCompatible::ToJson() const {
-  nlohmann::json json;
-  for (auto& lambda : lambdas_dump_) {
-    lambda(json);
+void JsonReader::ExpectEnd() {
+  SkipWhitespace();
+  if (pos_ != input_.size()) {
+    Fail("unexpected trailing characters");
   }
+}
+
+void JsonReader::Fail(std::string_view message) const {
+  throw std::runtime_error("JSON parse error at " + std::to_string(pos_) +
+                           ": " + std::string(message));
+}
 
-  return json;
+void JsonReader::SkipWhitespace() {
+  while (pos_ < input_.size() && IsWhitespace(input_[pos_])) {
+    ++pos_;
+  }
+}
+
+char JsonReader::Peek() {
+  SkipWhitespace();
+  if (pos_ >= input_.size()) {
+    Fail("unexpected end of input");
+  }
+  return input_[pos_];
 }
 
-std::string JsonCompatible::ToJsonString() const { return ToJson().dump(); }
+void JsonReader::Expect(char c) {
+  if (Peek() != c) {
+    Fail(std::string("expected '") + c + "'");
+  }
+  ++pos_;
+}
+
+void WriteJsonString(std::string& out, std::string_view value) {
+  out += '"';
+  size_t begin = 0;
+  for (size_t i = 0; i < value.size(); ++i) {
+    const auto c = static_cast<unsigned char>(value[i]);
+    if (c >= 0x20 && c != '"' && c != '\\') {
+      continue;
+    }
+    out.append(value.substr(begin, i - begin));
+    begin = i + 1;
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\b':
+        out += "\\b";
+        break;
+      case '\f':
+        out += "\\f";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        out += "\\u00";
+        out += kHexDigits[c >> 4];
+        out += kHexDigits[c & 0xF];
+    }
+  }
+  out.append(value.substr(begin));
+  out += '"';
+}
+
+void WriteJsonKey(std::string& out, std::string_view key, bool& first) {
+  if (!first) {
+    out += ',';
+  }
+  first = false;
+  out += '"';
+  out += key;
+  out += "\":";
+}
+
+void WriteJsonDouble(std::string& out, double value) {
+  if (!std::isfinite(value)) {
+    out += "null";
+    return;
+  }
+  char buffer[32];
+  const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  out.append(buffer, result.ptr);
+}
+
+}  // namespace detail
+
+JsonListWriter::JsonListWriter(std::string_view key) {
+  out_ += "{\"";
+  out_ += key;
+  out_ += "\":[";
+}
+
+std::string JsonListWriter::Finish() && {
+  out_ += "]}";
+  return std::move(out_);
+}
@@ -1,238 +1,456 @@
 #pragma once
 
+#include <charconv>
+#include <cmath>
 #include <concepts>
-#include <memory>
+#include <cstdint>
+#include <limits>
 #include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <userver/storages/postgres/io/chrono.hpp>
 #include <userver/utils/datetime.hpp>
 
-#include <nlohmann/json.hpp>
+// Fields registered with REGISTER_STRUCT_FIELD are described at compile time:
+// every field declares a descriptor type and JSON_FIELDS lists the
+// descriptors of the struct in the order of the keys. A registered field
+// that is missing from the list, or listed twice, fails the build. Parsing
+// and dumping walk the descriptors of the bases and then of the struct itself
+// and stream straight between the bytes and the struct, objects carry no
+// state of their own.
 
-class JsonCompatible {
+namespace detail {
+
+class JsonRoot {};
+
+}  // namespace detail
+
+template <class Self, class Base = detail::JsonRoot>
+class JsonCompatible : public Base {
  public:
-  JsonCompatible() = default;
+  using JsonBase = Base;
+  // Structs without registered fields may omit JSON_FIELDS
+  using JsonFields = std::tuple<>;
 
-  JsonCompatible(const JsonCompatible&) { JsonCompatible(); }
+  void ParseRegisteredFields(std::string_view body);
 
-  JsonCompatible& operator=(const JsonCompatible&) { return *this; }
+  std::string ToJsonString() const;
+};
 
-  JsonCompatible(JsonCompatible&&) { JsonCompatible(); }
+namespace detail {
 
-  JsonCompatible& operator=(JsonCompatible&&) { return *this; }
+template <class T>
+concept DerivedFromJsonCompatible = std::is_base_of_v<JsonRoot, T>;
 
-  void ParseRegisteredFields(const std::string& body);
+template <class T>
+struct AllJsonFieldsOf {
+  using Type = decltype(std::tuple_cat(
+      std::declval<typename AllJsonFieldsOf<typename T::JsonBase>::Type>(),
+      std::declval<typename T::JsonFields>()));
+};
 
-  template <class T>
-  void RegisterParsing(T* ptr, std::string parameter_name, bool mandatory);
+template <>
+struct AllJsonFieldsOf<JsonRoot> {
+  using Type = std::tuple<>;
+};
 
-  template <class T>
-  void RegisterDumping(T* ptr, std::string parameter_name, bool mandatory);
+template <DerivedFromJsonCompatible T>
+inline constexpr size_t kJsonFieldsCount =
+    std::tuple_size_v<typename AllJsonFieldsOf<T>::Type>;
 
-  nlohmann::json ToJson() const;
+template <class T, size_t I>
+using JsonFieldAt = std::tuple_element_t<I, typename AllJsonFieldsOf<T>::Type>;
 
-  std::string ToJsonString() const;
+template <class Field, class Fields>
+inline constexpr size_t kJsonFieldListings = 0;
+
+template <class Field, class... Fields>
+inline constexpr size_t kJsonFieldListings<Field, std::tuple<Fields...>> =
+    (size_t{std::is_same_v<Field, Fields>} + ... + 0);
+
+template <class T>
+struct IsOptional : std::false_type {};
+
+template <class T>
+struct IsOptional<std::optional<T>> : std::true_type {};
+
+// Pull parser over a JSON document, nothing is materialized besides the
+// values it is asked for
+class JsonReader {
+ public:
+  explicit JsonReader(std::string_view input) : input_(input) {}
+
+  // Calls on_key(key) for every key of the object, on_key must consume the
+  // value either by reading or by skipping it
+  template <class OnKey>
+  void ReadObject(OnKey&& on_key);
+
+  // Calls on_item() for every item of the array
+  template <class OnItem>
+  void ReadArray(OnItem&& on_item);
+
+  void ReadString(std::string& result);
+
+  bool ReadBool();
+
+  // Returns the raw number token
+  std::string_view ReadNumber();
+
+  double ParseDouble(std::string_view token) const;
+
+  // Consumes null and returns true if it is the next value
+  bool TryReadNull();
+
+  void SkipValue();
+
+  void ExpectEnd();
+
+  [[noreturn]] void Fail(std::string_view message) const;
 
  private:
-  std::vector<std::function<void(nlohmann::json&)>> lambdas_parse_;
-  std::vector<std::function<void(nlohmann::json&)>> lambdas_dump_;
+  void SkipWhitespace();
+
+  char Peek();
 
-  template <typename T>
-  struct is_std_optional : std::false_type {};
+  void Expect(char c);
 
-  template <typename T>
-  struct is_std_optional<std::optional<T>> : std::true_type {};
+  // Returns the key as is when it has no escapes, decodes it into buffer_
+  // otherwise
+  std::string_view ReadKey();
 
-  template <typename T>
-  inline static constexpr bool is_std_optional_v = is_std_optional<T>::value;
+  void AppendEscape(std::string& result);
+
+  std::string_view input_;
+  size_t pos_ = 0;
+  std::string buffer_;
 };
 
-namespace detail {
+void WriteJsonString(std::string& out, std::string_view value);
+
+void WriteJsonKey(std::string& out, std::string_view key, bool& first);
+
+void WriteJsonDouble(std::string& out, double value);
+
+// All the overloads are declared before the templates that use them, so that
+// the calls inside the templates see every one of them
+
+inline void Write(std::string& out, const std::string& value);
+inline void Write(std::string& out, bool value);
+inline void Write(std::string& out, double value);
+inline void Write(std::string& out,
+                  const userver::storages::postgres::TimePoint& value);
+template <std::integral T>
+void Write(std::string& out, T value);
+template <DerivedFromJsonCompatible T>
+void Write(std::string& out, const T& value);
+template <class T>
+void Write(std::string& out, const std::vector<T>& value);
 template <class T>
-inline void Parse(T* /*res*/, const nlohmann::json& /*json*/) {
-  throw std::runtime_error(
-      "Please provide parse specialization for requested type");
+void Write(std::string& out, const std::optional<T>& value);
+
+inline void Read(JsonReader& reader, std::string& value);
+inline void Read(JsonReader& reader, bool& value);
+inline void Read(JsonReader& reader, double& value);
+inline void Read(JsonReader& reader,
+                 userver::storages::postgres::TimePoint& value);
+template <std::integral T>
+void Read(JsonReader& reader, T& value);
+template <DerivedFromJsonCompatible T>
+void Read(JsonReader& reader, T& value);
+template <class T>
+void Read(JsonReader& reader, std::vector<T>& value);
+template <class T>
+void Read(JsonReader& reader, std::optional<T>& value);
+
+inline void Write(std::string& out, const std::string& value) {
+  WriteJsonString(out, value);
 }
 
-template <class T>
-inline void Dump(const T& /*field*/, const std::string& /*parameter_name*/,
-                 nlohmann::json& /*json*/) {
-  throw std::runtime_error(
-      "Please provide dump specialization for requested type: " +
-      std::string(typeid(T).name()));
+inline void Write(std::string& out, bool value) {
+  out += value ? "true" : "false";
 }
 
-template <>
-inline void Parse(bool* res, const nlohmann::json& json) {
-  *res = json.get<bool>();
+inline void Write(std::string& out, double value) {
+  WriteJsonDouble(out, value);
 }
 
-template <>
-inline void Parse(std::string* res, const nlohmann::json& json) {
-  *res = json.get<std::string>();
+inline void Write(std::string& out,
+                  const userver::storages::postgres::TimePoint& value) {
+  WriteJsonString(out, userver::utils::datetime::Timestring(
+                           value, "UTC", "%Y-%m-%dT%H:%M:%E6S"));
 }
 
-template <>
-inline void Parse(double* res, const nlohmann::json& json) {
-  *res = json.get<double>();
+template <std::integral T>
+void Write(std::string& out, T value) {
+  char buffer[24];
+  const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  out.append(buffer, result.ptr);
 }
 
-template <>
-inline void Parse(int64_t* res, const nlohmann::json& json) {
-  *res = json.get<int64_t>();
+template <class Field, class T>
+void WriteField(std::string& out, const T& value, bool& first) {
+  const auto& field = Field::Get(value);
+  if constexpr (IsOptional<std::decay_t<decltype(field)>>::value) {
+    if (!field.has_value()) {
+      if (Field::kMandatory) {
+        throw std::runtime_error("Missing mandatory field " +
+                                 std::string(Field::kKey));
+      }
+      return;
+    }
+  }
+  WriteJsonKey(out, Field::kKey, first);
+  Write(out, field);
 }
 
-template <>
-inline void Parse(int* res, const nlohmann::json& json) {
-  *res = json.get<int>();
+template <class T, size_t... I>
+void WriteFields(std::string& out, [[maybe_unused]] const T& value,
+                 std::index_sequence<I...>) {
+  [[maybe_unused]] bool first = true;
+  (WriteField<JsonFieldAt<T, I>>(out, value, first), ...);
 }
 
-template <>
-inline void Parse(uint64_t* res, const nlohmann::json& json) {
-  *res = json.get<uint64_t>();
+template <DerivedFromJsonCompatible T>
+void Write(std::string& out, const T& value) {
+  out += '{';
+  WriteFields(out, value, std::make_index_sequence<kJsonFieldsCount<T>>{});
+  out += '}';
 }
 
-template <>
-inline void Parse(uint32_t* res, const nlohmann::json& json) {
-  *res = json.get<uint32_t>();
+template <class T>
+void Write(std::string& out, const std::vector<T>& value) {
+  out += '[';
+  for (size_t i = 0; i < value.size(); ++i) {
+    if (i != 0) {
+      out += ',';
+    }
+    Write(out, value[i]);
+  }
+  out += ']';
 }
 
-template <>
-inline void Parse(std::vector<std::string>* res, const nlohmann::json& json) {
-  *res = json.get<std::vector<std::string>>();
+template <class T>
+void Write(std::string& out, const std::optional<T>& value) {
+  if (value.has_value()) {
+    Write(out, *value);
+  } else {
+    out += "null";
+  }
 }
 
-template <>
-inline void Parse(userver::storages::postgres::TimePoint* res,
-                  const nlohmann::json& json) {
-  *res = userver::utils::datetime::Stringtime(json.get<std::string>(), "UTC",
-                                              "%Y-%m-%dT%H:%M:%E6S");
-  ;
+inline void Read(JsonReader& reader, std::string& value) {
+  reader.ReadString(value);
 }
 
-template <typename T>
-concept DerivedFromJsonCompatible = std::is_base_of<JsonCompatible, T>::value;
+inline void Read(JsonReader& reader, bool& value) { value = reader.ReadBool(); }
 
-template <DerivedFromJsonCompatible T>
-inline void Parse(T* res, const nlohmann::json& json) {
-  res->ParseRegisteredFields(json.dump());
+inline void Read(JsonReader& reader, double& value) {
+  value = reader.ParseDouble(reader.ReadNumber());
 }
 
-template <DerivedFromJsonCompatible T>
-inline void Parse(std::vector<T>* res, const nlohmann::json& json) {
-  for (const auto& item : json) {
-    res->emplace_back().ParseRegisteredFields(item.dump());
-  }
+inline void Read(JsonReader& reader,
+                 userver::storages::postgres::TimePoint& value) {
+  std::string time;
+  reader.ReadString(time);
+  value = userver::utils::datetime::Stringtime(time, "UTC",
+                                               "%Y-%m-%dT%H:%M:%E6S");
 }
 
-template <class T>
-inline void Parse(std::optional<T>* res, const nlohmann::json& json) {
-  T temp;
-  Parse(&temp, json);
-  *res = std::move(temp);
+template <std::integral T>
+void Read(JsonReader& reader, T& value) {
+  const auto token = reader.ReadNumber();
+  if (token.find_first_of(".eE") != std::string_view::npos) {
+    // Fractions are truncated
+    const double number = reader.ParseDouble(token);
+    const double bound = std::ldexp(1.0, std::numeric_limits<T>::digits);
+    const double lower = std::is_signed_v<T> ? -bound : 0.0;
+    if (!(number >= lower && number < bound)) {
+      reader.Fail("integer out of range");
+    }
+    value = static_cast<T>(number);
+    return;
+  }
+  const auto result =
+      std::from_chars(token.data(), token.data() + token.size(), value);
+  if (result.ec != std::errc{} || result.ptr != token.data() + token.size()) {
+    reader.Fail("integer out of range");
+  }
 }
 
-template <>
-inline void Dump(const std::string& field, const std::string& parameter_name,
-                 nlohmann::json& json) {
-  json[parameter_name] = field;
+template <class Field, class T>
+bool ReadField(JsonReader& reader, std::string_view key, T& value, bool& seen) {
+  if (key != Field::kKey) {
+    return false;
+  }
+  Read(reader, Field::Get(value));
+  seen = true;
+  return true;
 }
 
-template <>
-inline void Dump(const bool& field, const std::string& parameter_name,
-                 nlohmann::json& json) {
-  json[parameter_name] = field;
+template <class T, size_t... I>
+void ReadFields(JsonReader& reader, [[maybe_unused]] T& value,
+                std::index_sequence<I...>) {
+  [[maybe_unused]] bool seen[sizeof...(I) + 1] = {};
+  reader.ReadObject([&]([[maybe_unused]] std::string_view key) {
+    if (!(ReadField<JsonFieldAt<T, I>>(reader, key, value, seen[I]) || ...)) {
+      reader.SkipValue();
+    }
+  });
+  ((JsonFieldAt<T, I>::kMandatory && !seen[I]
+        ? throw std::runtime_error("No parameter " +
+                                   std::string(JsonFieldAt<T, I>::kKey) +
+                                   " found in struct")
+        : void()),
+   ...);
 }
 
-template <>
-inline void Dump(const std::vector<std::string>& field,
-                 const std::string& parameter_name, nlohmann::json& json) {
-  json[parameter_name] = field;
+template <DerivedFromJsonCompatible T>
+void Read(JsonReader& reader, T& value) {
+  ReadFields(reader, value, std::make_index_sequence<kJsonFieldsCount<T>>{});
 }
 
-template <>
-inline void Dump(const int& field, const std::string& parameter_name,
-                 nlohmann::json& json) {
-  json[parameter_name] = field;
+template <class T>
+void Read(JsonReader& reader, std::vector<T>& value) {
+  value.clear();
+  reader.ReadArray([&] { Read(reader, value.emplace_back()); });
 }
 
-template <DerivedFromJsonCompatible T>
-inline void Dump(const T& field, const std::string& parameter_name,
-                 nlohmann::json& json) {
-  json[parameter_name] = field.ToJson();
+template <class T>
+void Read(JsonReader& reader, std::optional<T>& value) {
+  if (reader.TryReadNull()) {
+    value.reset();
+    return;
+  }
+  Read(reader, value.emplace());
 }
 
-template <>
-inline void Dump(const userver::storages::postgres::TimePoint& field,
-                 const std::string& parameter_name, nlohmann::json& json) {
-  json[parameter_name] =
-      userver::utils::datetime::Timestring(field, "UTC", "%Y-%m-%dT%H:%M:%E6S");
+template <class OnKey>
+void JsonReader::ReadObject(OnKey&& on_key) {
+  Expect('{');
+  if (Peek() == '}') {
+    ++pos_;
+    return;
+  }
+  while (true) {
+    if (Peek() != '"') {
+      Fail("expected key");
+    }
+    const auto key = ReadKey();
+    Expect(':');
+    on_key(key);
+    if (Peek() == '}') {
+      ++pos_;
+      return;
+    }
+    Expect(',');
+  }
 }
 
-template <DerivedFromJsonCompatible T>
-inline void Dump(const std::vector<T>& field, const std::string& parameter_name,
-                 nlohmann::json& json) {
-  json[parameter_name] = nlohmann::json::array();
-  for (const auto& item : field) {
-    json[parameter_name].push_back(item.ToJson());
+template <class OnItem>
+void JsonReader::ReadArray(OnItem&& on_item) {
+  Expect('[');
+  if (Peek() == ']') {
+    ++pos_;
+    return;
+  }
+  while (true) {
+    on_item();
+    if (Peek() == ']') {
+      ++pos_;
+      return;
+    }
+    Expect(',');
   }
 }
 
 }  // namespace detail
 
-template <class T>
-void JsonCompatible::RegisterParsing(T* ptr, std::string parameter_name,
-                                     bool mandatory) {
-  lambdas_parse_.push_back([ptr, parameter_name = std::move(parameter_name),
-                            mandatory](nlohmann::json& json) {
-    if (json.contains(parameter_name)) {
-      detail::Parse(ptr, json.at(parameter_name));
-      json.erase(parameter_name);
-    } else if (mandatory) {
-      throw std::runtime_error("No parameter " + parameter_name +
-                               " found in struct");
-    }
-  });
+template <class Self, class Base>
+void JsonCompatible<Self, Base>::ParseRegisteredFields(std::string_view body) {
+  if (body.empty()) {
+    return;
+  }
+  detail::JsonReader reader(body);
+  detail::Read(reader, static_cast<Self&>(*this));
+  reader.ExpectEnd();
 }
 
-template <class T>
-void JsonCompatible::RegisterDumping(T* ptr, std::string parameter_name,
-                                     bool mandatory) {
-  lambdas_dump_.push_back([ptr, parameter_name = std::move(parameter_name),
-                           mandatory](nlohmann::json& json) {
-    if constexpr (is_std_optional_v<T>) {
-      if (*ptr == std::nullopt) {
-        if (mandatory) {
-          throw std::runtime_error("Missing mandatory field " + parameter_name);
-        }
-      } else {
-        detail::Dump(ptr->value(), parameter_name, json);
-      }
-    } else {
-      detail::Dump(*ptr, parameter_name, json);
-    }
-  });
+template <class Self, class Base>
+std::string JsonCompatible<Self, Base>::ToJsonString() const {
+  std::string result;
+  detail::Write(result, static_cast<const Self&>(*this));
+  return result;
 }
 
+// Serializes {"<key>":[...]} into a single buffer item by item. Rows are
+// dumped as they are decoded and no response struct is built, but the whole
+// body is still held in memory until Finish() hands it over: this is not a
+// streaming response
+class JsonListWriter {
+ public:
+  explicit JsonListWriter(std::string_view key);
+
+  template <class T>
+  void Append(const T& item) {
+    if (!empty_) {
+      out_ += ',';
+    }
+    empty_ = false;
+    detail::Write(out_, item);
+  }
+
+  // Closes the list and hands over the buffer
+  std::string Finish() &&;
+
+  // Closes the list, adds "<key>":<value> after it and hands over the buffer
+  template <class T>
+  std::string Finish(std::string_view key, const T& value) && {
+    out_ += "],\"";
+    out_ += key;
+    out_ += "\":";
+    detail::Write(out_, value);
+    out_ += '}';
+    return std::move(out_);
+  }
+
+ private:
+  std::string out_;
+  bool empty_ = true;
+};
+
+// The listing check sits in a member function body, so it runs once the
+// struct is complete and sees its JSON_FIELDS
+#define REGISTER_STRUCT_FIELD_INTERNAL(variable_name, type, json_key,          \
+                                       mandatory, default_value)               \
+  struct variable_name##_json_field {                                          \
+    static constexpr std::string_view kKey = json_key;                         \
+    static constexpr bool kMandatory = mandatory;                              \
+    template <class S>                                                         \
+    static constexpr auto& Get(S& self) {                                      \
+      return self.variable_name;                                               \
+    }                                                                          \
+  };                                                                           \
+  static void variable_name##_json_listed() {                                  \
+    static_assert(::detail::kJsonFieldListings<variable_name##_json_field,     \
+                                               JsonFields> == 1,               \
+                  #variable_name " must be listed once in JSON_FIELDS");       \
+  }                                                                            \
+  type variable_name = default_value
+
 #define REGISTER_STRUCT_FIELD_INTERNAL_DEFAULT_VALUE(variable_name, type,     \
                                                      json_key, default_value) \
-  type variable_name = [this,                                                 \
-                        variable_name_addr = &(variable_name)]() -> type {    \
-    RegisterParsing(variable_name_addr, json_key, false);                     \
-    RegisterDumping(variable_name_addr, json_key, false);                     \
-    return default_value;                                                     \
-  }()
+  REGISTER_STRUCT_FIELD_INTERNAL(variable_name, type, json_key, false,        \
+                                 default_value)
 
 #define REGISTER_STRUCT_FIELD_INTERNAL_MANDATORY_VALUE(variable_name, type, \
                                                        json_key)            \
-  type variable_name = [this,                                               \
-                        variable_name_addr = &(variable_name)]() -> type {  \
-    RegisterParsing(variable_name_addr, json_key, true);                    \
-    RegisterDumping(variable_name_addr, json_key, true);                    \
-    return type();                                                          \
-  }()
+  REGISTER_STRUCT_FIELD_INTERNAL(variable_name, type, json_key, true, type())
 
 #define REGISTER_STRUCT_FIELD_INTERMEDIATE(x, A, B, C, D, FUNC, ...) FUNC
 
@@ -247,3 +465,32 @@ void JsonCompatible::RegisterDumping(T* ptr, std::string parameter_name,
 #define REGISTER_STRUCT_FIELD_OPTIONAL(variable_name, type, json_key) \
   REGISTER_STRUCT_FIELD_INTERNAL_DEFAULT_VALUE(                       \
       variable_name, std::optional<type>, json_key, std::nullopt)
+
+#define JSON_FIELDS_PARENS ()
+
+// Every field takes one more rescan of the list, these give structs up to 342
+// fields
+#define JSON_FIELDS_EXPAND(...)            \
+  JSON_FIELDS_EXPAND4(JSON_FIELDS_EXPAND4( \
+      JSON_FIELDS_EXPAND4(JSON_FIELDS_EXPAND4(__VA_ARGS__))))
+#define JSON_FIELDS_EXPAND4(...)           \
+  JSON_FIELDS_EXPAND3(JSON_FIELDS_EXPAND3( \
+      JSON_FIELDS_EXPAND3(JSON_FIELDS_EXPAND3(__VA_ARGS__))))
+#define JSON_FIELDS_EXPAND3(...)           \
+  JSON_FIELDS_EXPAND2(JSON_FIELDS_EXPAND2( \
+      JSON_FIELDS_EXPAND2(JSON_FIELDS_EXPAND2(__VA_ARGS__))))
+#define JSON_FIELDS_EXPAND2(...)           \
+  JSON_FIELDS_EXPAND1(JSON_FIELDS_EXPAND1( \
+      JSON_FIELDS_EXPAND1(JSON_FIELDS_EXPAND1(__VA_ARGS__))))
+#define JSON_FIELDS_EXPAND1(...) __VA_ARGS__
+
+#define JSON_FIELDS_DESCRIPTORS(variable_name, ...) \
+  variable_name##_json_field __VA_OPT__(            \
+      , JSON_FIELDS_DESCRIPTORS_AGAIN JSON_FIELDS_PARENS(__VA_ARGS__))
+#define JSON_FIELDS_DESCRIPTORS_AGAIN() JSON_FIELDS_DESCRIPTORS
+
+// The macro that the programmer uses for listing the registered fields of the
+// struct, in the order they are dumped
+#define JSON_FIELDS(...)                    \
+  using JsonFields = std::tuple<__VA_OPT__( \
+      JSON_FIELDS_EXPAND(JSON_FIELDS_DESCRIPTORS(__VA_ARGS__)))>
@@ -0,0 +1,163 @@
+#include "struct.hpp"
+
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+struct Person : public JsonCompatible<Person> {
+  REGISTER_STRUCT_FIELD(id, std::string, "id");
+  REGISTER_STRUCT_FIELD(age, int, "age", 18);
+  REGISTER_STRUCT_FIELD_OPTIONAL(nickname, std::string, "nickname");
+
+  JSON_FIELDS(id, age, nickname);
+};
+
+struct PersonWithTeam : public JsonCompatible<PersonWithTeam, Person> {
+  REGISTER_STRUCT_FIELD(team, std::string, "team");
+
+  JSON_FIELDS(team);
+};
+
+struct Group : public JsonCompatible<Group> {
+  REGISTER_STRUCT_FIELD(name, std::string, "name");
+  REGISTER_STRUCT_FIELD(lead, PersonWithTeam, "lead");
+  REGISTER_STRUCT_FIELD(members, std::vector<Person>, "members");
+  REGISTER_STRUCT_FIELD(tags, std::vector<std::string>, "tags");
+  REGISTER_STRUCT_FIELD(active, bool, "active", false);
+  REGISTER_STRUCT_FIELD_OPTIONAL(rating, double, "rating");
+  REGISTER_STRUCT_FIELD_OPTIONAL(size, uint64_t, "size");
+
+  JSON_FIELDS(name, lead, members, tags, active, rating, size);
+};
+
+struct Empty : public JsonCompatible<Empty> {};
+
+}  // namespace
+
+UTEST(JsonCompatible, Parse) {
+  Group group;
+  group.ParseRegisteredFields(R"({
+    "name": "core",
+    "unknown": {"nested": [1, "two", null, {"x": true}]},
+    "lead": {"id": "1", "team": "backend", "nickname": "lead"},
+    "members": [{"id": "2", "age": 30}, {"id": "3", "nickname": null}],
+    "tags": ["a", "b"],
+    "active": true,
+    "rating": 4.5,
+    "size": 2e0
+  })");
+
+  EXPECT_EQ(group.name, "core");
+  EXPECT_EQ(group.lead.id, "1");
+  EXPECT_EQ(group.lead.age, 18);
+  EXPECT_EQ(group.lead.nickname, std::optional<std::string>("lead"));
+  EXPECT_EQ(group.lead.team, "backend");
+  EXPECT_EQ(group.members.size(), 2);
+  EXPECT_EQ(group.members[0].age, 30);
+  EXPECT_EQ(group.members[1].id, "3");
+  EXPECT_FALSE(group.members[1].nickname.has_value());
+  EXPECT_EQ(group.tags, (std::vector<std::string>{"a", "b"}));
+  EXPECT_TRUE(group.active);
+  EXPECT_FLOAT_EQ(group.rating.value(), 4.5);
+  EXPECT_EQ(group.size, std::optional<uint64_t>(2));
+}
+
+UTEST(JsonCompatible, ParseStrings) {
+  Person person;
+  person.ParseRegisteredFields(
+      R"({"id": "q\"\\\/\nАé🙂"})");
+  EXPECT_EQ(person.id, "q\"\\/\nАé🙂");
+
+  person.ParseRegisteredFields("");
+  EXPECT_EQ(person.id, "q\"\\/\nАé🙂");
+}
+
+UTEST(JsonCompatible, ParseErrors) {
+  Person person;
+  EXPECT_THROW(person.ParseRegisteredFields(R"({"age": 1})"),
+               std::runtime_error);
+  EXPECT_THROW(person.ParseRegisteredFields(R"({"id": "1",})"),
+               std::runtime_error);
+  EXPECT_THROW(person.ParseRegisteredFields(R"({"id": 1})"),
+               std::runtime_error);
+  EXPECT_THROW(person.ParseRegisteredFields(R"({"id": "1"} {})"),
+               std::runtime_error);
+  EXPECT_THROW(person.ParseRegisteredFields(R"({"id": "1", "age": 1e100})"),
+               std::runtime_error);
+  EXPECT_THROW(person.ParseRegisteredFields(R"({"id": "\ud83d"})"),
+               std::runtime_error);
+}
+
+UTEST(JsonCompatible, ParseInvalidStrings) {
+  Person person;
+  // Raw control characters, a broken sequence, an overlong form, a surrogate,
+  // a code point past U+10FFFF and a truncated sequence
+  for (const std::string_view value :
+       {"a\nb", "\t", "\xC3\x28", "\xC0\xAF", "\xED\xA0\x80",
+        "\xF4\x90\x80\x80", "\xE2\x82"}) {
+    const auto body = "{\"id\": \"" + std::string(value) + "\"}";
+    EXPECT_THROW(person.ParseRegisteredFields(body), std::runtime_error);
+    const auto key = "{\"id\": \"1\", \"" + std::string(value) + "\": 1}";
+    EXPECT_THROW(person.ParseRegisteredFields(key), std::runtime_error);
+  }
+}
+
+UTEST(JsonCompatible, EmptyStruct) {
+  Empty empty;
+  empty.ParseRegisteredFields(R"({"id": "1"})");
+  EXPECT_EQ(empty.ToJsonString(), "{}");
+}
+
+UTEST(JsonCompatible, Dump) {
+  Group group;
+  group.name = "a\"b\\c\n\x01";
+  group.lead.id = "1";
+  group.lead.team = "backend";
+  group.members.emplace_back().id = "Пётр";
+  group.members.back().nickname = "p";
+  group.tags = {"x"};
+  group.size = 3;
+
+  EXPECT_EQ(group.ToJsonString(),
+            R"({"name":"a\"b\\c\n\u0001",)"
+            R"("lead":{"id":"1","age":18,"team":"backend"},)"
+            R"("members":[{"id":"Пётр","age":18,"nickname":"p"}],)"
+            R"("tags":["x"],"active":false,"size":3})");
+}
+
+UTEST(JsonCompatible, RoundTrip) {
+  Group group;
+  group.name = "core";
+  group.lead.id = "1";
+  group.lead.nickname = "\t";
+  group.members.resize(3);
+  group.rating = -0.25;
+
+  Group parsed;
+  parsed.ParseRegisteredFields(group.ToJsonString());
+  EXPECT_EQ(parsed.ToJsonString(), group.ToJsonString());
+}
+
+UTEST(JsonCompatible, ListWriter) {
+  JsonListWriter empty("members");
+  EXPECT_EQ(std::move(empty).Finish(), R"({"members":[]})");
+
+  JsonListWriter writer("members");
+  Person person;
+  person.id = "1";
+  writer.Append(person);
+  person.nickname = "n";
+  writer.Append(person);
+  EXPECT_EQ(std::move(writer).Finish(),
+            R"({"members":[{"id":"1","age":18},)"
+            R"({"id":"1","age":18,"nickname":"n"}]})");
+}
+
+UTEST(JsonCompatible, ListWriterTrailingField) {
+  JsonListWriter writer("members");
+  Person person;
+  person.id = "1";
+  writer.Append(person);
+  EXPECT_EQ(std::move(writer).Finish("next", std::string("a\"b")),
+            R"({"members":[{"id":"1","age":18}],"next":"a\"b"})");
+}
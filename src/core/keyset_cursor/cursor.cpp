@@ -0,0 +1,42 @@
+#include "cursor.hpp"
+
+#include <charconv>
+#include <cstdint>
+
+namespace core::keyset_cursor {
+
+namespace {
+
+constexpr char kSeparator = '_';
+
+}  // namespace
+
+std::string Encode(const Cursor& cursor) {
+  const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                          cursor.created.time_since_epoch())
+                          .count();
+  return std::to_string(micros) + kSeparator + cursor.id;
+}
+
+std::optional<Cursor> Decode(std::string_view cursor) {
+  const auto separator = cursor.find(kSeparator);
+  if (separator == std::string_view::npos || separator == 0 ||
+      separator + 1 == cursor.size()) {
+    return std::nullopt;
+  }
+
+  int64_t micros = 0;
+  const auto* end = cursor.data() + separator;
+  const auto [ptr, error] = std::from_chars(cursor.data(), end, micros);
+  if (error != std::errc{} || ptr != end) {
+    return std::nullopt;
+  }
+
+  return Cursor{std::chrono::system_clock::time_point{
+                    std::chrono::duration_cast<
+                        std::chrono::system_clock::duration>(
+                        std::chrono::microseconds{micros})},
+                std::string(cursor.substr(separator + 1))};
+}
+
+}  // namespace core::keyset_cursor
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace core::keyset_cursor {
+
+// Position in a feed ordered by (created, id) descending: the next page
+// starts right after the row with this key
+struct Cursor {
+  std::chrono::system_clock::time_point created;
+  std::string id;
+};
+
+// "<microseconds since epoch>_<id>", the precision of TIMESTAMPTZ
+std::string Encode(const Cursor& cursor);
+
+// std::nullopt if `cursor` was not made by Encode
+std::optional<Cursor> Decode(std::string_view cursor);
+
+}  // namespace core::keyset_cursor
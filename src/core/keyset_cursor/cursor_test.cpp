@@ -0,0 +1,27 @@
+#include "cursor.hpp"
+
+#include <userver/utest/utest.hpp>
+
+UTEST(KeysetCursor, RoundTrip) {
+  const core::keyset_cursor::Cursor cursor{
+      std::chrono::system_clock::time_point{
+          std::chrono::microseconds{1700000000123456}},
+      "8c6f_a1"};
+  const auto encoded = core::keyset_cursor::Encode(cursor);
+  EXPECT_EQ(encoded, "1700000000123456_8c6f_a1");
+
+  const auto decoded = core::keyset_cursor::Decode(encoded);
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_EQ(decoded->created, cursor.created);
+  EXPECT_EQ(decoded->id, cursor.id);
+}
+
+UTEST(KeysetCursor, Malformed) {
+  EXPECT_FALSE(core::keyset_cursor::Decode("").has_value());
+  EXPECT_FALSE(core::keyset_cursor::Decode("123").has_value());
+  EXPECT_FALSE(core::keyset_cursor::Decode("_id").has_value());
+  EXPECT_FALSE(core::keyset_cursor::Decode("123_").has_value());
+  EXPECT_FALSE(core::keyset_cursor::Decode("12a_id").has_value());
+  EXPECT_FALSE(core::keyset_cursor::Decode("99999999999999999999_id")
+                   .has_value());
+}
@@ -0,0 +1,164 @@
+#include "component.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/postgres/component.hpp>
+#include <userver/storages/postgres/notify.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include "core/tenant_query/query.hpp"
+
+namespace core::notification_hub {
+
+namespace {
+
+constexpr std::string_view kEveryUser = "/*";
+
+std::string Key(std::string_view schema, std::string_view user_id) {
+  std::string key(schema);
+  key.push_back('/');
+  key.append(user_id);
+  return key;
+}
+
+}  // namespace
+
+NotificationHub::Subscription::Subscription(NotificationHub& hub,
+                                            std::string key)
+    : hub_(&hub),
+      key_(std::move(key)),
+      waiter_(std::make_shared<userver::engine::SingleConsumerEvent>()) {}
+
+NotificationHub::Subscription::~Subscription() {
+  if (waiter_) {
+    hub_->Unsubscribe(key_, waiter_);
+  }
+}
+
+bool NotificationHub::Subscription::WaitUntil(
+    userver::engine::Deadline deadline) {
+  return waiter_->WaitForEventUntil(deadline);
+}
+
+NotificationHub::NotificationHub(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context)
+    : LoggableComponentBase(config, context),
+      pg_cluster_(
+          context.FindComponent<userver::components::Postgres>("key-value")
+              .GetCluster()),
+      reconnect_delay_(
+          config["reconnect-delay"].As<std::chrono::milliseconds>()) {}
+
+NotificationHub::Subscription NotificationHub::Subscribe(
+    std::string_view company_id, std::string_view user_id) {
+  Subscription subscription(
+      *this, Key(core::tenant_query::Schema(company_id), user_id));
+  std::lock_guard lock(mutex_);
+  waiters_[subscription.key_].push_back(subscription.waiter_);
+  return subscription;
+}
+
+void NotificationHub::Unsubscribe(const std::string& key,
+                                  const Waiter& waiter) {
+  std::lock_guard lock(mutex_);
+  const auto it = waiters_.find(key);
+  if (it == waiters_.end()) {
+    return;
+  }
+  auto& waiters = it->second;
+  waiters.erase(std::remove(waiters.begin(), waiters.end(), waiter),
+                waiters.end());
+  if (waiters.empty()) {
+    waiters_.erase(it);
+  }
+}
+
+void NotificationHub::Wake(std::string_view key) {
+  std::lock_guard lock(mutex_);
+  if (key.size() >= kEveryUser.size() &&
+      key.substr(key.size() - kEveryUser.size()) == kEveryUser) {
+    // "<schema>/*", the prefix includes the slash
+    const auto prefix = key.substr(0, key.size() - 1);
+    for (const auto& [waiters_key, waiters] : waiters_) {
+      if (std::string_view(waiters_key).substr(0, prefix.size()) == prefix) {
+        for (const auto& waiter : waiters) {
+          waiter->Send();
+        }
+      }
+    }
+    return;
+  }
+
+  const auto it = waiters_.find(std::string(key));
+  if (it == waiters_.end()) {
+    return;
+  }
+  for (const auto& waiter : it->second) {
+    waiter->Send();
+  }
+}
+
+void NotificationHub::WakeAll() {
+  std::lock_guard lock(mutex_);
+  for (const auto& [key, waiters] : waiters_) {
+    for (const auto& waiter : waiters) {
+      waiter->Send();
+    }
+  }
+}
+
+void NotificationHub::Listen() {
+  while (!userver::engine::current_task::ShouldCancel()) {
+    try {
+      auto scope = pg_cluster_->Listen(kChannel);
+      // Changes made while the connection was down were not delivered
+      WakeAll();
+      while (true) {
+        const auto notification = scope.WaitNotify({});
+        if (notification.payload.has_value()) {
+          Wake(*notification.payload);
+        }
+      }
+    } catch (const std::exception& ex) {
+      if (userver::engine::current_task::ShouldCancel()) {
+        return;
+      }
+      LOG_WARNING() << "Listening on " << kChannel << " failed: " << ex;
+    }
+    userver::engine::InterruptibleSleepFor(reconnect_delay_);
+  }
+}
+
+void NotificationHub::OnAllComponentsLoaded() {
+  listener_ = userver::utils::CriticalAsync("notification-hub-listener",
+                                            [this] { Listen(); });
+}
+
+void NotificationHub::OnAllComponentsAreStopping() {
+  if (listener_.IsValid()) {
+    listener_.SyncCancel();
+  }
+  // Waiting requests answer with the state they have
+  WakeAll();
+}
+
+userver::yaml_config::Schema NotificationHub::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::LoggableComponentBase>(R"(
+type: object
+description: Wakes requests waiting for notifications of a user
+additionalProperties: false
+properties:
+    reconnect-delay:
+        type: string
+        description: pause before listening again after the connection failed
+)");
+}
+
+}  // namespace core::notification_hub
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+namespace core::notification_hub {
+
+// Channel of the NOTIFY sent by the triggers on notifications, the payload
+// is "<schema>/<user_id>" of a user whose notifications changed or
+// "<schema>/*" for a broadcast to the users of the company
+inline constexpr std::string_view kChannel = "notifications";
+
+// Wakes the requests of a user that wait for changes of their notifications.
+// Every instance LISTENs on kChannel over one connection, so a change
+// committed through any instance reaches the waiters of all of them. The
+// event only says that something changed, a waiter reads the state itself.
+class NotificationHub final
+    : public userver::components::LoggableComponentBase {
+ private:
+  using Waiter = std::shared_ptr<userver::engine::SingleConsumerEvent>;
+
+ public:
+  static constexpr std::string_view kName = "notification-hub";
+
+  // Registered until destroyed. Subscribe before reading the state, so that
+  // a change between the read and the wait is not missed.
+  class Subscription {
+   public:
+    Subscription(Subscription&&) = default;
+    Subscription& operator=(Subscription&&) = delete;
+    ~Subscription();
+
+    // False if the deadline passed or the task was cancelled first
+    bool WaitUntil(userver::engine::Deadline deadline);
+
+   private:
+    friend class NotificationHub;
+
+    Subscription(NotificationHub& hub, std::string key);
+
+    NotificationHub* hub_;
+    std::string key_;
+    Waiter waiter_;
+  };
+
+  NotificationHub(const userver::components::ComponentConfig& config,
+                  const userver::components::ComponentContext& context);
+
+  Subscription Subscribe(std::string_view company_id,
+                         std::string_view user_id);
+
+  void OnAllComponentsLoaded() override;
+
+  void OnAllComponentsAreStopping() override;
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  void Listen();
+  void Wake(std::string_view key);
+  void WakeAll();
+  void Unsubscribe(const std::string& key, const Waiter& waiter);
+
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+  const std::chrono::milliseconds reconnect_delay_;
+
+  userver::engine::Mutex mutex_;
+  std::unordered_map<std::string, std::vector<Waiter>> waiters_;
+
+  userver::engine::TaskWithResult<void> listener_;
+};
+
+}  // namespace core::notification_hub
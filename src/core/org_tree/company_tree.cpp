@@ -0,0 +1,200 @@
+#include "company_tree.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+
+namespace core::org_tree {
+
+namespace {
+
+constexpr auto kUnvisited = std::numeric_limits<size_t>::max();
+
+const std::set<std::string> kNoReports;
+
+}  // namespace
+
+void CompanyTree::Upsert(std::vector<OrgEmployee> employees) {
+  std::lock_guard lock(mutex_);
+  bool moved = false;
+  for (auto& employee : employees) {
+    auto [it, inserted] = nodes_.try_emplace(employee.id);
+    auto& node = it->second;
+    if (inserted || node.card.head_id != employee.head_id) {
+      if (!inserted) {
+        Unlink(node);
+      }
+      if (employee.head_id.has_value()) {
+        reports_[*employee.head_id].insert(employee.id);
+      }
+      moved = true;
+    }
+    node.card = std::move(employee);
+  }
+  if (moved) {
+    Renumber();
+  }
+}
+
+void CompanyTree::Remove(const std::string& employee_id) {
+  std::lock_guard lock(mutex_);
+  auto it = nodes_.find(employee_id);
+  if (it == nodes_.end()) {
+    return;
+  }
+  // The reports are kept under the id and become roots until it is back
+  Unlink(it->second);
+  nodes_.erase(it);
+  Renumber();
+}
+
+std::optional<OrgEmployee> CompanyTree::Find(
+    const std::string& employee_id) const {
+  std::shared_lock lock(mutex_);
+  auto it = nodes_.find(employee_id);
+  if (it == nodes_.end()) {
+    return std::nullopt;
+  }
+  return it->second.card;
+}
+
+std::optional<std::string> CompanyTree::GetHead(
+    const std::string& employee_id) const {
+  std::shared_lock lock(mutex_);
+  auto it = nodes_.find(employee_id);
+  if (it == nodes_.end()) {
+    return std::nullopt;
+  }
+  return it->second.card.head_id;
+}
+
+std::vector<OrgEmployee> CompanyTree::GetReports(
+    const std::string& head_id) const {
+  std::shared_lock lock(mutex_);
+  std::vector<OrgEmployee> reports;
+  auto it = reports_.find(head_id);
+  if (it == reports_.end()) {
+    return reports;
+  }
+  reports.reserve(it->second.size());
+  for (const auto& employee_id : it->second) {
+    reports.push_back(nodes_.at(employee_id).card);
+  }
+  return reports;
+}
+
+std::vector<OrgEmployee> CompanyTree::GetSubtree(
+    const std::string& head_id) const {
+  std::shared_lock lock(mutex_);
+  std::vector<OrgEmployee> subtree;
+  auto it = nodes_.find(head_id);
+  if (it == nodes_.end()) {
+    return subtree;
+  }
+  const auto& head = it->second;
+  subtree.reserve(head.exit - head.enter - 1);
+  for (auto i = head.enter + 1; i < head.exit; ++i) {
+    subtree.push_back(walk_[i]->card);
+  }
+  return subtree;
+}
+
+bool CompanyTree::IsTransitiveReport(const std::string& head_id,
+                                     const std::string& employee_id) const {
+  std::shared_lock lock(mutex_);
+  auto head = nodes_.find(head_id);
+  auto employee = nodes_.find(employee_id);
+  if (head == nodes_.end() || employee == nodes_.end()) {
+    return false;
+  }
+  return head->second.enter < employee->second.enter &&
+         employee->second.enter < head->second.exit;
+}
+
+size_t CompanyTree::EmployeesCount() const {
+  std::shared_lock lock(mutex_);
+  return nodes_.size();
+}
+
+void CompanyTree::Unlink(const Node& node) {
+  if (!node.card.head_id.has_value()) {
+    return;
+  }
+  auto it = reports_.find(*node.card.head_id);
+  if (it != reports_.end()) {
+    it->second.erase(node.card.id);
+    if (it->second.empty()) {
+      reports_.erase(it);
+    }
+  }
+}
+
+void CompanyTree::Renumber() {
+  struct Frame {
+    Node* node;
+    std::set<std::string>::const_iterator next, end;
+  };
+  std::vector<Frame> stack;
+
+  const auto enter = [&](Node& node) {
+    node.enter = walk_.size();
+    walk_.push_back(&node);
+    auto it = reports_.find(node.card.id);
+    const auto& reports = it != reports_.end() ? it->second : kNoReports;
+    stack.push_back({&node, reports.begin(), reports.end()});
+  };
+
+  const auto walk_from = [&](Node& root) {
+    enter(root);
+    while (!stack.empty()) {
+      auto& frame = stack.back();
+      if (frame.next == frame.end) {
+        frame.node->exit = walk_.size();
+        stack.pop_back();
+        continue;
+      }
+      auto& report = nodes_.at(*frame.next++);
+      if (report.enter == kUnvisited) {
+        enter(report);
+      }
+    }
+  };
+
+  walk_.clear();
+  walk_.reserve(nodes_.size());
+  std::vector<std::string> roots, rest;
+  for (auto& [employee_id, node] : nodes_) {
+    node.enter = kUnvisited;
+    const auto& head_id = node.card.head_id;
+    if (!head_id.has_value() || !nodes_.count(*head_id)) {
+      roots.push_back(employee_id);
+    } else {
+      rest.push_back(employee_id);
+    }
+  }
+
+  std::sort(roots.begin(), roots.end());
+  for (const auto& employee_id : roots) {
+    walk_from(nodes_.at(employee_id));
+  }
+  if (walk_.size() == nodes_.size()) {
+    return;
+  }
+
+  // Whatever is left hangs off cycles of heads
+  std::sort(rest.begin(), rest.end());
+  for (const auto& employee_id : rest) {
+    auto* node = &nodes_.at(employee_id);
+    if (node->enter != kUnvisited) {
+      continue;
+    }
+    std::set<const Node*> chain;
+    while (chain.insert(node).second) {
+      node = &nodes_.at(*node->card.head_id);
+    }
+    walk_from(*node);
+  }
+}
+
+}  // namespace core::org_tree
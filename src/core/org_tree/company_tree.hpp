@@ -0,0 +1,69 @@
+#pragma once
+
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/engine/shared_mutex.hpp>
+
+namespace core::org_tree {
+
+struct OrgEmployee {
+  std::string id;
+  std::string name;
+  std::string surname;
+  std::optional<std::string> patronymic;
+  std::optional<std::string> photo_link;
+  std::optional<std::string> position;
+  std::optional<std::string> head_id;
+};
+
+// Org chart of one company. Every employee keeps its head, so the parent is
+// found with one lookup, and the entry and exit times of a depth-first walk
+// over the chart, so the transitive reports of a head are one contiguous
+// range of the walk. Employees whose head is unknown are roots, a cycle of
+// heads is entered at the first member met in id order.
+class CompanyTree {
+ public:
+  // Changes of the heads renumber the walk once per call
+  void Upsert(std::vector<OrgEmployee> employees);
+
+  void Remove(const std::string& employee_id);
+
+  std::optional<OrgEmployee> Find(const std::string& employee_id) const;
+
+  std::optional<std::string> GetHead(const std::string& employee_id) const;
+
+  // Direct reports in id order
+  std::vector<OrgEmployee> GetReports(const std::string& head_id) const;
+
+  // Transitive reports in the order of the walk, each one after its head
+  std::vector<OrgEmployee> GetSubtree(const std::string& head_id) const;
+
+  bool IsTransitiveReport(const std::string& head_id,
+                          const std::string& employee_id) const;
+
+  size_t EmployeesCount() const;
+
+ private:
+  struct Node {
+    OrgEmployee card;
+    // Positions in walk_, the subtree takes [enter, exit)
+    size_t enter = 0;
+    size_t exit = 0;
+  };
+
+  void Unlink(const Node& node);
+
+  void Renumber();
+
+  mutable userver::engine::SharedMutex mutex_;
+
+  std::unordered_map<std::string, Node> nodes_;
+  std::unordered_map<std::string, std::set<std::string>> reports_;
+  std::vector<const Node*> walk_;
+};
+
+}  // namespace core::org_tree
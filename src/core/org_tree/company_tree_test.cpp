@@ -0,0 +1,87 @@
+#include "company_tree.hpp"
+
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+using core::org_tree::CompanyTree;
+using core::org_tree::OrgEmployee;
+
+OrgEmployee Employee(std::string id, std::optional<std::string> head_id) {
+  return {id, "Name " + id, "Surname " + id, {}, {}, {}, std::move(head_id)};
+}
+
+std::vector<std::string> Ids(const std::vector<OrgEmployee>& employees) {
+  std::vector<std::string> ids;
+  for (const auto& employee : employees) {
+    ids.push_back(employee.id);
+  }
+  return ids;
+}
+
+// a -> b -> d, a -> c, e
+void FillTree(CompanyTree& tree) {
+  tree.Upsert({Employee("d", "b"), Employee("c", "a"), Employee("b", "a"),
+               Employee("a", {}), Employee("e", {})});
+}
+
+}  // namespace
+
+UTEST(OrgTree, Reports) {
+  CompanyTree tree;
+  FillTree(tree);
+
+  EXPECT_EQ(Ids(tree.GetReports("a")), (std::vector<std::string>{"b", "c"}));
+  EXPECT_EQ(Ids(tree.GetSubtree("a")),
+            (std::vector<std::string>{"b", "d", "c"}));
+  EXPECT_EQ(Ids(tree.GetSubtree("b")), (std::vector<std::string>{"d"}));
+  EXPECT_TRUE(tree.GetSubtree("e").empty());
+  EXPECT_TRUE(tree.GetSubtree("x").empty());
+
+  EXPECT_EQ(tree.GetHead("d"), std::optional<std::string>{"b"});
+  EXPECT_EQ(tree.GetHead("a"), std::nullopt);
+  EXPECT_EQ(tree.Find("c")->surname, "Surname c");
+  EXPECT_EQ(tree.EmployeesCount(), 5);
+
+  EXPECT_TRUE(tree.IsTransitiveReport("a", "d"));
+  EXPECT_FALSE(tree.IsTransitiveReport("a", "a"));
+  EXPECT_FALSE(tree.IsTransitiveReport("b", "c"));
+  EXPECT_FALSE(tree.IsTransitiveReport("d", "a"));
+  EXPECT_FALSE(tree.IsTransitiveReport("e", "d"));
+}
+
+UTEST(OrgTree, Moves) {
+  CompanyTree tree;
+  FillTree(tree);
+
+  tree.Upsert({Employee("b", "e")});
+  EXPECT_EQ(Ids(tree.GetSubtree("a")), (std::vector<std::string>{"c"}));
+  EXPECT_EQ(Ids(tree.GetSubtree("e")), (std::vector<std::string>{"b", "d"}));
+  EXPECT_TRUE(tree.IsTransitiveReport("e", "d"));
+
+  // Cards change without renumbering
+  auto renamed = Employee("d", "b");
+  renamed.name = "Renamed";
+  tree.Upsert({renamed});
+  EXPECT_EQ(tree.GetSubtree("e").back().name, "Renamed");
+
+  tree.Remove("b");
+  EXPECT_TRUE(tree.GetSubtree("e").empty());
+  EXPECT_EQ(tree.GetHead("d"), std::optional<std::string>{"b"});
+  EXPECT_EQ(tree.EmployeesCount(), 4);
+
+  tree.Upsert({Employee("b", "c")});
+  EXPECT_EQ(Ids(tree.GetSubtree("a")),
+            (std::vector<std::string>{"c", "b", "d"}));
+}
+
+UTEST(OrgTree, Cycles) {
+  CompanyTree tree;
+  tree.Upsert({Employee("a", "b"), Employee("b", "a"), Employee("c", "b"),
+               Employee("d", "d")});
+
+  EXPECT_EQ(Ids(tree.GetSubtree("a")), (std::vector<std::string>{"b", "c"}));
+  EXPECT_TRUE(tree.IsTransitiveReport("a", "c"));
+  EXPECT_TRUE(tree.GetSubtree("d").empty());
+  EXPECT_EQ(tree.EmployeesCount(), 4);
+}
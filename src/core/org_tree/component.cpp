@@ -0,0 +1,210 @@
+#include "component.hpp"
+
+#include <mutex>
+
+#include <userver/logging/log.hpp>
+#include <userver/storages/postgres/component.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include "core/tenant_query/query.hpp"
+
+namespace core::org_tree {
+
+namespace {
+
+const core::tenant_query::TenantQuery kSelectEmployee{
+    "org_tree_select_employee",
+    "SELECT id, name, surname, patronymic, photo_link, position, head_id "
+    "FROM {schema}.employees "
+    "WHERE id = $1"};
+
+const core::tenant_query::TenantQuery kSelectEmployees{
+    "org_tree_select_employees",
+    "SELECT id, name, surname, patronymic, photo_link, position, head_id "
+    "FROM {schema}.employees"};
+
+const core::tenant_query::TenantQuery kSelectUpdatedEmployees{
+    "org_tree_select_updated_employees",
+    "SELECT id, name, surname, patronymic, photo_link, position, head_id "
+    "FROM {schema}.employees "
+    "WHERE updated > $1"};
+
+}  // namespace
+
+OrgTreeCache::OrgTreeCache(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context)
+    : CachingComponentBase(config, context),
+      pg_cluster_(
+          context.FindComponent<userver::components::Postgres>("key-value")
+              .GetCluster()),
+      update_correction_(
+          config["update-correction"].As<std::chrono::milliseconds>(
+              std::chrono::seconds{10})) {
+  StartPeriodicUpdates();
+}
+
+OrgTreeCache::~OrgTreeCache() { StopPeriodicUpdates(); }
+
+std::vector<OrgEmployee> OrgTreeCache::GetReports(
+    const std::string& company_id, const std::string& head_id) const {
+  auto tree = FindCompany(company_id);
+  if (!tree) {
+    return {};
+  }
+  return tree->GetReports(head_id);
+}
+
+std::vector<OrgEmployee> OrgTreeCache::GetSubtree(
+    const std::string& company_id, const std::string& head_id) const {
+  auto tree = FindCompany(company_id);
+  if (!tree) {
+    return {};
+  }
+  return tree->GetSubtree(head_id);
+}
+
+std::optional<OrgEmployee> OrgTreeCache::FindEmployee(
+    const std::string& company_id, const std::string& employee_id) {
+  if (auto tree = FindCompany(company_id)) {
+    if (auto employee = tree->Find(employee_id)) {
+      return employee;
+    }
+  }
+  RefreshEmployee(company_id, employee_id);
+  return GetOrCreateCompany(company_id)->Find(employee_id);
+}
+
+std::optional<std::string> OrgTreeCache::GetHead(
+    const std::string& company_id, const std::string& employee_id) {
+  auto employee = FindEmployee(company_id, employee_id);
+  if (!employee.has_value()) {
+    return std::nullopt;
+  }
+  return std::move(employee->head_id);
+}
+
+void OrgTreeCache::RefreshEmployee(const std::string& company_id,
+                                   const std::string& employee_id) {
+  auto result = pg_cluster_->Execute(
+      userver::storages::postgres::ClusterHostType::kMaster,
+      kSelectEmployee.For(company_id), employee_id);
+  if (result.IsEmpty()) {
+    RemoveEmployee(company_id, employee_id);
+    return;
+  }
+  GetOrCreateCompany(company_id)->Upsert(
+      {result.AsSingleRow<OrgEmployee>(userver::storages::postgres::kRowTag)});
+}
+
+void OrgTreeCache::RemoveEmployee(const std::string& company_id,
+                                  const std::string& employee_id) {
+  GetOrCreateCompany(company_id)->Remove(employee_id);
+}
+
+void OrgTreeCache::Update(
+    userver::cache::UpdateType type,
+    const std::chrono::system_clock::time_point& last_update,
+    const std::chrono::system_clock::time_point& /*now*/,
+    userver::cache::UpdateStatisticsScope& stats_scope) {
+  auto schemas = pg_cluster_->Execute(
+      userver::storages::postgres::ClusterHostType::kSlave,
+      "SELECT substr(schema_name, 13) "
+      "FROM information_schema.schemata "
+      "WHERE schema_name LIKE 'working\\_day\\_%'");
+
+  // Rows committed after the previous update may carry an earlier `updated`
+  // and the replica may lag behind, so the window starts a bit earlier
+  const userver::storages::postgres::TimePointTz updated_after{
+      last_update - update_correction_};
+  std::unordered_map<std::string, std::shared_ptr<CompanyTree>> known;
+  if (type == userver::cache::UpdateType::kIncremental) {
+    known = Get()->companies;
+  }
+
+  CompanyTrees trees;
+  size_t employees_count = 0;
+  for (const auto& company_id :
+       schemas.AsContainer<std::vector<std::string>>()) {
+    auto it = known.find(company_id);
+    std::shared_ptr<CompanyTree> tree;
+    if (it != known.end()) {
+      tree = it->second;
+      auto updated = pg_cluster_->Execute(
+          userver::storages::postgres::ClusterHostType::kSlave,
+          kSelectUpdatedEmployees.For(company_id), updated_after);
+      stats_scope.IncreaseDocumentsReadCount(updated.Size());
+      tree->Upsert(updated.AsContainer<std::vector<OrgEmployee>>(
+          userver::storages::postgres::kRowTag));
+    } else {
+      tree = LoadCompany(company_id, stats_scope);
+    }
+    employees_count += tree->EmployeesCount();
+    trees.companies.emplace(company_id, std::move(tree));
+  }
+
+  // Same as for the search index: write-throughs racing with a full update
+  // are only visible after the next one if their writes have not landed yet
+  std::lock_guard lock(set_mutex_);
+  Set(std::move(trees));
+  stats_scope.Finish(employees_count);
+}
+
+std::shared_ptr<CompanyTree> OrgTreeCache::LoadCompany(
+    const std::string& company_id,
+    userver::cache::UpdateStatisticsScope& stats_scope) const {
+  auto result = pg_cluster_->Execute(
+      userver::storages::postgres::ClusterHostType::kSlave,
+      kSelectEmployees.For(company_id));
+  stats_scope.IncreaseDocumentsReadCount(result.Size());
+
+  auto tree = std::make_shared<CompanyTree>();
+  tree->Upsert(result.AsContainer<std::vector<OrgEmployee>>(
+      userver::storages::postgres::kRowTag));
+  return tree;
+}
+
+std::shared_ptr<CompanyTree> OrgTreeCache::FindCompany(
+    const std::string& company_id) const {
+  const auto snapshot = Get();
+  auto it = snapshot->companies.find(company_id);
+  if (it == snapshot->companies.end()) {
+    return nullptr;
+  }
+  return it->second;
+}
+
+std::shared_ptr<CompanyTree> OrgTreeCache::GetOrCreateCompany(
+    const std::string& company_id) {
+  if (auto tree = FindCompany(company_id)) {
+    return tree;
+  }
+
+  std::lock_guard lock(set_mutex_);
+  auto trees = *Get();
+  auto [it, inserted] = trees.companies.emplace(
+      company_id, std::make_shared<CompanyTree>());
+  auto tree = it->second;
+  if (inserted) {
+    LOG_INFO() << "Created org tree for company " << company_id;
+    Set(std::move(trees));
+  }
+  return tree;
+}
+
+userver::yaml_config::Schema OrgTreeCache::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::CachingComponentBase<CompanyTrees>>(R"(
+type: object
+description: In-memory org chart of every company
+additionalProperties: false
+properties:
+    update-correction:
+        type: string
+        description: lookback of incremental updates past the previous one
+        defaultDescription: 10s
+)");
+}
+
+}  // namespace core::org_tree
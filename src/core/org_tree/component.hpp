@@ -0,0 +1,83 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/cache/caching_component_base.hpp>
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+#include "company_tree.hpp"
+
+namespace core::org_tree {
+
+struct CompanyTrees {
+  std::unordered_map<std::string, std::shared_ptr<CompanyTree>> companies;
+};
+
+// Per-company org charts. A full update reloads every company, an
+// incremental one applies the employees updated since the previous update.
+// Removed employees only disappear on a full update, so handlers that add,
+// move or remove employees write through right after their commit.
+class OrgTreeCache final
+    : public userver::components::CachingComponentBase<CompanyTrees> {
+ public:
+  static constexpr std::string_view kName = "org-tree";
+
+  OrgTreeCache(const userver::components::ComponentConfig& config,
+               const userver::components::ComponentContext& context);
+
+  ~OrgTreeCache() override;
+
+  std::vector<OrgEmployee> GetReports(const std::string& company_id,
+                                      const std::string& head_id) const;
+
+  std::vector<OrgEmployee> GetSubtree(const std::string& company_id,
+                                      const std::string& head_id) const;
+
+  // Employees missing from the tree are loaded from the master, so the ones
+  // added on another instance are found before the next update
+  std::optional<OrgEmployee> FindEmployee(const std::string& company_id,
+                                          const std::string& employee_id);
+
+  std::optional<std::string> GetHead(const std::string& company_id,
+                                     const std::string& employee_id);
+
+  // Reloads the employee from the master, removes it if it no longer exists
+  void RefreshEmployee(const std::string& company_id,
+                       const std::string& employee_id);
+
+  void RemoveEmployee(const std::string& company_id,
+                      const std::string& employee_id);
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  void Update(userver::cache::UpdateType type,
+              const std::chrono::system_clock::time_point& last_update,
+              const std::chrono::system_clock::time_point& now,
+              userver::cache::UpdateStatisticsScope& stats_scope) override;
+
+  std::shared_ptr<CompanyTree> LoadCompany(
+      const std::string& company_id,
+      userver::cache::UpdateStatisticsScope& stats_scope) const;
+
+  std::shared_ptr<CompanyTree> FindCompany(
+      const std::string& company_id) const;
+
+  std::shared_ptr<CompanyTree> GetOrCreateCompany(
+      const std::string& company_id);
+
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+  const std::chrono::milliseconds update_correction_;
+  userver::engine::Mutex set_mutex_;
+};
+
+}  // namespace core::org_tree
@@ -0,0 +1,59 @@
+#include "component.hpp"
+
+#include <string>
+
+#include <userver/server/http/http_response_cookie.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include "last_write.hpp"
+
+namespace core::read_routing {
+
+ReadRouter::ReadRouter(const userver::components::ComponentConfig& config,
+                       const userver::components::ComponentContext& context)
+    : LoggableComponentBase(config, context),
+      replica_lag_(config["replica-lag"].As<std::chrono::milliseconds>()),
+      recent_writes_(config["max-tracked-users"].As<size_t>(), replica_lag_) {}
+
+void ReadRouter::MarkWrite(
+    const userver::server::http::HttpRequest& request,
+    const userver::server::request::RequestContext& context) {
+  recent_writes_.Add(context.GetData<std::string>("company_id"),
+                     context.GetData<std::string>("user_id"), Clock::now());
+
+  userver::server::http::Cookie cookie{std::string(kLastWriteCookie),
+                                       FormatLastWrite(SystemClock::now())};
+  cookie.SetPath("/");
+  cookie.SetHttpOnly();
+  cookie.SetMaxAge(std::chrono::ceil<std::chrono::seconds>(replica_lag_));
+  request.GetHttpResponse().SetCookie(std::move(cookie));
+}
+
+userver::storages::postgres::ClusterHostType ReadRouter::ReadHost(
+    const userver::server::http::HttpRequest& request,
+    std::string_view company_id, std::string_view user_id) const {
+  const bool recent =
+      IsRecentWrite(request.GetCookie(std::string(kLastWriteCookie)),
+                    SystemClock::now(), replica_lag_) ||
+      recent_writes_.Contains(company_id, user_id, Clock::now());
+  return recent ? userver::storages::postgres::ClusterHostType::kMaster
+                : userver::storages::postgres::ClusterHostType::kSlave;
+}
+
+userver::yaml_config::Schema ReadRouter::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::LoggableComponentBase>(R"(
+type: object
+description: Routes reads to replicas unless the user has just written
+additionalProperties: false
+properties:
+    replica-lag:
+        type: string
+        description: upper bound of the replication lag
+    max-tracked-users:
+        type: integer
+        description: how many recent writers are remembered
+)");
+}
+
+}  // namespace core::read_routing
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <string_view>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/server/http/http_request.hpp>
+#include <userver/server/request/request_context.hpp>
+#include <userver/storages/postgres/cluster_types.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+#include "recent_writes.hpp"
+
+namespace core::read_routing {
+
+// Picks the host for reads of a user: replicas, unless the user wrote to the
+// master within the last `replica-lag` and may not see that write there yet.
+// The auth checker stores the host in the request context as "read_host",
+// handlers that write call MarkWrite with the same request once the write is
+// committed. The write is remembered by this instance and sent to the client
+// in a cookie, so the next request of the client is routed to the master by
+// any instance.
+class ReadRouter final : public userver::components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName = "read-router";
+
+  ReadRouter(const userver::components::ComponentConfig& config,
+             const userver::components::ComponentContext& context);
+
+  void MarkWrite(const userver::server::http::HttpRequest& request,
+                 const userver::server::request::RequestContext& context);
+
+  userver::storages::postgres::ClusterHostType ReadHost(
+      const userver::server::http::HttpRequest& request,
+      std::string_view company_id, std::string_view user_id) const;
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  const std::chrono::milliseconds replica_lag_;
+  RecentWrites recent_writes_;
+};
+
+}  // namespace core::read_routing
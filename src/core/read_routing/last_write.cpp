@@ -0,0 +1,27 @@
+#include "last_write.hpp"
+
+#include <charconv>
+#include <cstdint>
+
+namespace core::read_routing {
+
+std::string FormatLastWrite(SystemClock::time_point written) {
+  return std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
+                            written.time_since_epoch())
+                            .count());
+}
+
+bool IsRecentWrite(std::string_view last_write, SystemClock::time_point now,
+                   std::chrono::milliseconds replica_lag) {
+  std::int64_t millis = 0;
+  const auto* end = last_write.data() + last_write.size();
+  const auto [ptr, ec] = std::from_chars(last_write.data(), end, millis);
+  if (last_write.empty() || ec != std::errc{} || ptr != end) {
+    return false;
+  }
+  const SystemClock::time_point written{std::chrono::milliseconds{millis}};
+  // Clocks of the instances differ, but not by more than the lag
+  return written + replica_lag > now && written < now + replica_lag;
+}
+
+}  // namespace core::read_routing
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+namespace core::read_routing {
+
+using SystemClock = std::chrono::system_clock;
+
+// The client carries the time of its last write between instances in a
+// cookie, as milliseconds since the epoch
+inline constexpr std::string_view kLastWriteCookie = "last_write";
+
+std::string FormatLastWrite(SystemClock::time_point written);
+
+// Whether the cookie value tells of a write within `replica_lag` of `now`.
+// Malformed values and ones too far in the future are ignored.
+bool IsRecentWrite(std::string_view last_write, SystemClock::time_point now,
+                   std::chrono::milliseconds replica_lag);
+
+}  // namespace core::read_routing
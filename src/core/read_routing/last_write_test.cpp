@@ -0,0 +1,38 @@
+#include "last_write.hpp"
+
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+using core::read_routing::FormatLastWrite;
+using core::read_routing::IsRecentWrite;
+using std::chrono::milliseconds;
+
+const core::read_routing::SystemClock::time_point kNow{
+    std::chrono::hours{24 * 365 * 50}};
+
+}  // namespace
+
+UTEST(LastWrite, RecentWithinLag) {
+  const auto written = FormatLastWrite(kNow);
+  EXPECT_TRUE(IsRecentWrite(written, kNow, milliseconds{500}));
+  EXPECT_TRUE(
+      IsRecentWrite(written, kNow + milliseconds{499}, milliseconds{500}));
+  EXPECT_FALSE(
+      IsRecentWrite(written, kNow + milliseconds{500}, milliseconds{500}));
+
+  // Another instance may be a bit behind
+  EXPECT_TRUE(
+      IsRecentWrite(written, kNow - milliseconds{499}, milliseconds{500}));
+  EXPECT_FALSE(
+      IsRecentWrite(written, kNow - milliseconds{500}, milliseconds{500}));
+}
+
+UTEST(LastWrite, MalformedIgnored) {
+  EXPECT_FALSE(IsRecentWrite("", kNow, milliseconds{500}));
+  EXPECT_FALSE(IsRecentWrite("abc", kNow, milliseconds{500}));
+  EXPECT_FALSE(IsRecentWrite(FormatLastWrite(kNow) + "x", kNow,
+                             milliseconds{500}));
+  EXPECT_FALSE(IsRecentWrite("99999999999999999999999", kNow,
+                             milliseconds{500}));
+}
@@ -0,0 +1,45 @@
+#include "recent_writes.hpp"
+
+#include <mutex>
+
+namespace core::read_routing {
+
+namespace {
+
+std::string UserKey(std::string_view company_id, std::string_view user_id) {
+  std::string key;
+  key.reserve(company_id.size() + 1 + user_id.size());
+  key.append(company_id).append("/").append(user_id);
+  return key;
+}
+
+}  // namespace
+
+RecentWrites::RecentWrites(size_t max_size,
+                           std::chrono::milliseconds replica_lag)
+    : replica_lag_(replica_lag), writes_(max_size) {}
+
+void RecentWrites::Add(std::string_view company_id, std::string_view user_id,
+                       Clock::time_point now) {
+  auto key = UserKey(company_id, user_id);
+  std::lock_guard lock(mutex_);
+  writes_.Put(std::move(key), now);
+}
+
+bool RecentWrites::Contains(std::string_view company_id,
+                            std::string_view user_id,
+                            Clock::time_point now) const {
+  const auto key = UserKey(company_id, user_id);
+  std::lock_guard lock(mutex_);
+  const auto* written = writes_.Get(key);
+  if (written == nullptr) {
+    return false;
+  }
+  if (*written + replica_lag_ <= now) {
+    writes_.Erase(key);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace core::read_routing
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/engine/mutex.hpp>
+
+namespace core::read_routing {
+
+using Clock = std::chrono::steady_clock;
+
+// Users that wrote to the master recently enough for replicas to still be
+// behind. Only the last `max_size` writers are remembered, so the limit has
+// to cover every user writing within one `replica_lag`.
+class RecentWrites {
+ public:
+  RecentWrites(size_t max_size, std::chrono::milliseconds replica_lag);
+
+  void Add(std::string_view company_id, std::string_view user_id,
+           Clock::time_point now);
+
+  bool Contains(std::string_view company_id, std::string_view user_id,
+                Clock::time_point now) const;
+
+ private:
+  const std::chrono::milliseconds replica_lag_;
+
+  mutable userver::engine::Mutex mutex_;
+  mutable userver::cache::LruMap<std::string, Clock::time_point> writes_;
+};
+
+}  // namespace core::read_routing
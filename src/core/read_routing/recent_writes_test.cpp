@@ -0,0 +1,41 @@
+#include "recent_writes.hpp"
+
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+using std::chrono::milliseconds;
+
+const core::read_routing::Clock::time_point kNow{std::chrono::hours{1}};
+
+}  // namespace
+
+UTEST(RecentWrites, ForgottenAfterLag) {
+  core::read_routing::RecentWrites writes(10, milliseconds{500});
+  EXPECT_FALSE(writes.Contains("first", "first_id", kNow));
+
+  writes.Add("first", "first_id", kNow);
+  EXPECT_TRUE(writes.Contains("first", "first_id", kNow));
+  EXPECT_TRUE(writes.Contains("first", "first_id", kNow + milliseconds{499}));
+  EXPECT_FALSE(writes.Contains("first", "second_id", kNow));
+  EXPECT_FALSE(writes.Contains("second", "first_id", kNow));
+
+  EXPECT_FALSE(writes.Contains("first", "first_id", kNow + milliseconds{500}));
+  EXPECT_FALSE(writes.Contains("first", "first_id", kNow));
+
+  // A new write starts the lag over
+  writes.Add("first", "first_id", kNow);
+  writes.Add("first", "first_id", kNow + milliseconds{400});
+  EXPECT_TRUE(writes.Contains("first", "first_id", kNow + milliseconds{800}));
+}
+
+UTEST(RecentWrites, LeastRecentWriterEvicted) {
+  core::read_routing::RecentWrites writes(2, milliseconds{500});
+  writes.Add("first", "first_id", kNow);
+  writes.Add("first", "second_id", kNow);
+  writes.Add("first", "third_id", kNow);
+
+  EXPECT_FALSE(writes.Contains("first", "first_id", kNow));
+  EXPECT_TRUE(writes.Contains("first", "second_id", kNow));
+  EXPECT_TRUE(writes.Contains("first", "third_id", kNow));
+}
@@ -0,0 +1,146 @@
+#include "case_folding.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace core::reverse_index {
+
+namespace {
+
+using Utf8Pair = std::array<unsigned char, 2>;
+
+constexpr Utf8Pair Encode(uint32_t code_point) {
+  return {static_cast<unsigned char>(0xC0 | (code_point >> 6)),
+          static_cast<unsigned char>(0x80 | (code_point & 0x3F))};
+}
+
+constexpr uint32_t FoldCyrillic(uint32_t code_point) {
+  if (code_point == 0x401 || code_point == 0x451) {
+    return 0x435;  // Ё, ё -> е
+  }
+  if (code_point >= 0x400 && code_point < 0x410) {
+    return code_point + 0x50;
+  }
+  if (code_point >= 0x410 && code_point < 0x430) {
+    return code_point + 0x20;
+  }
+  return code_point;
+}
+
+// Folded two-byte sequences for U+0400..U+047F indexed by the code point
+// offset, lead bytes 0xD0 and 0xD1 cover exactly this range
+constexpr auto kCyrillic = [] {
+  std::array<Utf8Pair, 128> table{};
+  for (uint32_t i = 0; i < table.size(); ++i) {
+    table[i] = Encode(FoldCyrillic(0x400 + i));
+  }
+  return table;
+}();
+
+constexpr bool IsContinuation(unsigned char byte) {
+  return (byte & 0xC0) == 0x80;
+}
+
+constexpr unsigned char FoldAscii(unsigned char byte) {
+  return byte >= 'A' && byte <= 'Z' ? byte + ('a' - 'A') : byte;
+}
+
+#if defined(__SSE2__)
+constexpr size_t kBlockSize = 16;
+
+// Folds a block if it is pure ASCII, returns false otherwise
+bool FoldAsciiBlock(const unsigned char* input, unsigned char* output) {
+  const auto block =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+  if (_mm_movemask_epi8(block) != 0) {
+    return false;
+  }
+  // Signed comparisons are fine since all bytes are below 0x80
+  const auto upper =
+      _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)),
+                    _mm_cmplt_epi8(block, _mm_set1_epi8('Z' + 1)));
+  const auto folded =
+      _mm_add_epi8(block, _mm_and_si128(upper, _mm_set1_epi8('a' - 'A')));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(output), folded);
+  return true;
+}
+#else
+constexpr size_t kBlockSize = 8;
+
+// SWAR fallback: the same ASCII check and fold on 8 bytes at once
+bool FoldAsciiBlock(const unsigned char* input, unsigned char* output) {
+  constexpr uint64_t kOnes = 0x0101010101010101ULL;
+  constexpr uint64_t kHigh = 0x8080808080808080ULL;
+
+  uint64_t block = 0;
+  std::memcpy(&block, input, sizeof(block));
+  if ((block & kHigh) != 0) {
+    return false;
+  }
+  // High bit of every byte is set iff the byte is in 'A'..'Z'
+  const auto upper = ((block + kOnes * (0x80 - 'A')) ^
+                      (block + kOnes * (0x80 - 'Z' - 1))) &
+                     kHigh;
+  block += upper >> 2;
+  std::memcpy(output, &block, sizeof(block));
+  return true;
+}
+#endif
+
+}  // namespace
+
+void FoldCase(std::string_view input, char* output) {
+  const auto* in = reinterpret_cast<const unsigned char*>(input.data());
+  auto* out = reinterpret_cast<unsigned char*>(output);
+  const size_t size = input.size();
+
+  size_t i = 0;
+  while (i < size) {
+    if (size - i >= kBlockSize && FoldAsciiBlock(in + i, out + i)) {
+      i += kBlockSize;
+      continue;
+    }
+
+    const auto byte = in[i];
+    if (byte < 0x80) {
+      out[i] = FoldAscii(byte);
+      ++i;
+      continue;
+    }
+
+    if (i + 1 < size && IsContinuation(in[i + 1])) {
+      const auto next = in[i + 1];
+      if (byte == 0xD0 || byte == 0xD1) {
+        const auto& folded = kCyrillic[((byte & 1) << 6) | (next & 0x3F)];
+        out[i] = folded[0];
+        out[i + 1] = folded[1];
+        i += 2;
+        continue;
+      }
+      if (byte == 0xC3) {
+        // À..Þ except × -> à..þ
+        const bool upper = next >= 0x80 && next <= 0x9E && next != 0x97;
+        out[i] = byte;
+        out[i + 1] = upper ? next + 0x20 : next;
+        i += 2;
+        continue;
+      }
+    }
+
+    out[i] = byte;
+    ++i;
+  }
+}
+
+std::string FoldCase(std::string_view input) {
+  std::string result(input.size(), '\0');
+  FoldCase(input, result.data());
+  return result;
+}
+
+}  // namespace core::reverse_index
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace core::reverse_index {
+
+// Lowercases Latin (ASCII and Latin-1) and Cyrillic letters of a UTF-8 string
+// and folds ё into е. Other bytes, including malformed sequences, are copied
+// as is. Folding never changes the length, so exactly input.size() bytes are
+// written to `output`, which may also point to the input itself.
+void FoldCase(std::string_view input, char* output);
+
+std::string FoldCase(std::string_view input);
+
+}  // namespace core::reverse_index
@@ -0,0 +1,32 @@
+#include "case_folding.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+constexpr std::string_view kKeys[] = {
+    "Seventh",        "ivan.petrov@mail.com", "+7 (999) 123-45-67",
+    "Иванов",         "АЛЕКСАНДРОВНА",        "Фёдор",
+    "Development",    "@telegram_handle",     "1990-01-01",
+    "Платформа Core",
+};
+
+}  // namespace
+
+void FoldCaseBenchmark(benchmark::State& state) {
+  std::string buffer;
+  std::uint64_t i = 0;
+  for (auto _ : state) {
+    const auto key = kKeys[i++ % std::size(kKeys)];
+    buffer.resize(key.size());
+    core::reverse_index::FoldCase(key, buffer.data());
+    benchmark::DoNotOptimize(buffer.data());
+  }
+}
+
+BENCHMARK(FoldCaseBenchmark);
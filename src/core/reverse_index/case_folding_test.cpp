@@ -0,0 +1,37 @@
+#include "case_folding.hpp"
+
+#include <userver/utest/utest.hpp>
+
+UTEST(ReverseIndexFoldCase, Latin) {
+  using core::reverse_index::FoldCase;
+
+  EXPECT_EQ(FoldCase(""), "");
+  EXPECT_EQ(FoldCase("SEVenth F"), "seventh f");
+  EXPECT_EQ(FoldCase("2@Mail.COM"), "2@mail.com");
+  EXPECT_EQ(FoldCase("ABCDEFGHIJKLMNOPQRSTUVWXYZ[@`{ abcdefghijklmnopqrstuvwxyz"),
+            "abcdefghijklmnopqrstuvwxyz[@`{ abcdefghijklmnopqrstuvwxyz");
+  EXPECT_EQ(FoldCase("ÀÉÎÕÜ×ß"), "àéîõü×ß");
+}
+
+UTEST(ReverseIndexFoldCase, Cyrillic) {
+  using core::reverse_index::FoldCase;
+
+  EXPECT_EQ(FoldCase("АБВГДЕЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ"),
+            "абвгдежзийклмнопрстуфхцчшщъыьэюя");
+  EXPECT_EQ(FoldCase("Ёлка ёж"), "елка еж");
+  EXPECT_EQ(FoldCase("ЄІЇЎЂ"), "єіїўђ");
+  EXPECT_EQ(FoldCase("Иван Petrov IVANOVICH ПЕТРОВ"),
+            "иван petrov ivanovich петров");
+}
+
+UTEST(ReverseIndexFoldCase, KeepsOtherBytes) {
+  using core::reverse_index::FoldCase;
+
+  EXPECT_EQ(FoldCase("ΑΒΓ 日本 🙂"), "ΑΒΓ 日本 🙂");
+  EXPECT_EQ(FoldCase("\xD0"), "\xD0");
+  EXPECT_EQ(FoldCase("A\xD0Z"), "a\xD0z");
+
+  std::string buffer = "LONG ENOUGH FOR A BLOCK, Ж";
+  core::reverse_index::FoldCase(buffer, buffer.data());
+  EXPECT_EQ(buffer, "long enough for a block, ж");
+}
@@ -0,0 +1,381 @@
+#include "pipeline.hpp"
+
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+
+#include <userver/components/statistics_storage.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/postgres/component.hpp>
+#include <userver/storages/postgres/io/array_types.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include "core/job_queue/retry.hpp"
+#include "core/tenant_query/query.hpp"
+
+namespace core::reverse_index {
+
+namespace {
+
+constexpr size_t kDefaultQueueSize = 10000;
+constexpr std::chrono::milliseconds kDefaultPushTimeout{1000};
+constexpr std::chrono::milliseconds kDefaultBatchWindow{50};
+constexpr size_t kDefaultMaxBatchSize = 1000;
+constexpr int kWriteAttempts = 3;
+constexpr std::chrono::milliseconds kRetryDelay{100};
+constexpr std::chrono::milliseconds kMaxRetryDelay{10000};
+
+const core::tenant_query::TenantQuery kDeletePostings{
+    "reverse_index_delete_postings",
+    "DELETE FROM {schema}.reverse_index_postings AS p "
+    "USING unnest($1::text[], $2::text[]) AS d(key, id), "
+    "{schema}.reverse_index_terms AS t, {schema}.employees AS e "
+    "WHERE t.key = d.key AND e.id = d.id "
+    "AND p.term_id = t.id AND p.ordinal = e.ordinal"};
+
+const core::tenant_query::TenantQuery kDeleteTerms{
+    "reverse_index_delete_terms",
+    "DELETE FROM {schema}.reverse_index_terms AS t "
+    "WHERE t.key = ANY($1) AND NOT EXISTS ("
+    "SELECT 1 FROM {schema}.reverse_index_postings AS p "
+    "WHERE p.term_id = t.id)"};
+
+const core::tenant_query::TenantQuery kInsertTerms{
+    "reverse_index_insert_terms",
+    "INSERT INTO {schema}.reverse_index_terms (key) "
+    "SELECT DISTINCT key FROM unnest($1::text[]) AS key "
+    "ORDER BY key "
+    "ON CONFLICT (key) DO NOTHING"};
+
+const core::tenant_query::TenantQuery kInsertPostings{
+    "reverse_index_insert_postings",
+    "INSERT INTO {schema}.reverse_index_postings (term_id, ordinal) "
+    "SELECT t.id, e.ordinal "
+    "FROM unnest($1::text[], $2::text[]) AS d(key, id) "
+    "JOIN {schema}.reverse_index_terms AS t ON t.key = d.key "
+    "JOIN {schema}.employees AS e ON e.id = d.id "
+    "ON CONFLICT DO NOTHING"};
+
+std::string EmployeeKey(const IndexDelta& delta) {
+  std::string key;
+  key.reserve(delta.company_id.size() + 1 + delta.employee_id.size());
+  key.append(delta.company_id).append("/").append(delta.employee_id);
+  return key;
+}
+
+}  // namespace
+
+Pipeline::Pipeline(const userver::components::ComponentConfig& config,
+                   const userver::components::ComponentContext& context)
+    : LoggableComponentBase(config, context),
+      pg_cluster_(
+          context.FindComponent<userver::components::Postgres>("key-value")
+              .GetCluster()),
+      push_timeout_(config["push-timeout"].As<std::chrono::milliseconds>(
+          kDefaultPushTimeout)),
+      batch_window_(config["batch-window"].As<std::chrono::milliseconds>(
+          kDefaultBatchWindow)),
+      max_batch_size_(
+          config["max-batch-size"].As<size_t>(kDefaultMaxBatchSize)),
+      max_retained_(config["queue-size"].As<size_t>(kDefaultQueueSize)),
+      queue_(Queue::Create(max_retained_)),
+      producer_(queue_->GetProducer()) {
+  writer_task_ = userver::utils::CriticalAsync(
+      "reverse-index-writer",
+      [this, consumer = queue_->GetConsumer()]() mutable {
+        RunWriter(std::move(consumer));
+      });
+
+  statistics_entry_ =
+      context.FindComponent<userver::components::StatisticsStorage>()
+          .GetStorage()
+          .RegisterWriter("reverse-index-pipeline",
+                          [this](userver::utils::statistics::Writer& writer) {
+                            WriteStatistics(writer);
+                          });
+}
+
+Pipeline::~Pipeline() {
+  statistics_entry_.Unregister();
+
+  // The writer stops once the queue is empty and has no producers left
+  stopping_ = true;
+  producer_.reset();
+  writer_task_.Get();
+}
+
+void Pipeline::Push(IndexDelta delta) {
+  if (delta.removed_keys.empty() && delta.added_keys.empty()) {
+    return;
+  }
+  ++pushed_;
+
+  const auto key = EmployeeKey(delta);
+  {
+    std::lock_guard lock(queued_mutex_);
+    ++queued_[key];
+  }
+
+  QueueItem item{delta, std::nullopt};
+  if (producer_->Push(std::move(item),
+                      userver::engine::Deadline::FromDuration(push_timeout_))) {
+    return;
+  }
+
+  // Written now, the delta would be overwritten by the earlier ones still in
+  // the queue
+  bool earlier_queued = false;
+  {
+    std::lock_guard lock(queued_mutex_);
+    auto it = queued_.find(key);
+    earlier_queued = it->second > 1;
+    if (!earlier_queued) {
+      queued_.erase(it);
+    }
+  }
+  if (earlier_queued) {
+    LOG_WARNING() << "Reverse index queue is full, the update of "
+                  << delta.employee_id << " waits for earlier ones";
+    producer_->Push({std::move(delta), std::nullopt});
+    return;
+  }
+
+  LOG_WARNING() << "Reverse index queue is full, writing the update of "
+                << delta.employee_id << " synchronously";
+  ++sync_writes_;
+  WriteCompany(delta.company_id, {&delta});
+  ++written_;
+}
+
+void Pipeline::Flush() {
+  userver::engine::Promise<void> flushed;
+  auto future = flushed.get_future();
+  producer_->Push({std::nullopt, std::move(flushed)});
+  future.get();
+}
+
+void Pipeline::RunWriter(Queue::Consumer consumer) {
+  QueueItem item;
+  while (true) {
+    bool popped = false;
+    if (retained_.empty()) {
+      popped = consumer.Pop(item);
+      if (!popped) {
+        break;
+      }
+    } else {
+      // Retained updates are written again with the next batch, or alone
+      // once the backoff passes
+      popped = consumer.Pop(
+          item, userver::engine::Deadline::FromDuration(
+                    core::job_queue::RetryDelay(retained_rounds_, kRetryDelay,
+                                                kMaxRetryDelay)));
+      if (!popped && stopping_) {
+        break;
+      }
+    }
+
+    std::vector<IndexDelta> batch;
+    std::vector<userver::engine::Promise<void>> flushed;
+    const auto deadline = userver::engine::Deadline::FromDuration(batch_window_);
+
+    while (popped) {
+      if (item.delta.has_value()) {
+        batch.push_back(std::move(item.delta.value()));
+      }
+      if (item.flushed.has_value()) {
+        flushed.push_back(std::move(item.flushed.value()));
+        break;
+      }
+      item = {};
+      if (batch.size() >= max_batch_size_ || !consumer.Pop(item, deadline)) {
+        break;
+      }
+    }
+
+    WriteBatch(std::move(batch));
+    for (auto& promise : flushed) {
+      promise.set_value();
+    }
+    item = {};
+  }
+
+  if (!retained_.empty()) {
+    WriteBatch({});
+  }
+  if (!retained_.empty()) {
+    LOG_ERROR() << "Dropped " << retained_.size()
+                << " reverse index updates that could not be written";
+    dropped_ += retained_.size();
+  }
+}
+
+void Pipeline::WriteBatch(std::vector<IndexDelta> batch) {
+  // Retained updates are older than the batch and go first
+  if (!retained_.empty()) {
+    batch.insert(batch.begin(), std::make_move_iterator(retained_.begin()),
+                 std::make_move_iterator(retained_.end()));
+    retained_.clear();
+  }
+  if (batch.empty()) {
+    return;
+  }
+
+  std::map<std::string, std::vector<const IndexDelta*>> companies;
+  for (const auto& delta : batch) {
+    companies[delta.company_id].push_back(&delta);
+  }
+
+  std::vector<userver::engine::TaskWithResult<bool>> tasks;
+  tasks.reserve(companies.size());
+  for (const auto& [company_id, deltas] : companies) {
+    tasks.push_back(userver::utils::Async(
+        "reverse-index-write-company", [this, &company_id, &deltas] {
+          return TryWriteCompany(company_id, deltas);
+        }));
+  }
+  std::unordered_set<std::string> failed;
+  auto task = tasks.begin();
+  for (const auto& [company_id, deltas] : companies) {
+    if (!(task++)->Get()) {
+      failed.insert(company_id);
+    }
+  }
+
+  size_t written = 0;
+  for (auto& delta : batch) {
+    if (failed.count(delta.company_id) > 0) {
+      retained_.push_back(std::move(delta));
+    } else {
+      Release(delta);
+      ++written;
+    }
+  }
+  if (retained_.size() > max_retained_) {
+    const auto excess = retained_.size() - max_retained_;
+    LOG_ERROR() << "Dropped " << excess
+                << " oldest reverse index updates that could not be written";
+    for (auto it = retained_.begin(); it != retained_.begin() + excess; ++it) {
+      Release(*it);
+    }
+    retained_.erase(retained_.begin(), retained_.begin() + excess);
+    dropped_ += excess;
+  }
+  retained_rounds_ = retained_.empty() ? 0 : retained_rounds_ + 1;
+
+  ++batches_;
+  written_ += written;
+}
+
+bool Pipeline::TryWriteCompany(const std::string& company_id,
+                               const std::vector<const IndexDelta*>& deltas) {
+  for (int attempt = 1; attempt <= kWriteAttempts; ++attempt) {
+    try {
+      WriteCompany(company_id, deltas);
+      return true;
+    } catch (const std::exception& e) {
+      LOG_ERROR() << "Failed to write " << deltas.size()
+                  << " reverse index updates of company " << company_id
+                  << ", attempt " << attempt << ": " << e.what();
+    }
+    if (attempt < kWriteAttempts) {
+      userver::engine::InterruptibleSleepFor(
+          core::job_queue::RetryDelay(attempt, kRetryDelay, kMaxRetryDelay));
+    }
+  }
+  ++failures_;
+  return false;
+}
+
+void Pipeline::Release(const IndexDelta& delta) {
+  const auto key = EmployeeKey(delta);
+  std::lock_guard lock(queued_mutex_);
+  auto it = queued_.find(key);
+  if (it != queued_.end() && --it->second == 0) {
+    queued_.erase(it);
+  }
+}
+
+void Pipeline::WriteCompany(const std::string& company_id,
+                            const std::vector<const IndexDelta*>& deltas) {
+  // Only the last change of every (key, employee) pair matters, the map also
+  // keeps rows in key order so that concurrent batches lock them in one order
+  std::map<std::pair<std::string, std::string>, bool> changes;
+  for (const auto* delta : deltas) {
+    for (const auto& key : delta->removed_keys) {
+      changes[{key, delta->employee_id}] = false;
+    }
+    for (const auto& key : delta->added_keys) {
+      changes[{key, delta->employee_id}] = true;
+    }
+  }
+
+  std::vector<std::string> removed_keys, removed_ids, added_keys, added_ids;
+  for (const auto& [change, added] : changes) {
+    auto& keys = added ? added_keys : removed_keys;
+    auto& ids = added ? added_ids : removed_ids;
+    keys.push_back(change.first);
+    ids.push_back(change.second);
+  }
+
+  auto trx = pg_cluster_->Begin(
+      "reverse_index_batch",
+      userver::storages::postgres::ClusterHostType::kMaster, {});
+
+  if (!removed_keys.empty()) {
+    trx.Execute(kDeletePostings.For(company_id), removed_keys, removed_ids);
+    trx.Execute(kDeleteTerms.For(company_id), removed_keys);
+  }
+
+  if (!added_keys.empty()) {
+    trx.Execute(kInsertTerms.For(company_id), added_keys);
+    trx.Execute(kInsertPostings.For(company_id), added_keys, added_ids);
+  }
+
+  trx.Commit();
+}
+
+void Pipeline::WriteStatistics(
+    userver::utils::statistics::Writer& writer) const {
+  writer["queue-size"] = queue_->GetSizeApproximate();
+  writer["pushed"] = pushed_.load();
+  writer["written"] = written_.load();
+  writer["batches"] = batches_.load();
+  writer["sync-writes"] = sync_writes_.load();
+  writer["failed-batches"] = failures_.load();
+  writer["dropped"] = dropped_.load();
+}
+
+userver::yaml_config::Schema Pipeline::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::LoggableComponentBase>(R"(
+type: object
+description: Batched writer of reverse index updates
+additionalProperties: false
+properties:
+    queue-size:
+        type: integer
+        description: max number of updates waiting to be written
+        defaultDescription: 10000
+    push-timeout:
+        type: string
+        description: how long a handler waits for a full queue before writing its update itself
+        defaultDescription: 1s
+    batch-window:
+        type: string
+        description: how long the writer collects updates into one batch
+        defaultDescription: 50ms
+    max-batch-size:
+        type: integer
+        description: max number of updates in one batch
+        defaultDescription: 1000
+)");
+}
+
+}  // namespace core::reverse_index
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/future.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/utils/statistics/entry.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+namespace core::reverse_index {
+
+// Keys are expected to be lowercased already
+struct IndexDelta {
+  std::string company_id;
+  std::string employee_id;
+  std::vector<std::string> removed_keys;
+  std::vector<std::string> added_keys;
+};
+
+// Reverse index updates go through a bounded queue to a single writer that
+// coalesces them per company and writes one batch per company at a time.
+// A company batch that still fails after a few attempts with backoff is kept
+// and written before newer updates of the company, so the updates of every
+// employee are applied in the order they were pushed. Remaining updates are
+// written before the component is destroyed.
+class Pipeline final : public userver::components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName = "reverse-index-pipeline";
+
+  Pipeline(const userver::components::ComponentConfig& config,
+           const userver::components::ComponentContext& context);
+
+  ~Pipeline() override;
+
+  // Blocks for at most push-timeout if the queue is full, then writes the
+  // delta in the calling coroutine. If earlier updates of the employee are
+  // still queued the delta waits for space in the queue instead.
+  void Push(IndexDelta delta);
+
+  // Waits until everything pushed before the call is written or kept for
+  // the next attempt
+  void Flush();
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  struct QueueItem {
+    std::optional<IndexDelta> delta;
+    std::optional<userver::engine::Promise<void>> flushed;
+  };
+
+  using Queue = userver::concurrent::MpscQueue<QueueItem>;
+
+  void RunWriter(Queue::Consumer consumer);
+  void WriteBatch(std::vector<IndexDelta> batch);
+  bool TryWriteCompany(const std::string& company_id,
+                       const std::vector<const IndexDelta*>& deltas);
+  void Release(const IndexDelta& delta);
+  void WriteCompany(const std::string& company_id,
+                    const std::vector<const IndexDelta*>& deltas);
+  void WriteStatistics(userver::utils::statistics::Writer& writer) const;
+
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+  const std::chrono::milliseconds push_timeout_;
+  const std::chrono::milliseconds batch_window_;
+  const size_t max_batch_size_;
+  const size_t max_retained_;
+
+  std::shared_ptr<Queue> queue_;
+  std::optional<Queue::Producer> producer_;
+  std::atomic<bool> stopping_{false};
+
+  // Number of queued or retained updates per "<company>/<employee>"
+  userver::engine::Mutex queued_mutex_;
+  std::unordered_map<std::string, size_t> queued_;
+
+  // Owned by the writer: updates of the companies whose last batch failed,
+  // in the order they were pushed
+  std::vector<IndexDelta> retained_;
+  int retained_rounds_ = 0;
+
+  std::atomic<uint64_t> pushed_{0};
+  std::atomic<uint64_t> written_{0};
+  std::atomic<uint64_t> batches_{0};
+  std::atomic<uint64_t> sync_writes_{0};
+  std::atomic<uint64_t> failures_{0};
+  std::atomic<uint64_t> dropped_{0};
+
+  userver::engine::TaskWithResult<void> writer_task_;
+  userver::utils::statistics::Entry statistics_entry_;
+};
+
+}  // namespace core::reverse_index
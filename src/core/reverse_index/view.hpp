@@ -1,18 +1,8 @@
 #pragma once
 
-#include <codecvt>
-#include <initializer_list>
-#include <locale>
+#include <optional>
 #include <string>
-#include <string_view>
-
-#include <nlohmann/json.hpp>
-
-#include <userver/components/component_list.hpp>
-#include <userver/storages/postgres/cluster.hpp>
-#include <userver/storages/postgres/component.hpp>
-
-#include <core/json_compatible/struct.hpp>
+#include <vector>
 
 namespace core::reverse_index {
 
@@ -24,24 +14,7 @@ class EmployeeAllData {
   std::optional<std::vector<std::string>> phones;
 };
 
-std::string ConvertToLower(std::string s);
-
-class ReverseIndexResponse : public JsonCompatible {
- public:
-  ReverseIndexResponse(const std::string& worker_id) {
-    employee_id = worker_id;
-  }
-
-  REGISTER_STRUCT_FIELD(employee_id, std::string, "employee_id");
-};
-
-class ReverseIndexRequest {
- public:
-  std::function<ReverseIndexResponse()> func;
-};
-
-void ReverseIndexHandler(const ReverseIndexRequest& request);
-
-void ClearTasks();
+// Lowercased values of the fields that are put into the reverse index
+std::vector<std::string> IndexedKeys(const EmployeeAllData& data);
 
 }  // namespace core::reverse_index
\ No newline at end of file
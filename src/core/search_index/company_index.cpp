@@ -0,0 +1,327 @@
+#include "company_index.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_set>
+
+namespace core::search_index {
+
+namespace {
+
+template <class T>
+bool InsertSorted(std::vector<T>& values, T value) {
+  auto it = std::lower_bound(values.begin(), values.end(), value);
+  if (it != values.end() && *it == value) {
+    return false;
+  }
+  values.insert(it, value);
+  return true;
+}
+
+template <class T>
+void EraseSorted(std::vector<T>& values, T value) {
+  auto it = std::lower_bound(values.begin(), values.end(), value);
+  if (it != values.end() && *it == value) {
+    values.erase(it);
+  }
+}
+
+template <class T>
+void EraseUnordered(std::vector<T>& values, T value) {
+  auto it = std::find(values.begin(), values.end(), value);
+  if (it != values.end()) {
+    *it = values.back();
+    values.pop_back();
+  }
+}
+
+}  // namespace
+
+CompanyIndex::CompanyIndex(size_t suggest_top_size)
+    : trie_(
+          suggest_top_size,
+          [this](DocId lhs, DocId rhs) { return LessById(lhs, rhs); },
+          [this](TermId term_id) -> const std::vector<DocId>& {
+            return terms_[term_id].postings;
+          }) {}
+
+void CompanyIndex::UpsertEmployee(EmployeeCard card) {
+  std::unique_lock lock(mutex_);
+  auto doc_id = GetOrCreateDoc(card.id);
+  docs_[doc_id].card = std::move(card);
+}
+
+void CompanyIndex::RemoveEmployee(const std::string& employee_id) {
+  std::unique_lock lock(mutex_);
+  auto doc_id = FindDoc(employee_id);
+  if (!doc_id.has_value()) {
+    return;
+  }
+
+  auto& doc = docs_[*doc_id];
+  for (auto term_id : doc.terms) {
+    auto& term = terms_[term_id];
+    EraseSorted(term.postings, *doc_id);
+    trie_.RemovePosting(term.key, *doc_id, term.postings.empty());
+    if (term.postings.empty()) {
+      ReleaseTerm(term_id);
+    }
+  }
+  doc = Document{};
+  doc_ids_.erase(employee_id);
+  free_docs_.push_back(*doc_id);
+}
+
+void CompanyIndex::SetPhotoLink(const std::string& employee_id,
+                                std::optional<std::string> photo_link) {
+  std::unique_lock lock(mutex_);
+  auto doc_id = FindDoc(employee_id);
+  if (doc_id.has_value()) {
+    docs_[*doc_id].card.photo_link = std::move(photo_link);
+  }
+}
+
+void CompanyIndex::AddKeys(const std::string& employee_id,
+                           const std::vector<std::string>& keys) {
+  std::unique_lock lock(mutex_);
+  auto doc_id = GetOrCreateDoc(employee_id);
+  for (const auto& key : keys) {
+    LinkTerm(doc_id, key);
+  }
+}
+
+void CompanyIndex::RemoveKeys(const std::string& employee_id,
+                              const std::vector<std::string>& keys) {
+  std::unique_lock lock(mutex_);
+  auto doc_id = FindDoc(employee_id);
+  if (!doc_id.has_value()) {
+    return;
+  }
+
+  for (const auto& key : keys) {
+    auto it = term_ids_.find(key);
+    if (it != term_ids_.end()) {
+      UnlinkTerm(*doc_id, it->second);
+    }
+  }
+}
+
+void CompanyIndex::ReplaceEmployee(EmployeeCard card,
+                                   const std::vector<std::string>& keys) {
+  std::unique_lock lock(mutex_);
+  auto doc_id = GetOrCreateDoc(card.id);
+  docs_[doc_id].card = std::move(card);
+
+  const std::unordered_set<std::string_view> kept(keys.begin(), keys.end());
+  const auto terms = docs_[doc_id].terms;
+  for (auto term_id : terms) {
+    if (kept.count(terms_[term_id].key) == 0) {
+      UnlinkTerm(doc_id, term_id);
+    }
+  }
+  for (const auto& key : keys) {
+    LinkTerm(doc_id, key);
+  }
+}
+
+std::vector<EmployeeCard> CompanyIndex::Search(
+    const std::vector<std::string>& search_keys, size_t limit) const {
+  std::shared_lock lock(mutex_);
+
+  std::unordered_map<DocId, double> scores;
+  std::unordered_map<TermId, uint32_t> shared;
+  for (const auto& search_key : search_keys) {
+    auto trigrams = ExtractTrigrams(search_key);
+
+    shared.clear();
+    for (auto trigram : trigrams) {
+      auto it = trigram_ids_.find(trigram);
+      if (it == trigram_ids_.end()) {
+        continue;
+      }
+      for (auto term_id : trigram_terms_[it->second]) {
+        ++shared[term_id];
+      }
+    }
+
+    for (const auto& [term_id, count] : shared) {
+      const auto& term = terms_[term_id];
+      double similarity =
+          Similarity(count, trigrams.size(), term.trigrams.size());
+      if (similarity <= kSimilarityThreshold) {
+        continue;
+      }
+      for (auto doc_id : term.postings) {
+        scores[doc_id] += similarity;
+      }
+    }
+  }
+
+  std::vector<std::pair<DocId, double>> ranked(scores.begin(), scores.end());
+  limit = std::min(limit, ranked.size());
+  std::partial_sort(ranked.begin(), ranked.begin() + limit, ranked.end(),
+                    [this](const auto& left, const auto& right) {
+                      if (left.second != right.second) {
+                        return left.second > right.second;
+                      }
+                      return docs_[left.first].card.id <
+                             docs_[right.first].card.id;
+                    });
+
+  std::vector<EmployeeCard> result;
+  result.reserve(limit);
+  for (size_t i = 0; i < limit; ++i) {
+    result.push_back(docs_[ranked[i].first].card);
+  }
+  return result;
+}
+
+std::vector<EmployeeCard> CompanyIndex::Suggest(
+    const std::vector<std::string>& exact_keys, const std::string& prefix,
+    size_t limit) const {
+  std::shared_lock lock(mutex_);
+
+  std::vector<DocId> docs;
+  if (exact_keys.empty()) {
+    docs = trie_.Top(prefix, limit);
+  } else {
+    std::vector<DocId> candidates;
+    for (size_t i = 0; i < exact_keys.size(); ++i) {
+      auto it = term_ids_.find(exact_keys[i]);
+      if (it == term_ids_.end()) {
+        return {};
+      }
+      const auto& postings = terms_[it->second].postings;
+      if (i == 0) {
+        candidates = postings;
+        continue;
+      }
+      std::vector<DocId> intersection;
+      std::set_intersection(candidates.begin(), candidates.end(),
+                            postings.begin(), postings.end(),
+                            std::back_inserter(intersection));
+      candidates = std::move(intersection);
+    }
+
+    for (auto doc_id : candidates) {
+      const auto& terms = docs_[doc_id].terms;
+      if (std::any_of(terms.begin(), terms.end(), [&](TermId term_id) {
+            return terms_[term_id].key.starts_with(prefix);
+          })) {
+        docs.push_back(doc_id);
+      }
+    }
+
+    limit = std::min(limit, docs.size());
+    std::partial_sort(
+        docs.begin(), docs.begin() + limit, docs.end(),
+        [this](DocId lhs, DocId rhs) { return LessById(lhs, rhs); });
+    docs.resize(limit);
+  }
+
+  std::vector<EmployeeCard> result;
+  result.reserve(docs.size());
+  for (auto doc_id : docs) {
+    result.push_back(docs_[doc_id].card);
+  }
+  return result;
+}
+
+size_t CompanyIndex::EmployeesCount() const {
+  std::shared_lock lock(mutex_);
+  return doc_ids_.size();
+}
+
+bool CompanyIndex::LessById(DocId lhs, DocId rhs) const {
+  return docs_[lhs].card.id < docs_[rhs].card.id;
+}
+
+std::optional<CompanyIndex::DocId> CompanyIndex::FindDoc(
+    const std::string& employee_id) const {
+  auto it = doc_ids_.find(employee_id);
+  if (it == doc_ids_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+CompanyIndex::DocId CompanyIndex::GetOrCreateDoc(
+    const std::string& employee_id) {
+  if (auto doc_id = FindDoc(employee_id); doc_id.has_value()) {
+    return *doc_id;
+  }
+
+  DocId doc_id;
+  if (!free_docs_.empty()) {
+    doc_id = free_docs_.back();
+    free_docs_.pop_back();
+  } else {
+    doc_id = docs_.size();
+    docs_.emplace_back();
+  }
+
+  docs_[doc_id].card.id = employee_id;
+  doc_ids_.emplace(employee_id, doc_id);
+  return doc_id;
+}
+
+CompanyIndex::TermId CompanyIndex::GetOrCreateTerm(const std::string& key) {
+  if (auto it = term_ids_.find(key); it != term_ids_.end()) {
+    return it->second;
+  }
+
+  TermId term_id;
+  if (!free_terms_.empty()) {
+    term_id = free_terms_.back();
+    free_terms_.pop_back();
+  } else {
+    term_id = terms_.size();
+    terms_.emplace_back();
+  }
+
+  auto& term = terms_[term_id];
+  term.key = key;
+  for (auto trigram : ExtractTrigrams(key)) {
+    auto [it, inserted] = trigram_ids_.emplace(trigram, trigram_terms_.size());
+    if (inserted) {
+      trigram_terms_.emplace_back();
+    }
+    term.trigrams.push_back(it->second);
+    trigram_terms_[it->second].push_back(term_id);
+  }
+  term_ids_.emplace(key, term_id);
+  return term_id;
+}
+
+void CompanyIndex::ReleaseTerm(TermId term_id) {
+  auto& term = terms_[term_id];
+  for (auto trigram_id : term.trigrams) {
+    EraseUnordered(trigram_terms_[trigram_id], term_id);
+  }
+  term_ids_.erase(term.key);
+  term = Term{};
+  free_terms_.push_back(term_id);
+}
+
+void CompanyIndex::LinkTerm(DocId doc_id, const std::string& key) {
+  auto term_id = GetOrCreateTerm(key);
+  if (InsertSorted(terms_[term_id].postings, doc_id)) {
+    trie_.AddPosting(terms_[term_id].key, term_id, doc_id);
+  }
+  InsertSorted(docs_[doc_id].terms, term_id);
+}
+
+void CompanyIndex::UnlinkTerm(DocId doc_id, TermId term_id) {
+  EraseSorted(docs_[doc_id].terms, term_id);
+  auto& term = terms_[term_id];
+  EraseSorted(term.postings, doc_id);
+  trie_.RemovePosting(term.key, doc_id, term.postings.empty());
+  if (term.postings.empty()) {
+    ReleaseTerm(term_id);
+  }
+}
+
+}  // namespace core::search_index
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/engine/shared_mutex.hpp>
+
+#include "prefix_trie.hpp"
+#include "trigrams.hpp"
+
+namespace core::search_index {
+
+struct EmployeeCard {
+  std::string id;
+  std::string name;
+  std::string surname;
+  std::optional<std::string> patronymic;
+  std::optional<std::string> photo_link;
+};
+
+// Inverted index over reverse index keys of one company. Keys are interned
+// into a term dictionary, every term keeps its trigrams and a sorted posting
+// list of compact document ids. Terms are also put into a prefix trie for
+// suggests.
+class CompanyIndex {
+ public:
+  using DocId = PrefixTrie::DocId;
+  using TermId = PrefixTrie::TermId;
+
+  // Same threshold as `similarity(search_key, key) > 0.4` in SQL
+  static constexpr double kSimilarityThreshold = 0.4;
+
+  static constexpr size_t kDefaultSuggestTopSize = 32;
+
+  explicit CompanyIndex(size_t suggest_top_size = kDefaultSuggestTopSize);
+
+  void UpsertEmployee(EmployeeCard card);
+
+  void RemoveEmployee(const std::string& employee_id);
+
+  void SetPhotoLink(const std::string& employee_id,
+                    std::optional<std::string> photo_link);
+
+  // Keys are expected to be lowercased already
+  void AddKeys(const std::string& employee_id,
+               const std::vector<std::string>& keys);
+
+  void RemoveKeys(const std::string& employee_id,
+                  const std::vector<std::string>& keys);
+
+  // Sets the card and exactly `keys` of the employee at once
+  void ReplaceEmployee(EmployeeCard card, const std::vector<std::string>& keys);
+
+  // Employees ordered by the sum of similarities of matched keys, the same
+  // way as the old reverse_index query aggregated scores
+  std::vector<EmployeeCard> Search(const std::vector<std::string>& search_keys,
+                                   size_t limit) const;
+
+  // Employees that have every one of `exact_keys` and a key starting with
+  // `prefix`, ordered by id
+  std::vector<EmployeeCard> Suggest(const std::vector<std::string>& exact_keys,
+                                    const std::string& prefix,
+                                    size_t limit) const;
+
+  size_t EmployeesCount() const;
+
+ private:
+  struct Term {
+    std::string key;
+    std::vector<uint32_t> trigrams;
+    std::vector<DocId> postings;
+  };
+
+  struct Document {
+    EmployeeCard card;
+    std::vector<TermId> terms;
+  };
+
+  bool LessById(DocId lhs, DocId rhs) const;
+  std::optional<DocId> FindDoc(const std::string& employee_id) const;
+  DocId GetOrCreateDoc(const std::string& employee_id);
+  TermId GetOrCreateTerm(const std::string& key);
+  void LinkTerm(DocId doc_id, const std::string& key);
+  void ReleaseTerm(TermId term_id);
+  void UnlinkTerm(DocId doc_id, TermId term_id);
+
+  mutable userver::engine::SharedMutex mutex_;
+
+  std::vector<Document> docs_;
+  std::vector<DocId> free_docs_;
+  std::unordered_map<std::string, DocId> doc_ids_;
+
+  std::vector<Term> terms_;
+  std::vector<TermId> free_terms_;
+  std::unordered_map<std::string, TermId> term_ids_;
+
+  std::unordered_map<Trigram, uint32_t> trigram_ids_;
+  std::vector<std::vector<TermId>> trigram_terms_;
+
+  PrefixTrie trie_;
+};
+
+}  // namespace core::search_index
@@ -0,0 +1,114 @@
+#include "company_index.hpp"
+
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+std::vector<std::string> Ids(
+    const std::vector<core::search_index::EmployeeCard>& cards) {
+  std::vector<std::string> ids;
+  for (const auto& card : cards) {
+    ids.push_back(card.id);
+  }
+  return ids;
+}
+
+}  // namespace
+
+UTEST(SearchIndexTrigrams, SameAsPgTrgm) {
+  using core::search_index::ExtractTrigrams;
+
+  EXPECT_EQ(ExtractTrigrams("word").size(), 5);
+  EXPECT_EQ(ExtractTrigrams("2@mail.com").size(), 11);
+  EXPECT_EQ(ExtractTrigrams("иван").size(), 5);
+  EXPECT_EQ(ExtractTrigrams("aaaa").size(), 4);
+  EXPECT_TRUE(ExtractTrigrams("").empty());
+  EXPECT_TRUE(ExtractTrigrams("+-").empty());
+
+  EXPECT_FLOAT_EQ(core::search_index::Similarity(1, 2, 6), 1.0 / 7);
+  EXPECT_FLOAT_EQ(core::search_index::Similarity(0, 0, 6), 0);
+}
+
+UTEST(SearchIndexCompanyIndex, Ordering) {
+  core::search_index::CompanyIndex index;
+  index.UpsertEmployee({"a", "Seventh", "F"});
+  index.AddKeys("a", {"seventh", "f"});
+  index.UpsertEmployee({"b", "Eight", "F"});
+  index.AddKeys("b", {"eight", "f"});
+  index.UpsertEmployee({"c", "Seventh", "G"});
+  index.AddKeys("c", {"seventh", "g"});
+
+  EXPECT_EQ(Ids(index.Search({"seventh", "f"}, 10)),
+            (std::vector<std::string>{"a", "b", "c"}));
+  EXPECT_EQ(Ids(index.Search({"seventh", "f"}, 1)),
+            (std::vector<std::string>{"a"}));
+  EXPECT_EQ(Ids(index.Search({"sevent"}, 10)),
+            (std::vector<std::string>{"a", "c"}));
+  EXPECT_TRUE(index.Search({"first"}, 10).empty());
+}
+
+UTEST(SearchIndexCompanyIndex, Updates) {
+  core::search_index::CompanyIndex index;
+  index.UpsertEmployee({"a", "First", "A"});
+  index.AddKeys("a", {"first", "+1111"});
+
+  index.RemoveKeys("a", {"+1111"});
+  index.AddKeys("a", {"+2222"});
+  EXPECT_TRUE(index.Search({"+1111"}, 1).empty());
+  EXPECT_EQ(Ids(index.Search({"+2222"}, 1)), (std::vector<std::string>{"a"}));
+
+  index.RemoveEmployee("a");
+  EXPECT_TRUE(index.Search({"first"}, 1).empty());
+  EXPECT_EQ(index.EmployeesCount(), 0);
+
+  index.UpsertEmployee({"b", "Second", "B"});
+  index.AddKeys("b", {"first"});
+  EXPECT_EQ(Ids(index.Search({"first"}, 1)), (std::vector<std::string>{"b"}));
+}
+
+UTEST(SearchIndexCompanyIndex, Replace) {
+  core::search_index::CompanyIndex index;
+  index.UpsertEmployee({"a", "First", "A"});
+  index.AddKeys("a", {"first", "+1111"});
+
+  index.ReplaceEmployee({"a", "Renamed", "A"}, {"renamed", "+1111"});
+  EXPECT_TRUE(index.Search({"first"}, 1).empty());
+  EXPECT_EQ(index.Search({"renamed"}, 1).at(0).name, "Renamed");
+  EXPECT_EQ(Ids(index.Search({"+1111"}, 1)), (std::vector<std::string>{"a"}));
+
+  index.ReplaceEmployee({"b", "Second", "B"}, {"second"});
+  EXPECT_EQ(Ids(index.Search({"second"}, 1)), (std::vector<std::string>{"b"}));
+  EXPECT_EQ(index.EmployeesCount(), 2);
+}
+
+UTEST(SearchIndexCompanyIndex, Suggest) {
+  core::search_index::CompanyIndex index(2);
+  index.AddKeys("d", {"test1", "t1"});
+  index.AddKeys("c", {"test2", "t1"});
+  index.AddKeys("b", {"tesla", "t2"});
+  index.AddKeys("a", {"other"});
+
+  EXPECT_EQ(Ids(index.Suggest({}, "tes", 5)),
+            (std::vector<std::string>{"b", "c", "d"}));
+  EXPECT_EQ(Ids(index.Suggest({}, "test", 1)),
+            (std::vector<std::string>{"c"}));
+  EXPECT_EQ(Ids(index.Suggest({}, "", 2)),
+            (std::vector<std::string>{"a", "b"}));
+  EXPECT_EQ(Ids(index.Suggest({"t1"}, "test", 5)),
+            (std::vector<std::string>{"c", "d"}));
+  EXPECT_TRUE(index.Suggest({"t1", "test1"}, "bla", 5).empty());
+  EXPECT_TRUE(index.Suggest({"missing"}, "", 5).empty());
+  EXPECT_TRUE(index.Suggest({}, "zzz", 5).empty());
+
+  index.RemoveEmployee("b");
+  EXPECT_EQ(Ids(index.Suggest({}, "tes", 5)),
+            (std::vector<std::string>{"c", "d"}));
+  EXPECT_EQ(Ids(index.Suggest({}, "", 2)),
+            (std::vector<std::string>{"a", "c"}));
+
+  index.RemoveKeys("c", {"test2"});
+  EXPECT_EQ(Ids(index.Suggest({}, "test", 5)),
+            (std::vector<std::string>{"d"}));
+  EXPECT_EQ(Ids(index.Suggest({}, "t", 5)),
+            (std::vector<std::string>{"c", "d"}));
+}
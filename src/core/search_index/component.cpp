@@ -0,0 +1,289 @@
+#include "component.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+#include <userver/logging/log.hpp>
+#include <userver/storages/postgres/component.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include "core/tenant_query/query.hpp"
+
+namespace core::search_index {
+
+namespace {
+
+struct PostingRow {
+  std::string employee_id;
+  std::string key;
+};
+
+const core::tenant_query::TenantQuery kSelectEmployees{
+    "search_index_select_employees",
+    "SELECT id, name, surname, patronymic, photo_link "
+    "FROM {schema}.employees"};
+
+const core::tenant_query::TenantQuery kSelectPostings{
+    "search_index_select_postings",
+    "SELECT e.id, t.key "
+    "FROM {schema}.reverse_index_postings AS p "
+    "JOIN {schema}.reverse_index_terms AS t ON t.id = p.term_id "
+    "JOIN {schema}.employees AS e ON e.ordinal = p.ordinal"};
+
+const core::tenant_query::TenantQuery kSelectUpdatedEmployees{
+    "search_index_select_updated_employees",
+    "SELECT id, name, surname, patronymic, photo_link "
+    "FROM {schema}.employees "
+    "WHERE updated > $1"};
+
+const core::tenant_query::TenantQuery kSelectUpdatedPostings{
+    "search_index_select_updated_postings",
+    "SELECT e.id, t.key "
+    "FROM {schema}.employees AS e "
+    "JOIN {schema}.reverse_index_postings AS p ON p.ordinal = e.ordinal "
+    "JOIN {schema}.reverse_index_terms AS t ON t.id = p.term_id "
+    "WHERE e.updated > $1"};
+
+}  // namespace
+
+SearchIndex::SearchIndex(const userver::components::ComponentConfig& config,
+                         const userver::components::ComponentContext& context)
+    : CachingComponentBase(config, context),
+      pg_cluster_(
+          context.FindComponent<userver::components::Postgres>("key-value")
+              .GetCluster()),
+      suggest_top_size_(config["suggest-top-size"].As<size_t>(
+          CompanyIndex::kDefaultSuggestTopSize)),
+      update_correction_(
+          config["update-correction"].As<std::chrono::milliseconds>(
+              std::chrono::seconds{10})) {
+  StartPeriodicUpdates();
+}
+
+SearchIndex::~SearchIndex() { StopPeriodicUpdates(); }
+
+std::vector<EmployeeCard> SearchIndex::Search(
+    const std::string& company_id, const std::vector<std::string>& search_keys,
+    size_t limit) const {
+  const auto snapshot = Get();
+  auto it = snapshot->companies.find(company_id);
+  if (it == snapshot->companies.end()) {
+    return {};
+  }
+  return it->second->Search(search_keys, limit);
+}
+
+std::vector<EmployeeCard> SearchIndex::Suggest(
+    const std::string& company_id, const std::vector<std::string>& exact_keys,
+    const std::string& prefix, size_t limit) const {
+  const auto snapshot = Get();
+  auto it = snapshot->companies.find(company_id);
+  if (it == snapshot->companies.end()) {
+    return {};
+  }
+  return it->second->Suggest(exact_keys, prefix, limit);
+}
+
+void SearchIndex::AddEmployee(const std::string& company_id, EmployeeCard card,
+                              const std::vector<std::string>& keys) {
+  WriteThrough(company_id, [card = std::move(card), keys](CompanyIndex& index) {
+    index.UpsertEmployee(card);
+    index.AddKeys(card.id, keys);
+  });
+}
+
+void SearchIndex::RemoveEmployee(const std::string& company_id,
+                                 const std::string& employee_id) {
+  WriteThrough(company_id, [employee_id](CompanyIndex& index) {
+    index.RemoveEmployee(employee_id);
+  });
+}
+
+void SearchIndex::UpdateKeys(const std::string& company_id,
+                             const std::string& employee_id,
+                             const std::vector<std::string>& removed_keys,
+                             const std::vector<std::string>& added_keys) {
+  WriteThrough(company_id,
+               [employee_id, removed_keys, added_keys](CompanyIndex& index) {
+                 index.RemoveKeys(employee_id, removed_keys);
+                 index.AddKeys(employee_id, added_keys);
+               });
+}
+
+void SearchIndex::SetPhotoLink(const std::string& company_id,
+                               const std::string& employee_id,
+                               std::optional<std::string> photo_link) {
+  WriteThrough(company_id, [employee_id, photo_link = std::move(photo_link)](
+                               CompanyIndex& index) {
+    index.SetPhotoLink(employee_id, photo_link);
+  });
+}
+
+void SearchIndex::Update(
+    userver::cache::UpdateType type,
+    const std::chrono::system_clock::time_point& last_update,
+    const std::chrono::system_clock::time_point& /*now*/,
+    userver::cache::UpdateStatisticsScope& stats_scope) {
+  auto schemas = pg_cluster_->Execute(
+      userver::storages::postgres::ClusterHostType::kSlave,
+      "SELECT substr(schema_name, 13) "
+      "FROM information_schema.schemata "
+      "WHERE schema_name LIKE 'working\\_day\\_%'");
+
+  // Rows committed after the previous update may carry an earlier `updated`
+  // and the replica may lag behind, so the window starts a bit earlier
+  const userver::storages::postgres::TimePointTz updated_after{
+      last_update - update_correction_};
+  std::unordered_map<std::string, std::shared_ptr<CompanyIndex>> known;
+  if (type == userver::cache::UpdateType::kIncremental) {
+    known = Get()->companies;
+  }
+
+  CompanyIndexes indexes;
+  for (const auto& company_id :
+       schemas.AsContainer<std::vector<std::string>>()) {
+    auto it = known.find(company_id);
+    std::shared_ptr<CompanyIndex> index;
+    if (it != known.end()) {
+      index = it->second;
+      UpdateCompany(company_id, *index, updated_after, stats_scope);
+    } else {
+      index = LoadCompany(company_id, stats_scope);
+    }
+    indexes.companies.emplace(company_id, std::move(index));
+  }
+
+  std::lock_guard journal_lock(journal_mutex_);
+  for (const auto& [company_id, write] : journal_) {
+    auto& index = indexes.companies[company_id];
+    if (!index) {
+      index = std::make_shared<CompanyIndex>(suggest_top_size_);
+    }
+    write(*index);
+  }
+  journal_.clear();
+
+  size_t employees_count = 0;
+  for (const auto& [company_id, index] : indexes.companies) {
+    employees_count += index->EmployeesCount();
+  }
+
+  std::lock_guard lock(set_mutex_);
+  Set(std::move(indexes));
+  stats_scope.Finish(employees_count);
+}
+
+void SearchIndex::UpdateCompany(
+    const std::string& company_id, CompanyIndex& index,
+    const userver::storages::postgres::TimePointTz& updated_after,
+    userver::cache::UpdateStatisticsScope& stats_scope) const {
+  auto employees_result = pg_cluster_->Execute(
+      userver::storages::postgres::ClusterHostType::kSlave,
+      kSelectUpdatedEmployees.For(company_id), updated_after);
+  if (employees_result.IsEmpty()) {
+    return;
+  }
+  stats_scope.IncreaseDocumentsReadCount(employees_result.Size());
+
+  auto postings_result = pg_cluster_->Execute(
+      userver::storages::postgres::ClusterHostType::kSlave,
+      kSelectUpdatedPostings.For(company_id), updated_after);
+  stats_scope.IncreaseDocumentsReadCount(postings_result.Size());
+
+  std::unordered_map<std::string, std::vector<std::string>> keys;
+  for (auto& row : postings_result.AsContainer<std::vector<PostingRow>>(
+           userver::storages::postgres::kRowTag)) {
+    keys[row.employee_id].push_back(std::move(row.key));
+  }
+
+  for (auto& card : employees_result.AsContainer<std::vector<EmployeeCard>>(
+           userver::storages::postgres::kRowTag)) {
+    const auto& employee_keys = keys[card.id];
+    index.ReplaceEmployee(std::move(card), employee_keys);
+  }
+}
+
+std::shared_ptr<CompanyIndex> SearchIndex::LoadCompany(
+    const std::string& company_id,
+    userver::cache::UpdateStatisticsScope& stats_scope) const {
+  auto index = std::make_shared<CompanyIndex>(suggest_top_size_);
+
+  auto employees_result = pg_cluster_->Execute(
+      userver::storages::postgres::ClusterHostType::kSlave,
+      kSelectEmployees.For(company_id));
+  stats_scope.IncreaseDocumentsReadCount(employees_result.Size());
+
+  std::unordered_map<std::string, std::vector<std::string>> keys;
+  for (auto& card : employees_result.AsContainer<std::vector<EmployeeCard>>(
+           userver::storages::postgres::kRowTag)) {
+    keys.emplace(card.id, std::vector<std::string>{});
+    index->UpsertEmployee(std::move(card));
+  }
+
+  auto postings_result = pg_cluster_->Execute(
+      userver::storages::postgres::ClusterHostType::kSlave,
+      kSelectPostings.For(company_id));
+  stats_scope.IncreaseDocumentsReadCount(postings_result.Size());
+
+  for (auto& row : postings_result.AsContainer<std::vector<PostingRow>>(
+           userver::storages::postgres::kRowTag)) {
+    if (auto it = keys.find(row.employee_id); it != keys.end()) {
+      it->second.push_back(std::move(row.key));
+    }
+  }
+
+  for (const auto& [employee_id, employee_keys] : keys) {
+    index->AddKeys(employee_id, employee_keys);
+  }
+
+  return index;
+}
+
+std::shared_ptr<CompanyIndex> SearchIndex::GetOrCreateCompany(
+    const std::string& company_id) {
+  {
+    const auto snapshot = Get();
+    auto it = snapshot->companies.find(company_id);
+    if (it != snapshot->companies.end()) {
+      return it->second;
+    }
+  }
+
+  std::lock_guard lock(set_mutex_);
+  auto indexes = *Get();
+  auto [it, inserted] = indexes.companies.emplace(
+      company_id, std::make_shared<CompanyIndex>(suggest_top_size_));
+  auto index = it->second;
+  if (inserted) {
+    LOG_INFO() << "Created search index for company " << company_id;
+    Set(std::move(indexes));
+  }
+  return index;
+}
+
+void SearchIndex::WriteThrough(const std::string& company_id, Write write) {
+  std::lock_guard lock(journal_mutex_);
+  write(*GetOrCreateCompany(company_id));
+  journal_.emplace_back(company_id, std::move(write));
+}
+
+userver::yaml_config::Schema SearchIndex::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::CachingComponentBase<CompanyIndexes>>(R"(
+type: object
+description: In-memory employee search index
+additionalProperties: false
+properties:
+    suggest-top-size:
+        type: integer
+        description: number of employees precomputed for every suggest prefix
+        defaultDescription: 32
+    update-correction:
+        type: string
+        description: lookback of incremental updates past the previous one
+        defaultDescription: 10s
+)");
+}
+
+}  // namespace core::search_index
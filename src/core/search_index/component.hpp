@@ -0,0 +1,100 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/cache/caching_component_base.hpp>
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+#include "company_index.hpp"
+
+namespace core::search_index {
+
+struct CompanyIndexes {
+  std::unordered_map<std::string, std::shared_ptr<CompanyIndex>> companies;
+};
+
+// Per-company in-memory search index. Built from the reverse index tables on
+// full updates, incremental updates reload the employees changed since the
+// previous one. Handlers that change indexed fields write through it so that
+// their changes are searchable right away, write-throughs since the last
+// update are applied again to the indexes it sets, as it may have read the
+// data from before them.
+class SearchIndex final
+    : public userver::components::CachingComponentBase<CompanyIndexes> {
+ public:
+  static constexpr std::string_view kName = "search-index";
+
+  SearchIndex(const userver::components::ComponentConfig& config,
+              const userver::components::ComponentContext& context);
+
+  ~SearchIndex() override;
+
+  std::vector<EmployeeCard> Search(const std::string& company_id,
+                                   const std::vector<std::string>& search_keys,
+                                   size_t limit) const;
+
+  std::vector<EmployeeCard> Suggest(const std::string& company_id,
+                                    const std::vector<std::string>& exact_keys,
+                                    const std::string& prefix,
+                                    size_t limit) const;
+
+  void AddEmployee(const std::string& company_id, EmployeeCard card,
+                   const std::vector<std::string>& keys);
+
+  void RemoveEmployee(const std::string& company_id,
+                      const std::string& employee_id);
+
+  void UpdateKeys(const std::string& company_id,
+                  const std::string& employee_id,
+                  const std::vector<std::string>& removed_keys,
+                  const std::vector<std::string>& added_keys);
+
+  void SetPhotoLink(const std::string& company_id,
+                    const std::string& employee_id,
+                    std::optional<std::string> photo_link);
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  void Update(userver::cache::UpdateType type,
+              const std::chrono::system_clock::time_point& last_update,
+              const std::chrono::system_clock::time_point& now,
+              userver::cache::UpdateStatisticsScope& stats_scope) override;
+
+  std::shared_ptr<CompanyIndex> LoadCompany(
+      const std::string& company_id,
+      userver::cache::UpdateStatisticsScope& stats_scope) const;
+
+  void UpdateCompany(
+      const std::string& company_id, CompanyIndex& index,
+      const userver::storages::postgres::TimePointTz& updated_after,
+      userver::cache::UpdateStatisticsScope& stats_scope) const;
+
+  std::shared_ptr<CompanyIndex> GetOrCreateCompany(
+      const std::string& company_id);
+
+  using Write = std::function<void(CompanyIndex&)>;
+
+  void WriteThrough(const std::string& company_id, Write write);
+
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+  const size_t suggest_top_size_;
+  const std::chrono::milliseconds update_correction_;
+  userver::engine::Mutex set_mutex_;
+
+  // Write-throughs since the last Set, taken before set_mutex_
+  userver::engine::Mutex journal_mutex_;
+  std::vector<std::pair<std::string, Write>> journal_;
+};
+
+}  // namespace core::search_index
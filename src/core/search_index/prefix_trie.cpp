@@ -0,0 +1,202 @@
+#include "prefix_trie.hpp"
+
+#include <algorithm>
+
+namespace core::search_index {
+
+namespace {
+
+template <class Children>
+auto FindChild(Children& children, char first) {
+  return std::lower_bound(
+      children.begin(), children.end(), first,
+      [](const auto& child, char c) { return child->label.front() < c; });
+}
+
+size_t CommonPrefix(std::string_view lhs, std::string_view rhs) {
+  size_t i = 0;
+  while (i < lhs.size() && i < rhs.size() && lhs[i] == rhs[i]) {
+    ++i;
+  }
+  return i;
+}
+
+}  // namespace
+
+PrefixTrie::PrefixTrie(size_t top_size, Less less, Postings postings)
+    : top_size_(top_size),
+      less_(std::move(less)),
+      postings_(std::move(postings)),
+      root_(std::make_unique<Node>()) {}
+
+PrefixTrie::~PrefixTrie() = default;
+
+void PrefixTrie::AddPosting(std::string_view key, TermId term, DocId doc) {
+  std::vector<Node*> path{root_.get()};
+  std::string_view rest = key;
+  while (!rest.empty()) {
+    auto& children = path.back()->children;
+    auto it = FindChild(children, rest.front());
+    if (it == children.end() || (*it)->label.front() != rest.front()) {
+      auto leaf = std::make_unique<Node>();
+      leaf->label = rest;
+      it = children.insert(it, std::move(leaf));
+      path.push_back(it->get());
+      break;
+    }
+
+    const auto common = CommonPrefix((*it)->label, rest);
+    if (common < (*it)->label.size()) {
+      auto middle = std::make_unique<Node>();
+      middle->label = (*it)->label.substr(0, common);
+      middle->top = (*it)->top;
+      (*it)->label.erase(0, common);
+      middle->children.push_back(std::move(*it));
+      *it = std::move(middle);
+    }
+    path.push_back(it->get());
+    rest.remove_prefix(common);
+  }
+
+  path.back()->term = term;
+  for (auto* node : path) {
+    InsertTop(*node, doc);
+  }
+}
+
+void PrefixTrie::RemovePosting(std::string_view key, DocId doc,
+                               bool last_posting) {
+  auto path = FindPath(key);
+  if (path.empty()) {
+    return;
+  }
+
+  if (last_posting) {
+    path.back()->term.reset();
+
+    while (path.size() > 1 && !path.back()->term &&
+           path.back()->children.empty()) {
+      auto& siblings = path[path.size() - 2]->children;
+      siblings.erase(FindChild(siblings, path.back()->label.front()));
+      path.pop_back();
+    }
+
+    auto* node = path.back();
+    if (path.size() > 1 && !node->term && node->children.size() == 1) {
+      auto child = std::move(node->children.front());
+      node->label += child->label;
+      node->children = std::move(child->children);
+      node->term = child->term;
+      node->top = std::move(child->top);
+    }
+  }
+
+  for (auto it = path.rbegin(); it != path.rend(); ++it) {
+    auto& top = (*it)->top;
+    if (std::find(top.begin(), top.end(), doc) != top.end()) {
+      RecomputeTop(**it);
+    }
+  }
+}
+
+std::vector<PrefixTrie::DocId> PrefixTrie::Top(std::string_view prefix,
+                                               size_t limit) const {
+  const auto* node = FindPrefix(prefix);
+  if (node == nullptr) {
+    return {};
+  }
+
+  if (limit <= top_size_ || node->top.size() < top_size_) {
+    limit = std::min(limit, node->top.size());
+    return {node->top.begin(), node->top.begin() + limit};
+  }
+
+  std::vector<DocId> docs;
+  CollectSubtree(*node, docs);
+  std::sort(docs.begin(), docs.end(), less_);
+  docs.erase(std::unique(docs.begin(), docs.end()), docs.end());
+  docs.resize(std::min(limit, docs.size()));
+  return docs;
+}
+
+std::vector<PrefixTrie::Node*> PrefixTrie::FindPath(
+    std::string_view key) const {
+  std::vector<Node*> path{root_.get()};
+  std::string_view rest = key;
+  while (!rest.empty()) {
+    auto& children = path.back()->children;
+    auto it = FindChild(children, rest.front());
+    if (it == children.end() || !rest.starts_with((*it)->label)) {
+      return {};
+    }
+    rest.remove_prefix((*it)->label.size());
+    path.push_back(it->get());
+  }
+  return path;
+}
+
+const PrefixTrie::Node* PrefixTrie::FindPrefix(std::string_view prefix) const {
+  const Node* node = root_.get();
+  std::string_view rest = prefix;
+  while (!rest.empty()) {
+    auto it = FindChild(node->children, rest.front());
+    if (it == node->children.end() ||
+        (*it)->label.front() != rest.front()) {
+      return nullptr;
+    }
+    const auto& label = (*it)->label;
+    if (rest.size() <= label.size()) {
+      return std::string_view{label}.starts_with(rest) ? it->get() : nullptr;
+    }
+    if (!rest.starts_with(label)) {
+      return nullptr;
+    }
+    rest.remove_prefix(label.size());
+    node = it->get();
+  }
+  return node;
+}
+
+void PrefixTrie::InsertTop(Node& node, DocId doc) const {
+  auto& top = node.top;
+  auto it = std::lower_bound(top.begin(), top.end(), doc, less_);
+  if (it != top.end() && !less_(doc, *it)) {
+    return;
+  }
+  if (it == top.end() && top.size() >= top_size_) {
+    return;
+  }
+  top.insert(it, doc);
+  if (top.size() > top_size_) {
+    top.pop_back();
+  }
+}
+
+void PrefixTrie::RecomputeTop(Node& node) const {
+  std::vector<DocId> docs;
+  for (const auto& child : node.children) {
+    docs.insert(docs.end(), child->top.begin(), child->top.end());
+  }
+  if (node.term.has_value()) {
+    const auto& postings = postings_(*node.term);
+    docs.insert(docs.end(), postings.begin(), postings.end());
+  }
+
+  std::sort(docs.begin(), docs.end(), less_);
+  docs.erase(std::unique(docs.begin(), docs.end()), docs.end());
+  docs.resize(std::min(top_size_, docs.size()));
+  node.top = std::move(docs);
+}
+
+void PrefixTrie::CollectSubtree(const Node& node,
+                                std::vector<DocId>& docs) const {
+  if (node.term.has_value()) {
+    const auto& postings = postings_(*node.term);
+    docs.insert(docs.end(), postings.begin(), postings.end());
+  }
+  for (const auto& child : node.children) {
+    CollectSubtree(*child, docs);
+  }
+}
+
+}  // namespace core::search_index
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace core::search_index {
+
+// Radix trie over reverse index keys. Every node keeps the first `top_size`
+// documents of its subtree in the order given by `less`, so short prefix
+// lookups are answered without walking the subtree.
+class PrefixTrie {
+ public:
+  using DocId = uint32_t;
+  using TermId = uint32_t;
+  using Less = std::function<bool(DocId, DocId)>;
+  using Postings = std::function<const std::vector<DocId>&(TermId)>;
+
+  PrefixTrie(size_t top_size, Less less, Postings postings);
+  ~PrefixTrie();
+
+  PrefixTrie(const PrefixTrie&) = delete;
+  PrefixTrie& operator=(const PrefixTrie&) = delete;
+
+  // Must be called after `doc` was added to the postings of `term`
+  void AddPosting(std::string_view key, TermId term, DocId doc);
+
+  // Must be called after `doc` was removed from the postings of the term,
+  // `last_posting` drops the key from the trie
+  void RemovePosting(std::string_view key, DocId doc, bool last_posting);
+
+  // First `limit` documents having a key that starts with `prefix`
+  std::vector<DocId> Top(std::string_view prefix, size_t limit) const;
+
+ private:
+  struct Node {
+    std::string label;
+    std::vector<std::unique_ptr<Node>> children;
+    std::optional<TermId> term;
+    std::vector<DocId> top;
+  };
+
+  std::vector<Node*> FindPath(std::string_view key) const;
+  const Node* FindPrefix(std::string_view prefix) const;
+  void InsertTop(Node& node, DocId doc) const;
+  void RecomputeTop(Node& node) const;
+  void CollectSubtree(const Node& node, std::vector<DocId>& docs) const;
+
+  const size_t top_size_;
+  const Less less_;
+  const Postings postings_;
+  std::unique_ptr<Node> root_;
+};
+
+}  // namespace core::search_index
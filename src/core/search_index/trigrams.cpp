@@ -0,0 +1,103 @@
+#include "trigrams.hpp"
+
+#include <algorithm>
+
+namespace core::search_index {
+
+namespace {
+
+constexpr char32_t kPadding = U' ';
+
+// Decodes one UTF-8 sequence, broken bytes are returned as is
+char32_t NextCodePoint(std::string_view text, size_t& pos) {
+  const auto lead = static_cast<unsigned char>(text[pos++]);
+  size_t length = 0;
+  char32_t code_point = lead;
+  if ((lead & 0xE0) == 0xC0) {
+    length = 1;
+    code_point = lead & 0x1F;
+  } else if ((lead & 0xF0) == 0xE0) {
+    length = 2;
+    code_point = lead & 0x0F;
+  } else if ((lead & 0xF8) == 0xF0) {
+    length = 3;
+    code_point = lead & 0x07;
+  }
+
+  if (pos + length > text.size()) {
+    return lead;
+  }
+  for (size_t i = 0; i < length; ++i) {
+    const auto next = static_cast<unsigned char>(text[pos + i]);
+    if ((next & 0xC0) != 0x80) {
+      return lead;
+    }
+    code_point = (code_point << 6) | (next & 0x3F);
+  }
+  pos += length;
+  return code_point;
+}
+
+// pg_trgm keeps only alphanumeric characters. Everything outside of ASCII
+// except for punctuation blocks is treated as a letter, which covers the
+// latin and cyrillic names we index.
+bool IsWordChar(char32_t c) {
+  if (c < 0x80) {
+    return (c >= U'0' && c <= U'9') || (c >= U'a' && c <= U'z') ||
+           (c >= U'A' && c <= U'Z');
+  }
+  if (c <= 0xBF || c == 0xD7 || c == 0xF7) {
+    return false;
+  }
+  return !(c >= 0x2000 && c <= 0x206F) && !(c >= 0x3000 && c <= 0x303F);
+}
+
+Trigram Pack(char32_t a, char32_t b, char32_t c) {
+  return (static_cast<Trigram>(a) << 42) | (static_cast<Trigram>(b) << 21) |
+         static_cast<Trigram>(c);
+}
+
+}  // namespace
+
+std::vector<Trigram> ExtractTrigrams(std::string_view text) {
+  std::vector<Trigram> trigrams;
+  std::vector<char32_t> word;
+
+  auto flush_word = [&trigrams, &word]() {
+    if (word.empty()) {
+      return;
+    }
+    word.insert(word.begin(), 2, kPadding);
+    word.push_back(kPadding);
+    for (size_t i = 0; i + 2 < word.size(); ++i) {
+      trigrams.push_back(Pack(word[i], word[i + 1], word[i + 2]));
+    }
+    word.clear();
+  };
+
+  size_t pos = 0;
+  while (pos < text.size()) {
+    const auto c = NextCodePoint(text, pos);
+    if (IsWordChar(c)) {
+      word.push_back(c);
+    } else {
+      flush_word();
+    }
+  }
+  flush_word();
+
+  std::sort(trigrams.begin(), trigrams.end());
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()),
+                 trigrams.end());
+  return trigrams;
+}
+
+float Similarity(size_t shared, size_t lhs_size, size_t rhs_size) {
+  if (lhs_size == 0 || rhs_size == 0) {
+    return 0;
+  }
+  return static_cast<float>(shared) /
+         static_cast<float>(lhs_size + rhs_size - shared);
+}
+
+}  // namespace core::search_index
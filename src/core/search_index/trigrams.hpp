@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace core::search_index {
+
+// Three unicode code points packed by 21 bits each
+using Trigram = uint64_t;
+
+// Same trigram set as pg_trgm show_trgm(): text is split into words of
+// alphanumeric characters, each word is padded with two spaces in front and
+// one behind. Result is sorted and contains no duplicates.
+std::vector<Trigram> ExtractTrigrams(std::string_view text);
+
+// Same formula as pg_trgm similarity() for already extracted trigram sets
+float Similarity(size_t shared, size_t lhs_size, size_t rhs_size);
+
+}  // namespace core::search_index
@@ -0,0 +1,59 @@
+#include "query.hpp"
+
+#include <mutex>
+#include <shared_mutex>
+
+namespace core::tenant_query {
+
+namespace {
+
+constexpr std::string_view kSchemaPlaceholder = "{schema}";
+
+}  // namespace
+
+std::string Schema(std::string_view company_id) {
+  std::string schema = "working_day_";
+  schema.append(company_id);
+  return schema;
+}
+
+TenantQuery::TenantQuery(std::string_view name, std::string_view text)
+    : name_(name), text_(text) {}
+
+const userver::storages::postgres::Query& TenantQuery::For(
+    std::string_view company_id) const {
+  {
+    std::shared_lock lock(mutex_);
+    auto it = companies_.find(company_id);
+    if (it != companies_.end()) {
+      return *it->second;
+    }
+  }
+
+  auto query =
+      std::make_unique<userver::storages::postgres::Query>(Render(company_id));
+  std::lock_guard lock(mutex_);
+  auto [it, inserted] =
+      companies_.emplace(std::string(company_id), std::move(query));
+  return *it->second;
+}
+
+userver::storages::postgres::Query TenantQuery::Render(
+    std::string_view company_id) const {
+  const auto schema = Schema(company_id);
+  std::string statement;
+  statement.reserve(text_.size() + schema.size());
+  for (size_t pos = 0;;) {
+    const auto placeholder = text_.find(kSchemaPlaceholder, pos);
+    if (placeholder == std::string::npos) {
+      statement.append(text_, pos);
+      break;
+    }
+    statement.append(text_, pos, placeholder - pos).append(schema);
+    pos = placeholder + kSchemaPlaceholder.size();
+  }
+  return userver::storages::postgres::Query{
+      std::move(statement), userver::storages::postgres::Query::Name{name_}};
+}
+
+}  // namespace core::tenant_query
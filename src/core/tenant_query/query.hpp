@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <userver/engine/shared_mutex.hpp>
+#include <userver/storages/postgres/query.hpp>
+
+namespace core::tenant_query {
+
+// Schema of the company, "working_day_<company_id>"
+std::string Schema(std::string_view company_id);
+
+// Query over the tables of one company, `{schema}` in the text stands for
+// the company schema. The text is rendered once per company and the same
+// Query object is handed out afterwards, so the statement text of a company
+// never changes and the driver keeps it prepared on every connection.
+//
+//   const core::tenant_query::TenantQuery kSelectName{
+//       "select_name", "SELECT name FROM {schema}.employees WHERE id = $1"};
+//   pg_cluster_->Execute(kMaster, kSelectName.For(company_id), id);
+class TenantQuery {
+ public:
+  TenantQuery(std::string_view name, std::string_view text);
+
+  TenantQuery(const TenantQuery&) = delete;
+  TenantQuery& operator=(const TenantQuery&) = delete;
+
+  const userver::storages::postgres::Query& For(
+      std::string_view company_id) const;
+
+ private:
+  struct Hash {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view value) const {
+      return std::hash<std::string_view>{}(value);
+    }
+  };
+
+  userver::storages::postgres::Query Render(std::string_view company_id) const;
+
+  const std::string name_;
+  const std::string text_;
+
+  mutable userver::engine::SharedMutex mutex_;
+  mutable std::unordered_map<
+      std::string, std::unique_ptr<userver::storages::postgres::Query>, Hash,
+      std::equal_to<>>
+      companies_;
+};
+
+}  // namespace core::tenant_query
@@ -0,0 +1,31 @@
+#include "query.hpp"
+
+#include <userver/utest/utest.hpp>
+
+UTEST(TenantQuery, Render) {
+  const core::tenant_query::TenantQuery query{
+      "select_name",
+      "SELECT name FROM {schema}.employees "
+      "JOIN {schema}.employee_team ON id = employee_id WHERE id = $1"};
+
+  EXPECT_EQ(query.For("first").Statement(),
+            "SELECT name FROM working_day_first.employees "
+            "JOIN working_day_first.employee_team ON id = employee_id "
+            "WHERE id = $1");
+  EXPECT_EQ(query.For("second").Statement(),
+            "SELECT name FROM working_day_second.employees "
+            "JOIN working_day_second.employee_team ON id = employee_id "
+            "WHERE id = $1");
+  EXPECT_EQ(query.For("first").GetName()->GetUnderlying(), "select_name");
+  EXPECT_EQ(core::tenant_query::Schema("first"), "working_day_first");
+}
+
+UTEST(TenantQuery, RenderedOnce) {
+  const core::tenant_query::TenantQuery query{"select_all",
+                                             "SELECT * FROM {schema}.teams"};
+
+  const auto& first = query.For("first");
+  query.For("second");
+  EXPECT_EQ(&query.For("first"), &first);
+  EXPECT_NE(&query.For("second"), &first);
+}
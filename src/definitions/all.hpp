@@ -66,6 +66,7 @@
 
 #ifdef V1_DOCUMENTS_SEND
 #define USE_DOCUMENT_SEND_REQUEST
+#define USE_ERROR_MESSAGE
 #endif
 
 #ifdef USE_DOCUMENT_SEND_REQUEST
@@ -125,21 +126,29 @@
 #endif
 
 #ifdef V1_DOCUMENTS_VACATION
-#define USE_PYSERVICE_DOCUMENT_GENERATE_REQUEST
 #define USE_ERROR_MESSAGE
 #endif
 
 #ifdef V1_ABSCENCE_VERDICT
-#define USE_PYSERVICE_DOCUMENT_GENERATE_REQUEST
 #define USE_ABSCENCE_VERDICT_REQUEST
 #endif
 
+#ifdef V1_ABSCENCE_DOCUMENT_STATUS
+#define USE_ABSCENCE_DOCUMENT_STATUS_RESPONSE
+#define USE_ERROR_MESSAGE
+#endif
+
 #ifdef V1_DOCUMENTS_SIGN
 #define USE_LIST_EMPLOYEE_WITH_SUBCOMPANY
 #define USE_PYSERVICE_DOCUMENT_SIGN_REQUEST
 #define USE_ERROR_MESSAGE
 #endif
 
+#ifdef V1_DOCUMENTS_SIGN_STATUS
+#define USE_DOCUMENTS_SIGN_STATUS_RESPONSE
+#define USE_ERROR_MESSAGE
+#endif
+
 #ifdef USE_LIST_EMPLOYEE_WITH_SUBCOMPANY
 #define USE_LIST_EMPLOYEE
 #endif
@@ -168,20 +177,43 @@
 #define USE_INVENTORY_ITEM
 #endif
 
-#ifdef USE_LIST_EMPLOYEE
-struct ListEmployee : public JsonCompatible {
-  // For postgres initialization type needs to be default constructible
-  ListEmployee() = default;
+#ifdef V1_NOTIFICATIONS
+#define USE_NOTIFICATION
+#define USE_ERROR_MESSAGE
+#endif
 
-  // Make sure to initialize parsing first for new structure
-  ListEmployee(ListEmployee&& other) { *this = std::move(other); }
+#ifdef V1_NOTIFICATIONS_UNREAD
+#define USE_NOTIFICATIONS_UNREAD_RESPONSE
+#endif
 
-  ListEmployee(const ListEmployee& other) { *this = other; }
+#ifdef V1_NOTIFICATIONS_WAIT
+#define USE_NOTIFICATIONS_UNREAD_RESPONSE
+#define USE_ERROR_MESSAGE
+#endif
 
-  ListEmployee& operator=(ListEmployee&& other) = default;
+#ifdef V1_NOTIFICATIONS_READ
+#define USE_NOTIFICATIONS_READ_REQUEST
+#endif
 
-  ListEmployee& operator=(const ListEmployee& other) = default;
+#ifdef USE_NOTIFICATION
+#define USE_LIST_EMPLOYEE
+#endif
 
+#ifdef V1_PAYMENTS_ADD_BULK
+#define USE_PAYMENTS_ADD_BULK_REQUEST
+#define USE_PAYMENTS_ADD_BULK_RESPONSE
+#endif
+
+#ifdef USE_PAYMENTS_ADD_BULK_REQUEST
+#define USE_PAYMENT_ITEM
+#endif
+
+#ifdef USE_PAYMENTS_ADD_BULK_RESPONSE
+#define USE_PAYMENT_ROW_ERROR
+#endif
+
+#ifdef USE_LIST_EMPLOYEE
+struct ListEmployee : public JsonCompatible<ListEmployee> {
   // Method for postgres initialization of non-trivial types
   auto Introspect() {
     return std::tie(id, name, surname, patronymic, photo_link);
@@ -192,21 +224,25 @@ struct ListEmployee : public JsonCompatible {
   REGISTER_STRUCT_FIELD(surname, std::string, "surname");
   REGISTER_STRUCT_FIELD_OPTIONAL(patronymic, std::string, "patronymic");
   REGISTER_STRUCT_FIELD_OPTIONAL(photo_link, std::string, "photo_link");
+
+  JSON_FIELDS(id, name, surname, patronymic, photo_link);
 };
 #endif
 
 #ifdef USE_ADD_EMPLOYEE_REQUEST
-struct AddEmployeeRequest : public JsonCompatible {
+struct AddEmployeeRequest : public JsonCompatible<AddEmployeeRequest> {
   REGISTER_STRUCT_FIELD(name, std::string, "name");
   REGISTER_STRUCT_FIELD(surname, std::string, "surname");
   REGISTER_STRUCT_FIELD(role, std::string, "role");
   REGISTER_STRUCT_FIELD_OPTIONAL(patronymic, std::string, "patronymic");
   REGISTER_STRUCT_FIELD_OPTIONAL(company_id, std::string, "company_id");
+
+  JSON_FIELDS(name, surname, role, patronymic, company_id);
 };
 #endif
 
 #ifdef USE_ADD_EMPLOYEE_RESPONSE
-struct AddEmployeeResponse : public JsonCompatible {
+struct AddEmployeeResponse : public JsonCompatible<AddEmployeeResponse> {
   AddEmployeeResponse(const std::string& l, const std::string& p) {
     login = l;
     password = p;
@@ -214,19 +250,23 @@ struct AddEmployeeResponse : public JsonCompatible {
 
   REGISTER_STRUCT_FIELD(login, std::string, "login");
   REGISTER_STRUCT_FIELD(password, std::string, "password");
+
+  JSON_FIELDS(login, password);
 };
 #endif
 
 #ifdef USE_ERROR_MESSAGE
-struct ErrorMessage : public JsonCompatible {
+struct ErrorMessage : public JsonCompatible<ErrorMessage> {
   ErrorMessage(const std::string& msg) { message = msg; }
 
   REGISTER_STRUCT_FIELD(message, std::string, "message");
+
+  JSON_FIELDS(message);
 };
 #endif
 
 #ifdef USE_PROFILE_EDIT_REQUEST
-struct ProfileEditRequest : public JsonCompatible {
+struct ProfileEditRequest : public JsonCompatible<ProfileEditRequest> {
   REGISTER_STRUCT_FIELD_OPTIONAL(phones, std::vector<std::string>, "phones");
   REGISTER_STRUCT_FIELD_OPTIONAL(email, std::string, "email");
   REGISTER_STRUCT_FIELD_OPTIONAL(birthday, std::string, "birthday");
@@ -234,69 +274,78 @@ struct ProfileEditRequest : public JsonCompatible {
   REGISTER_STRUCT_FIELD_OPTIONAL(telegram_id, std::string, "telegram_id");
   REGISTER_STRUCT_FIELD_OPTIONAL(vk_id, std::string, "vk_id");
   REGISTER_STRUCT_FIELD_OPTIONAL(team, std::string, "team");
+
+  JSON_FIELDS(phones, email, birthday, password, telegram_id, vk_id, team);
 };
 #endif
 
 #ifdef USE_SEARCH_BASIC_REQUEST
-struct SearchBasicRequest : public JsonCompatible {
+struct SearchBasicRequest : public JsonCompatible<SearchBasicRequest> {
   REGISTER_STRUCT_FIELD(search_key, std::string, "search_key");
+
+  JSON_FIELDS(search_key);
 };
 #endif
 
 #ifdef USE_SEARCH_FULL_REQUEST
-struct SearchFullRequest : public JsonCompatible {
+struct SearchFullRequest : public JsonCompatible<SearchFullRequest> {
   REGISTER_STRUCT_FIELD(search_key, std::string, "search_key");
   REGISTER_STRUCT_FIELD(limit, int, "limit");
+
+  JSON_FIELDS(search_key, limit);
 };
 #endif
 
 #ifdef USE_SEARCH_SUGGEST_REQUEST
-struct SearchSuggestRequest : public JsonCompatible {
+struct SearchSuggestRequest : public JsonCompatible<SearchSuggestRequest> {
   REGISTER_STRUCT_FIELD(search_key, std::string, "search_key");
   REGISTER_STRUCT_FIELD(limit, int, "limit");
+
+  JSON_FIELDS(search_key, limit);
 };
 #endif
 
 #ifdef USE_SEARCH_RESPONSE
-struct SearchResponse : public JsonCompatible {
+struct SearchResponse : public JsonCompatible<SearchResponse> {
   REGISTER_STRUCT_FIELD(employees, std::vector<ListEmployee>, "employees");
+
+  JSON_FIELDS(employees);
 };
 #endif
 
 #ifdef USE_EMPLOYEES_RESPONSE
-struct EmployeesResponse : public JsonCompatible {
+struct EmployeesResponse : public JsonCompatible<EmployeesResponse> {
   REGISTER_STRUCT_FIELD(employees, std::vector<ListEmployee>, "employees");
+
+  JSON_FIELDS(employees);
 };
 #endif
 
 #ifdef USE_ATTENDANCE_LIST_ALL_REQUEST
-struct AttendanceListAllRequest : public JsonCompatible {
+struct AttendanceListAllRequest
+    : public JsonCompatible<AttendanceListAllRequest> {
   REGISTER_STRUCT_FIELD(from, userver::storages::postgres::TimePoint, "from");
   REGISTER_STRUCT_FIELD(to, userver::storages::postgres::TimePoint, "to");
+
+  JSON_FIELDS(from, to);
 };
 #endif
 
 #ifdef USE_LIST_EMPLOYEE_WITH_SUBCOMPANY
-struct ListEmployeeWithSubcompany : public ListEmployee {
+struct ListEmployeeWithSubcompany
+    : public JsonCompatible<ListEmployeeWithSubcompany, ListEmployee> {
   auto Introspect() {
     return std::tuple_cat(ListEmployee::Introspect(), std::tie(subcompany));
   }
 
-  ListEmployeeWithSubcompany& operator=(
-      const ListEmployeeWithSubcompany& other) = default;
-
   REGISTER_STRUCT_FIELD(subcompany, std::string, "subcompany");
+
+  JSON_FIELDS(subcompany);
 };
 #endif
 
 #ifdef USE_ATTENDANCE_LIST_ITEM
-struct AttendanceListItem : public JsonCompatible {
-  AttendanceListItem() = default;
-
-  AttendanceListItem(AttendanceListItem&& other) { *this = std::move(other); }
-
-  AttendanceListItem& operator=(AttendanceListItem&& other) = default;
-
+struct AttendanceListItem : public JsonCompatible<AttendanceListItem> {
   auto Introspect() {
     return std::tie(start_date, end_date, abscence_type, employee);
   }
@@ -311,37 +360,40 @@ struct AttendanceListItem : public JsonCompatible {
   REGISTER_STRUCT_FIELD_OPTIONAL(abscence_type, std::string, "abscence_type");
   // REGISTER_STRUCT_FIELD_OPTIONAL(abscence_date,
   // userver::storages::postgres::TimePoint, "abscence_date");
+
+  JSON_FIELDS(start_date, end_date, employee, abscence_type);
 };
 #endif
 
 #ifdef USE_ATTENDANCE_LIST_ALL_RESPONSE
-struct AttendanceListAllResponse : public JsonCompatible {
+struct AttendanceListAllResponse
+    : public JsonCompatible<AttendanceListAllResponse> {
   REGISTER_STRUCT_FIELD(attendances, std::vector<AttendanceListItem>,
                         "attendances");
+
+  JSON_FIELDS(attendances);
 };
 #endif
 
 #ifdef USE_UPLOAD_DOCUMENT_REQUEST
-struct UploadDocumentRequest : public JsonCompatible {
+struct UploadDocumentRequest : public JsonCompatible<UploadDocumentRequest> {
   REGISTER_STRUCT_FIELD(extension, std::string, "extension", ".pdf");
+
+  JSON_FIELDS(extension);
 };
 #endif
 
 #ifdef USE_UPLOAD_DOCUMENT_RESPONSE
-struct UploadDocumentResponse : public JsonCompatible {
+struct UploadDocumentResponse : public JsonCompatible<UploadDocumentResponse> {
   REGISTER_STRUCT_FIELD(url, std::string, "url");
   REGISTER_STRUCT_FIELD(id, std::string, "id");
+
+  JSON_FIELDS(url, id);
 };
 #endif
 
 #ifdef USE_DOCUMENT_ITEM
-struct DocumentItem : public JsonCompatible {
-  DocumentItem() = default;
-
-  DocumentItem(DocumentItem&& other) { *this = std::move(other); }
-
-  DocumentItem& operator=(DocumentItem&& other) = default;
-
+struct DocumentItem : public JsonCompatible<DocumentItem> {
   auto Introspect() {
     return std::tie(id, name, type, sign_required, description, is_signed,
                     parent_id);
@@ -354,63 +406,76 @@ struct DocumentItem : public JsonCompatible {
   REGISTER_STRUCT_FIELD_OPTIONAL(description, std::string, "description");
   REGISTER_STRUCT_FIELD_OPTIONAL(is_signed, bool, "signed");
   REGISTER_STRUCT_FIELD_OPTIONAL(parent_id, std::string, "parent_id");
+
+  JSON_FIELDS(id, name, type, sign_required, description, is_signed, parent_id);
 };
 #endif
 
 #ifdef USE_DOCUMENT_SEND_REQUEST
-struct DocumentSendRequest : public JsonCompatible {
+struct DocumentSendRequest : public JsonCompatible<DocumentSendRequest> {
   REGISTER_STRUCT_FIELD(document, DocumentItem, "document");
-  REGISTER_STRUCT_FIELD(employee_ids, std::vector<std::string>, "employee_ids");
+  // Recipients are the union of the selected employees, teams and
+  // subcompanies, or every employee of the company
+  REGISTER_STRUCT_FIELD_OPTIONAL(employee_ids, std::vector<std::string>,
+                                 "employee_ids");
+  REGISTER_STRUCT_FIELD_OPTIONAL(team_ids, std::vector<std::string>,
+                                 "team_ids");
+  REGISTER_STRUCT_FIELD_OPTIONAL(subcompanies, std::vector<std::string>,
+                                 "subcompanies");
+  REGISTER_STRUCT_FIELD(whole_company, bool, "whole_company", false);
+
+  JSON_FIELDS(document, employee_ids, team_ids, subcompanies, whole_company);
 };
 #endif
 
 #ifdef USE_DOCUMENTS_LIST_RESPONSE
-struct DocumentsListResponse : public JsonCompatible {
+struct DocumentsListResponse : public JsonCompatible<DocumentsListResponse> {
   REGISTER_STRUCT_FIELD(documents, std::vector<DocumentItem>, "documents");
+
+  JSON_FIELDS(documents);
 };
 #endif
 
 #ifdef USE_DOWNLOAD_DOCUMENT_RESPONSE
-struct DownloadDocumentResponse : public JsonCompatible {
+struct DownloadDocumentResponse
+    : public JsonCompatible<DownloadDocumentResponse> {
   REGISTER_STRUCT_FIELD(url, std::string, "url");
+
+  JSON_FIELDS(url);
 };
 #endif
 
 #ifdef USE_DOCUMENTS_LIST_ALL_RESPONSE
-struct DocumentsListAllResponse : public JsonCompatible {
+struct DocumentsListAllResponse
+    : public JsonCompatible<DocumentsListAllResponse> {
   REGISTER_STRUCT_FIELD(documents, std::vector<DocumentItem>, "documents");
+
+  JSON_FIELDS(documents);
 };
 #endif
 
 #ifdef USE_SIGN_ITEM
-struct SignItem : public JsonCompatible {
-  SignItem() = default;
-
-  SignItem(SignItem&& other) { *this = std::move(other); }
-
-  SignItem& operator=(SignItem&& other) = default;
-
+struct SignItem : public JsonCompatible<SignItem> {
   auto Introspect() { return std::tie(employee, is_signed); }
 
   REGISTER_STRUCT_FIELD(employee, ListEmployee, "employee");
   REGISTER_STRUCT_FIELD(is_signed, bool, "signed");
+
+  JSON_FIELDS(employee, is_signed);
 };
 #endif
 
 #ifdef USE_DOCUMENTS_GET_SIGNS_RESPONSE
-struct DocumentsGetSignsResponse : public JsonCompatible {
+struct DocumentsGetSignsResponse
+    : public JsonCompatible<DocumentsGetSignsResponse> {
   REGISTER_STRUCT_FIELD(signs, std::vector<SignItem>, "signs");
+
+  JSON_FIELDS(signs);
 };
 #endif
 
 #ifdef USE_USER_ACTION
-struct UserAction : public JsonCompatible {
-  UserAction() = default;
-
-  UserAction(UserAction&& other) { *this = std::move(other); }
-
-  UserAction& operator=(UserAction&& other) = default;
-
+struct UserAction : public JsonCompatible<UserAction> {
   auto Introspect() {
     return std::tie(id, type, start_date, end_date, status,
                     blocking_actions_ids);
@@ -425,40 +490,51 @@ struct UserAction : public JsonCompatible {
   REGISTER_STRUCT_FIELD_OPTIONAL(status, std::string, "status");
   REGISTER_STRUCT_FIELD(blocking_actions_ids, std::vector<std::string>,
                         "blocking_actions_ids");
+
+  JSON_FIELDS(id, type, start_date, end_date, status, blocking_actions_ids);
 };
 #endif
 
 #ifdef USE_ACTIONS_RESPONSE
-struct ActionsResponse : public JsonCompatible {
+struct ActionsResponse : public JsonCompatible<ActionsResponse> {
   REGISTER_STRUCT_FIELD(actions, std::vector<UserAction>, "actions");
+
+  JSON_FIELDS(actions);
 };
 #endif
 
 #ifdef USE_ACTIONS_REQUEST
-struct ActionsRequest : public JsonCompatible {
+struct ActionsRequest : public JsonCompatible<ActionsRequest> {
   REGISTER_STRUCT_FIELD(from, userver::storages::postgres::TimePoint, "from");
   REGISTER_STRUCT_FIELD(to, userver::storages::postgres::TimePoint, "to");
   REGISTER_STRUCT_FIELD_OPTIONAL(employee_id, std::string, "employee_id");
+
+  JSON_FIELDS(from, to, employee_id);
 };
 #endif
 
 #ifdef USE_SUPERUSER_COMPANY_ADD_REQUEST
-struct SuperuserCompanyAddRequest : public JsonCompatible {
+struct SuperuserCompanyAddRequest
+    : public JsonCompatible<SuperuserCompanyAddRequest> {
   REGISTER_STRUCT_FIELD(company_id, std::string, "company_id");
   REGISTER_STRUCT_FIELD(company_name, std::string, "company_name");
+
+  JSON_FIELDS(company_id, company_name);
 };
 #endif
 
 #ifdef USE_AUTHORIZE_REQUEST
-struct AuthorizeRequest : public JsonCompatible {
+struct AuthorizeRequest : public JsonCompatible<AuthorizeRequest> {
   REGISTER_STRUCT_FIELD(login, std::string, "login");
   REGISTER_STRUCT_FIELD(password, std::string, "password");
   REGISTER_STRUCT_FIELD(company_id, std::string, "company_id");
+
+  JSON_FIELDS(login, password, company_id);
 };
 #endif
 
 #ifdef USE_AUTHORIZE_RESPONSE
-struct AuthorizeResponse : public JsonCompatible {
+struct AuthorizeResponse : public JsonCompatible<AuthorizeResponse> {
   AuthorizeResponse(const std::string& token_, const std::string& role_) {
     token = token_;
     role = role_;
@@ -466,50 +542,50 @@ struct AuthorizeResponse : public JsonCompatible {
 
   REGISTER_STRUCT_FIELD(token, std::string, "token");
   REGISTER_STRUCT_FIELD(role, std::string, "role");
-};
-#endif
 
-#ifdef USE_PYSERVICE_DOCUMENT_GENERATE_REQUEST
-struct PyserviceDocumentGenerateRequest : public JsonCompatible {
-  REGISTER_STRUCT_FIELD(action_type, std::string, "action_type");
-  REGISTER_STRUCT_FIELD(request_type, std::string, "request_type");
-  REGISTER_STRUCT_FIELD(employee_id, std::string, "employee_id");
-  REGISTER_STRUCT_FIELD(employee_name, std::string, "employee_name");
-  REGISTER_STRUCT_FIELD(employee_surname, std::string, "employee_surname");
-  REGISTER_STRUCT_FIELD(subcompany, std::string, "subcompany");
-  REGISTER_STRUCT_FIELD(company_id, std::string, "company_id");
-  REGISTER_STRUCT_FIELD(head_name, std::string, "head_name");
-  REGISTER_STRUCT_FIELD(head_surname, std::string, "head_surname");
-  REGISTER_STRUCT_FIELD(start_date, std::string, "start_date");
-  REGISTER_STRUCT_FIELD(end_date, std::string, "end_date");
-  REGISTER_STRUCT_FIELD_OPTIONAL(employee_patronymic, std::string,
-                                 "employee_patronymic");
-  REGISTER_STRUCT_FIELD_OPTIONAL(head_patronymic, std::string,
-                                 "head_patronymic");
-  REGISTER_STRUCT_FIELD_OPTIONAL(employee_position, std::string,
-                                 "employee_position");
-  REGISTER_STRUCT_FIELD_OPTIONAL(head_position, std::string, "head_position");
-  REGISTER_STRUCT_FIELD_OPTIONAL(first_start_date, std::string,
-                                 "first_start_date");
-  REGISTER_STRUCT_FIELD_OPTIONAL(first_end_date, std::string, "first_end_date");
-  REGISTER_STRUCT_FIELD_OPTIONAL(second_start_date, std::string,
-                                 "second_start_date");
-  REGISTER_STRUCT_FIELD_OPTIONAL(second_end_date, std::string,
-                                 "second_end_date");
+  JSON_FIELDS(token, role);
 };
 #endif
 
 #ifdef USE_ABSCENCE_VERDICT_REQUEST
-struct AbscenceVerdictRequest : public JsonCompatible {
+struct AbscenceVerdictRequest : public JsonCompatible<AbscenceVerdictRequest> {
   REGISTER_STRUCT_FIELD(action_id, std::string, "action_id");
   REGISTER_STRUCT_FIELD_OPTIONAL(notification_id, std::string,
                                  "notification_id");
   REGISTER_STRUCT_FIELD(approve, bool, "approve");
+
+  JSON_FIELDS(action_id, notification_id, approve);
+};
+#endif
+
+#ifdef USE_ABSCENCE_DOCUMENT_STATUS_RESPONSE
+struct AbscenceDocumentStatusResponse
+    : public JsonCompatible<AbscenceDocumentStatusResponse> {
+  REGISTER_STRUCT_FIELD(status, std::string, "status");
+  REGISTER_STRUCT_FIELD(attempts, int, "attempts");
+  REGISTER_STRUCT_FIELD_OPTIONAL(document_id, std::string, "document_id");
+  REGISTER_STRUCT_FIELD_OPTIONAL(error, std::string, "error");
+
+  JSON_FIELDS(status, attempts, document_id, error);
+};
+#endif
+
+#ifdef USE_DOCUMENTS_SIGN_STATUS_RESPONSE
+struct DocumentsSignStatusResponse
+    : public JsonCompatible<DocumentsSignStatusResponse> {
+  REGISTER_STRUCT_FIELD(status, std::string, "status");
+  REGISTER_STRUCT_FIELD(attempts, int, "attempts");
+  REGISTER_STRUCT_FIELD_OPTIONAL(signed_document_id, std::string,
+                                 "signed_document_id");
+  REGISTER_STRUCT_FIELD_OPTIONAL(error, std::string, "error");
+
+  JSON_FIELDS(status, attempts, signed_document_id, error);
 };
 #endif
 
 #ifdef USE_PYSERVICE_DOCUMENT_SIGN_REQUEST
-struct PyserviceDocumentSignRequest : public JsonCompatible {
+struct PyserviceDocumentSignRequest
+    : public JsonCompatible<PyserviceDocumentSignRequest> {
   REGISTER_STRUCT_FIELD(employee_id, std::string, "employee_id");
   REGISTER_STRUCT_FIELD(employee_name, std::string, "employee_name");
   REGISTER_STRUCT_FIELD(employee_surname, std::string, "employee_surname");
@@ -518,22 +594,30 @@ struct PyserviceDocumentSignRequest : public JsonCompatible {
   REGISTER_STRUCT_FIELD(subcompany, std::string, "subcompany");
   REGISTER_STRUCT_FIELD(file_key, std::string, "file_key");
   REGISTER_STRUCT_FIELD(signed_file_key, std::string, "signed_file_key");
+
+  JSON_FIELDS(employee_id, employee_name, employee_surname, employee_patronymic,
+              subcompany, file_key, signed_file_key);
 };
 #endif
 
 #ifdef USE_ABSCENCE_REQUEST_REQUEST
-struct AbscenceRequestRequest : public JsonCompatible {
+struct AbscenceRequestRequest : public JsonCompatible<AbscenceRequestRequest> {
   REGISTER_STRUCT_FIELD(start_date, userver::storages::postgres::TimePoint,
                         "start_date");
   REGISTER_STRUCT_FIELD(end_date, userver::storages::postgres::TimePoint,
                         "end_date");
   REGISTER_STRUCT_FIELD(type, std::string, "type");
+
+  JSON_FIELDS(start_date, end_date, type);
 };
 #endif
 
 #ifdef USE_ABSCENCE_REQUEST_RESPONSE
-struct AbscenceRequestResponse : public JsonCompatible {
+struct AbscenceRequestResponse
+    : public JsonCompatible<AbscenceRequestResponse> {
   REGISTER_STRUCT_FIELD(action_id, std::string, "action_id");
+
+  JSON_FIELDS(action_id);
 };
 #endif
 
@@ -544,7 +628,7 @@ struct InventoryItemPg {
   std::string id;
 };
 
-struct InventoryItem : public JsonCompatible {
+struct InventoryItem : public JsonCompatible<InventoryItem> {
   InventoryItem() = default;
   InventoryItem(const InventoryItemPg& pg) {
     name = pg.name;
@@ -552,15 +636,13 @@ struct InventoryItem : public JsonCompatible {
     id = pg.id;
   }
 
-  InventoryItem(InventoryItem&& other) { *this = std::move(other); }
-
-  InventoryItem& operator=(InventoryItem&& other) = default;
-
   auto Introspect() { return std::tie(name, description, id); }
 
   REGISTER_STRUCT_FIELD(name, std::string, "name");
   REGISTER_STRUCT_FIELD_OPTIONAL(description, std::string, "description");
   REGISTER_STRUCT_FIELD_OPTIONAL(id, std::string, "id");
+
+  JSON_FIELDS(name, description, id);
 };
 
 template <>
@@ -570,20 +652,16 @@ struct userver::storages::postgres::io::CppToUserPg<InventoryItemPg> {
 #endif
 
 #ifdef USE_INVENTORY_ADD_REQUEST
-struct InventoryAddRequest : public JsonCompatible {
+struct InventoryAddRequest : public JsonCompatible<InventoryAddRequest> {
   REGISTER_STRUCT_FIELD(item, InventoryItem, "item");
   REGISTER_STRUCT_FIELD(employee_id, std::string, "employee_id");
+
+  JSON_FIELDS(item, employee_id);
 };
 #endif
 
 #ifdef USE_EMPLOYEE
-struct Employee : public JsonCompatible {
-  Employee() = default;
-
-  Employee(Employee&& other) { *this = std::move(other); }
-
-  Employee& operator=(Employee&& other) = default;
-
+struct Employee : public JsonCompatible<Employee> {
   auto Introspect() {
     return std::tie(id, name, surname, patronymic, photo_link, phones, email,
                     birthday, password, head_id, telegram_id, vk_id, team,
@@ -606,5 +684,88 @@ struct Employee : public JsonCompatible {
   REGISTER_STRUCT_FIELD_OPTIONAL(head_info, ListEmployee, "head_info");
   REGISTER_STRUCT_FIELD_OPTIONAL(inventory, std::vector<InventoryItem>,
                                  "inventory");
+
+  JSON_FIELDS(id, name, surname, patronymic, photo_link, phones, email,
+              birthday, password, head_id, telegram_id, vk_id, team, head_info,
+              inventory);
+};
+#endif
+
+#ifdef USE_NOTIFICATION
+struct Notification : public JsonCompatible<Notification> {
+  auto Introspect() {
+    return std::tie(id, type, text, is_read, sender, action_id, created);
+  }
+
+  REGISTER_STRUCT_FIELD(id, std::string, "id");
+  REGISTER_STRUCT_FIELD(type, std::string, "type");
+  REGISTER_STRUCT_FIELD(text, std::string, "text");
+  REGISTER_STRUCT_FIELD(is_read, bool, "is_read");
+  REGISTER_STRUCT_FIELD_OPTIONAL(sender, ListEmployee, "sender");
+  REGISTER_STRUCT_FIELD_OPTIONAL(action_id, std::string, "action_id");
+  REGISTER_STRUCT_FIELD(created, userver::storages::postgres::TimePoint,
+                        "created");
+
+  JSON_FIELDS(id, type, text, is_read, sender, action_id, created);
+};
+#endif
+
+#ifdef USE_NOTIFICATIONS_UNREAD_RESPONSE
+struct NotificationsUnreadResponse
+    : public JsonCompatible<NotificationsUnreadResponse> {
+  REGISTER_STRUCT_FIELD(unread, int, "unread");
+
+  JSON_FIELDS(unread);
+};
+#endif
+
+#ifdef USE_NOTIFICATIONS_READ_REQUEST
+struct NotificationsReadRequest
+    : public JsonCompatible<NotificationsReadRequest> {
+  REGISTER_STRUCT_FIELD_OPTIONAL(ids, std::vector<std::string>, "ids");
+
+  JSON_FIELDS(ids);
+};
+#endif
+
+#ifdef USE_PAYMENT_ITEM
+// Every field is optional so that a malformed row is reported on its own
+// instead of failing the whole request
+struct PaymentItem : public JsonCompatible<PaymentItem> {
+  REGISTER_STRUCT_FIELD_OPTIONAL(id, std::string, "id");
+  REGISTER_STRUCT_FIELD_OPTIONAL(user_id, std::string, "user_id");
+  REGISTER_STRUCT_FIELD_OPTIONAL(amount, double, "amount");
+  REGISTER_STRUCT_FIELD_OPTIONAL(payroll_date, std::string, "payroll_date");
+
+  JSON_FIELDS(id, user_id, amount, payroll_date);
+};
+#endif
+
+#ifdef USE_PAYMENTS_ADD_BULK_REQUEST
+struct PaymentsAddBulkRequest : public JsonCompatible<PaymentsAddBulkRequest> {
+  REGISTER_STRUCT_FIELD(payments, std::vector<PaymentItem>, "payments");
+
+  JSON_FIELDS(payments);
+};
+#endif
+
+#ifdef USE_PAYMENT_ROW_ERROR
+struct PaymentRowError : public JsonCompatible<PaymentRowError> {
+  REGISTER_STRUCT_FIELD(index, int, "index");
+  REGISTER_STRUCT_FIELD_OPTIONAL(id, std::string, "id");
+  REGISTER_STRUCT_FIELD(message, std::string, "message");
+
+  JSON_FIELDS(index, id, message);
+};
+#endif
+
+#ifdef USE_PAYMENTS_ADD_BULK_RESPONSE
+struct PaymentsAddBulkResponse
+    : public JsonCompatible<PaymentsAddBulkResponse> {
+  REGISTER_STRUCT_FIELD(inserted, int, "inserted", 0);
+  REGISTER_STRUCT_FIELD(existing, int, "existing", 0);
+  REGISTER_STRUCT_FIELD(errors, std::vector<PaymentRowError>, "errors");
+
+  JSON_FIELDS(inserted, existing, errors);
 };
 #endif
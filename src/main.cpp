@@ -14,8 +14,21 @@
 #include <aws/core/auth/AWSCredentialsProvider.h>
 
 #include "auth/auth_bearer.hpp"
+#include "auth/revocation_cache.hpp"
+#include "auth/token_signer.hpp"
+#include "auth/token_store.hpp"
 #include "auth/user_info_cache.hpp"
+#include "core/attendance_calendar/component.hpp"
+#include "core/docx_template/component.hpp"
+#include "core/job_queue/component.hpp"
+#include "core/notification_hub/component.hpp"
+#include "core/org_tree/component.hpp"
+#include "core/read_routing/component.hpp"
+#include "core/reverse_index/pipeline.hpp"
+#include "core/search_index/component.hpp"
 #include "utils/custom_implicit_options.hpp"
+#include "utils/s3_presigned_links.hpp"
+#include "views/v1/abscence/document_status/view.hpp"
 #include "views/v1/abscence/request/view.hpp"
 #include "views/v1/abscence/reschedule/view.hpp"
 #include "views/v1/abscence/split/view.hpp"
@@ -31,6 +44,7 @@
 #include "views/v1/documents/list_all/view.hpp"
 #include "views/v1/documents/send/view.hpp"
 #include "views/v1/documents/sign/view.hpp"
+#include "views/v1/documents/sign_status/view.hpp"
 #include "views/v1/documents/upload/view.hpp"
 #include "views/v1/documents/vacation/view.hpp"
 #include "views/v1/employee/add/view.hpp"
@@ -39,7 +53,10 @@
 #include "views/v1/employee/remove/view.hpp"
 #include "views/v1/employees/view.hpp"
 #include "views/v1/inventory/add/view.hpp"
+#include "views/v1/notifications/read/view.hpp"
+#include "views/v1/notifications/unread/view.hpp"
 #include "views/v1/notifications/view.hpp"
+#include "views/v1/notifications/wait/view.hpp"
 #include "views/v1/payments/add_bulk/view.hpp"
 #include "views/v1/payments/view.hpp"
 #include "views/v1/profile/edit/view.hpp"
@@ -68,6 +85,18 @@ int main(int argc, char* argv[]) {
           .Append<userver::components::Postgres>("key-value")
           .Append<userver::clients::dns::Component>()
           .Append<auth::AuthCache>()
+          .Append<auth::RevocationCache>()
+          .Append<auth::TokenSigner>()
+          .Append<auth::TokenStore>()
+          .Append<core::read_routing::ReadRouter>()
+          .Append<core::job_queue::JobQueue>()
+          .Append<core::notification_hub::NotificationHub>()
+          .Append<core::docx_template::TemplateStore>()
+          .Append<core::reverse_index::Pipeline>()
+          .Append<core::search_index::SearchIndex>()
+          .Append<core::attendance_calendar::AttendanceCalendar>()
+          .Append<core::org_tree::OrgTreeCache>()
+          .Append<utils::s3_presigned_links::Presigner>()
           .Append<utils::custom_implicit_options::CustomImplicitOptions>();
 
   views::v1::employee::add::AppendAddEmployee(component_list);
@@ -80,7 +109,13 @@ int main(int argc, char* argv[]) {
   views::v1::authorize::AppendAuthorize(component_list);
   views::v1::abscence::request::AppendAbscenceRequest(component_list);
   views::v1::abscence::verdict::AppendAbscenceVerdict(component_list);
+  views::v1::abscence::document_status::AppendAbscenceDocumentStatus(
+      component_list);
   views::v1::notifications::AppendNotifications(component_list);
+  views::v1::notifications::unread::AppendNotificationsUnread(
+      component_list);
+  views::v1::notifications::read::AppendNotificationsRead(component_list);
+  views::v1::notifications::wait::AppendNotificationsWait(component_list);
   views::v1::actions::AppendActions(component_list);
   views::v1::documents::vacation::AppendDocumentsVacation(component_list);
   views::v1::attendance::add::AppendAttendanceAdd(component_list);
@@ -98,6 +133,8 @@ int main(int argc, char* argv[]) {
   views::v1::documents::list::AppendDocumentsList(component_list);
   views::v1::documents::download::AppendDocumentsDownload(component_list);
   views::v1::documents::sign::AppendDocumentsSign(component_list);
+  views::v1::documents::sign_status::AppendDocumentsSignStatus(
+      component_list);
   views::v1::documents::list_all::AppendDocumentsListAll(component_list);
   views::v1::documents::get_signs::AppendDocumentsGetSigns(component_list);
   views::v1::superuser::company::add::AppendSuperuserCompanyAdd(component_list);
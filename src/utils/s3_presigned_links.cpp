@@ -1,51 +1,173 @@
 #include "s3_presigned_links.hpp"
 
+#include <algorithm>
+
 #include <aws/core/Aws.h>
 #include <aws/core/auth/AWSCredentialsProvider.h>
 #include <aws/http/http.h>
 #include <aws/s3/S3Client.h>
 
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
 namespace utils::s3_presigned_links {
 
-std::string GeneratePresignedLink(const std::string& key, const LinkType type,
-                                  const std::string& bucket) {
-  std::string result;
+namespace {
+
+constexpr size_t kCacheWays = 16;
+constexpr size_t kDefaultCacheSize = 16384;
+constexpr std::chrono::seconds kDefaultLinkTtl{600};
+constexpr std::chrono::seconds kDefaultRefreshBeforeExpiry{60};
+constexpr size_t kDefaultParallelThreshold = 32;
+
+}  // namespace
 
-  {
-    Aws::Client::ClientConfiguration config;
-    config.region = Aws::String("ru-central1");
-    config.endpointOverride = Aws::String("https://storage.yandexcloud.net");
+Presigner::Presigner(const userver::components::ComponentConfig& config,
+                     const userver::components::ComponentContext& context)
+    : LoggableComponentBase(config, context),
+      photos_bucket_(
+          config["photos-bucket"].As<std::string>("working-day-photos")),
+      documents_bucket_(
+          config["documents-bucket"].As<std::string>("working-day-documents")),
+      link_ttl_(config["link-ttl"].As<std::chrono::seconds>(kDefaultLinkTtl)),
+      refresh_before_expiry_(
+          config["refresh-before-expiry"].As<std::chrono::seconds>(
+              kDefaultRefreshBeforeExpiry)),
+      parallel_threshold_(std::max<size_t>(
+          config["parallel-threshold"].As<size_t>(kDefaultParallelThreshold),
+          1)),
+      task_processor_(context.GetTaskProcessor(
+          config["task-processor"].As<std::string>())),
+      links_(kCacheWays,
+             config["cache-size"].As<size_t>(kDefaultCacheSize) / kCacheWays) {
+  Aws::Client::ClientConfiguration client_config;
+  client_config.region =
+      Aws::String(config["region"].As<std::string>("ru-central1"));
+  client_config.endpointOverride = Aws::String(
+      config["endpoint"].As<std::string>("https://storage.yandexcloud.net"));
+  client_ = std::make_unique<Aws::S3::S3Client>(client_config);
+}
+
+Presigner::~Presigner() = default;
 
-    Aws::String bucket_name = bucket;
-    Aws::S3::S3Client s3_client(config);
+std::string Presigner::GeneratePhotoPresignedLink(const std::string& key,
+                                                  const LinkType type) const {
+  return GeneratePresignedLink(photos_bucket_, key, type);
+}
 
-    switch (type) {
-      case LinkType::Upload:
-        result = s3_client.GeneratePresignedUrl(
-            bucket_name, key, Aws::Http::HttpMethod::HTTP_PUT, 600);
-        break;
+std::string Presigner::GenerateDocumentPresignedLink(
+    const std::string& key, const LinkType type) const {
+  return GeneratePresignedLink(documents_bucket_, key, type);
+}
 
-      case LinkType::Download:
-        result = s3_client.GeneratePresignedUrl(
-            bucket_name, key, Aws::Http::HttpMethod::HTTP_GET, 600);
-        break;
+std::vector<std::string> Presigner::GeneratePhotoPresignedLinks(
+    std::span<const std::string> keys, const LinkType type) const {
+  return GeneratePresignedLinks(photos_bucket_, keys, type);
+}
 
-      default:
-        break;
+std::vector<std::string> Presigner::GeneratePresignedLinks(
+    const std::string& bucket, std::span<const std::string> keys,
+    const LinkType type) const {
+  std::vector<std::string> links(keys.size());
+  if (keys.size() < parallel_threshold_) {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      links[i] = GeneratePresignedLink(bucket, keys[i], type);
     }
+    return links;
   }
 
-  return result;
+  std::vector<userver::engine::TaskWithResult<void>> tasks;
+  for (size_t begin = 0; begin < keys.size(); begin += parallel_threshold_) {
+    const auto end = std::min(begin + parallel_threshold_, keys.size());
+    tasks.push_back(userver::utils::Async(
+        task_processor_, "presign-links", [&, begin, end] {
+          for (size_t i = begin; i < end; ++i) {
+            links[i] = GeneratePresignedLink(bucket, keys[i], type);
+          }
+        }));
+  }
+  for (auto& task : tasks) {
+    task.Get();
+  }
+  return links;
 }
 
-std::string GeneratePhotoPresignedLink(const std::string& key,
-                                       const LinkType type) {
-  return GeneratePresignedLink(key, type, "working-day-photos");
+std::string Presigner::GeneratePresignedLink(const std::string& bucket,
+                                             const std::string& key,
+                                             const LinkType type) const {
+  switch (type) {
+    case LinkType::Upload:
+      // Upload keys are fresh every time, there is nothing to reuse
+      return client_->GeneratePresignedUrl(bucket, key,
+                                           Aws::Http::HttpMethod::HTTP_PUT,
+                                           link_ttl_.count());
+
+    case LinkType::Download: {
+      const auto cache_key = bucket + '/' + key;
+      const auto now = std::chrono::steady_clock::now();
+      auto cached = links_.Get(cache_key, [now](const CachedLink& link) {
+        return now < link.refresh_after;
+      });
+      if (cached.has_value()) {
+        return std::move(cached->url);
+      }
+
+      std::string url = client_->GeneratePresignedUrl(
+          bucket, key, Aws::Http::HttpMethod::HTTP_GET, link_ttl_.count());
+      links_.Put(cache_key,
+                 CachedLink{url, now + link_ttl_ - refresh_before_expiry_});
+      return url;
+    }
+
+    default:
+      return {};
+  }
 }
 
-std::string GenerateDocumentPresignedLink(const std::string& key,
-                                          const LinkType type) {
-  return GeneratePresignedLink(key, type, "working-day-documents");
+userver::yaml_config::Schema Presigner::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::LoggableComponentBase>(R"(
+type: object
+description: S3 presigned links generator
+additionalProperties: false
+properties:
+    region:
+        type: string
+        description: S3 region
+        defaultDescription: ru-central1
+    endpoint:
+        type: string
+        description: S3 endpoint
+        defaultDescription: https://storage.yandexcloud.net
+    photos-bucket:
+        type: string
+        description: bucket with employee photos
+        defaultDescription: working-day-photos
+    documents-bucket:
+        type: string
+        description: bucket with documents
+        defaultDescription: working-day-documents
+    link-ttl:
+        type: string
+        description: lifetime of generated links
+        defaultDescription: 600s
+    refresh-before-expiry:
+        type: string
+        description: cached download links are regenerated this long before they expire
+        defaultDescription: 60s
+    cache-size:
+        type: integer
+        description: max number of cached download links
+        defaultDescription: 16384
+    task-processor:
+        type: string
+        description: task processor to sign long lists of links on
+    parallel-threshold:
+        type: integer
+        description: lists of at least this many links are signed in parallel, this many links per task
+        defaultDescription: 32
+)");
 }
 
-}  // namespace utils::s3_presigned_links
\ No newline at end of file
+}  // namespace utils::s3_presigned_links
@@ -1,4 +1,22 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <vector>
+
+#include <userver/cache/nway_lru_cache.hpp>
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+namespace Aws::S3 {
+class S3Client;
+}  // namespace Aws::S3
 
 namespace utils::s3_presigned_links {
 
@@ -7,10 +25,71 @@ enum LinkType {
   Download = 2,
 };
 
-std::string GeneratePhotoPresignedLink(const std::string& key,
-                                       const LinkType type);
+// Owns a single S3 client for all buckets. Links are signed locally and
+// download links are reused until they get close to their expiry.
+class Presigner final : public userver::components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName = "s3-presigner";
+
+  Presigner(const userver::components::ComponentConfig& config,
+            const userver::components::ComponentContext& context);
+
+  ~Presigner() override;
+
+  std::string GeneratePhotoPresignedLink(const std::string& key,
+                                         const LinkType type) const;
+
+  std::string GenerateDocumentPresignedLink(const std::string& key,
+                                            const LinkType type) const;
+
+  // Links are returned in the order of keys. Long lists are signed in
+  // parallel on the presigner task processor.
+  std::vector<std::string> GeneratePhotoPresignedLinks(
+      std::span<const std::string> keys, const LinkType type) const;
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  struct CachedLink {
+    std::string url;
+    std::chrono::steady_clock::time_point refresh_after;
+  };
+
+  std::string GeneratePresignedLink(const std::string& bucket,
+                                    const std::string& key,
+                                    const LinkType type) const;
+
+  std::vector<std::string> GeneratePresignedLinks(
+      const std::string& bucket, std::span<const std::string> keys,
+      const LinkType type) const;
+
+  const std::string photos_bucket_;
+  const std::string documents_bucket_;
+  const std::chrono::seconds link_ttl_;
+  const std::chrono::seconds refresh_before_expiry_;
+  const size_t parallel_threshold_;
+  userver::engine::TaskProcessor& task_processor_;
+  std::unique_ptr<Aws::S3::S3Client> client_;
+  mutable userver::cache::NWayLRU<std::string, CachedLink> links_;
+};
+
+// Replaces photo keys of the employees with download links
+template <class Employees>
+void SetPhotoDownloadLinks(const Presigner& presigner, Employees& employees) {
+  std::vector<std::string> keys;
+  for (const auto& employee : employees) {
+    if (employee.photo_link.has_value()) {
+      keys.push_back(employee.photo_link.value());
+    }
+  }
 
-std::string GenerateDocumentPresignedLink(const std::string& key,
-                                          const LinkType type);
+  auto links = presigner.GeneratePhotoPresignedLinks(keys, Download);
+  auto link = links.begin();
+  for (auto& employee : employees) {
+    if (employee.photo_link.has_value()) {
+      employee.photo_link = std::move(*link++);
+    }
+  }
+}
 
-}  // namespace utils::s3_presigned_links
\ No newline at end of file
+}  // namespace utils::s3_presigned_links
@@ -0,0 +1,72 @@
+#define V1_ABSCENCE_DOCUMENT_STATUS
+
+#include "view.hpp"
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/server/handlers/http_handler_base.hpp>
+
+#include "core/job_queue/component.hpp"
+#include "definitions/all.hpp"
+#include "views/v1/abscence/verdict/view.hpp"
+
+namespace views::v1::abscence::document_status {
+
+namespace {
+
+class AbscenceDocumentStatusHandler final
+    : public userver::server::handlers::HttpHandlerBase {
+ public:
+  static constexpr std::string_view kName =
+      "handler-v1-abscence-document-status";
+
+  AbscenceDocumentStatusHandler(
+      const userver::components::ComponentConfig& config,
+      const userver::components::ComponentContext& component_context)
+      : HttpHandlerBase(config, component_context),
+        job_queue_(
+            component_context.FindComponent<core::job_queue::JobQueue>()) {}
+
+  std::string HandleRequestThrow(
+      const userver::server::http::HttpRequest& request,
+      userver::server::request::RequestContext& ctx) const override {
+    // CORS
+    request.GetHttpResponse().SetHeader(
+        static_cast<std::string>("Access-Control-Allow-Origin"), "*");
+    request.GetHttpResponse().SetHeader(
+        static_cast<std::string>("Access-Control-Allow-Headers"), "*");
+
+    const auto& company_id = ctx.GetData<std::string>("company_id");
+    const auto& action_id = request.GetArg("action_id");
+
+    const auto job = job_queue_.GetStatus(verdict::kVacationDocumentJob,
+                                          company_id, action_id);
+    if (!job.has_value()) {
+      request.GetHttpResponse().SetStatus(
+          userver::server::http::HttpStatus::kNotFound);
+      return ErrorMessage{"No document is generated for this action"}
+          .ToJsonString();
+    }
+
+    AbscenceDocumentStatusResponse response;
+    response.status = job->status;
+    response.attempts = job->attempts;
+    response.error = job->error;
+    if (job->status == "done") {
+      response.document_id = job->id + ".pdf";
+    }
+    return response.ToJsonString();
+  }
+
+ private:
+  const core::job_queue::JobQueue& job_queue_;
+};
+
+}  // namespace
+
+void AppendAbscenceDocumentStatus(
+    userver::components::ComponentList& component_list) {
+  component_list.Append<AbscenceDocumentStatusHandler>();
+}
+
+}  // namespace views::v1::abscence::document_status
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <userver/components/component_list.hpp>
+
+namespace views::v1::abscence::document_status {
+
+void AppendAbscenceDocumentStatus(
+    userver::components::ComponentList& component_list);
+
+}  // namespace views::v1::abscence::document_status
@@ -3,6 +3,8 @@
 
 #include "view.hpp"
 
+#include <nlohmann/json.hpp>
+
 #include <userver/clients/dns/component.hpp>
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
@@ -12,6 +14,9 @@
 #include <userver/storages/postgres/component.hpp>
 #include <userver/utils/uuid4.hpp>
 
+#include "core/org_tree/component.hpp"
+#include "core/read_routing/component.hpp"
+#include "core/tenant_query/query.hpp"
 #include "definitions/all.hpp"
 
 #include <fmt/core.h>
@@ -24,10 +29,21 @@ const std::string tz = "UTC";
 
 namespace {
 
-class HeadId {
- public:
-  std::optional<std::string> head_id;
-};
+const core::tenant_query::TenantQuery kInsertAction{
+    "request_action_insert",
+    "INSERT INTO {schema}.actions(id, type, user_id, start_date, "
+    "end_date, status) "
+    "VALUES($1, $2, $3, $4, $5, $6) "
+    "ON CONFLICT (id) "
+    "DO NOTHING"};
+
+const core::tenant_query::TenantQuery kInsertNotification{
+    "request_notification_insert",
+    "INSERT INTO {schema}.notifications(id, type, text, user_id, "
+    "sender_id, action_id) "
+    "VALUES($1, $2, $3, $4, $5, $6) "
+    "ON CONFLICT (id) "
+    "DO NOTHING"};
 
 class AbscenceRequestHandler final
     : public userver::server::handlers::HttpHandlerBase {
@@ -41,7 +57,12 @@ class AbscenceRequestHandler final
         pg_cluster_(
             component_context
                 .FindComponent<userver::components::Postgres>("key-value")
-                .GetCluster()) {}
+                .GetCluster()),
+        read_router_(
+            component_context
+                .FindComponent<core::read_routing::ReadRouter>()),
+        org_tree_(
+            component_context.FindComponent<core::org_tree::OrgTreeCache>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -106,42 +127,24 @@ class AbscenceRequestHandler final
           1439min;  // + 23:59
     }
 
+    auto head_id = org_tree_.GetHead(company_id, user_id);
+
     auto trx = pg_cluster_->Begin(
         "request_abscence",
         userver::storages::postgres::ClusterHostType::kMaster, {});
 
-    auto result = trx.Execute("INSERT INTO working_day_" + company_id +
-                                  ".actions(id, type, user_id, start_date, "
-                                  "end_date, status) "
-                                  "VALUES($1, $2, $3, $4, $5, $6) "
-                                  "ON CONFLICT (id) "
-                                  "DO NOTHING",
-                              action_id, request_body.type, user_id,
+    auto result = trx.Execute(kInsertAction.For(company_id), action_id,
+                              request_body.type, user_id,
                               request_body.start_date, request_body.end_date,
                               action_status);
 
-    auto head_id =
-        trx.Execute(
-               "SELECT head_id "
-               "FROM working_day_" +
-                   company_id +
-                   ".employees "
-                   "WHERE id = $1",
-               user_id)
-            .AsSingleRow<HeadId>(userver::storages::postgres::kRowTag)
-            .head_id;
-
     auto notification_id = userver::utils::generators::GenerateUuid();
-    result = trx.Execute("INSERT INTO working_day_" + company_id +
-                             ".notifications(id, type, text, user_id, "
-                             "sender_id, action_id) "
-                             "VALUES($1, $2, $3, $4, $5, $6) "
-                             "ON CONFLICT (id) "
-                             "DO NOTHING",
-                         notification_id, "vacation_request", notification_text,
+    result = trx.Execute(kInsertNotification.For(company_id), notification_id,
+                         "vacation_request", notification_text,
                          head_id.value_or(user_id), user_id, action_id);
 
     trx.Commit();
+    read_router_.MarkWrite(request, ctx);
 
     AbscenceRequestResponse response;
     response.action_id = action_id;
@@ -150,6 +153,8 @@ class AbscenceRequestHandler final
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  core::read_routing::ReadRouter& read_router_;
+  core::org_tree::OrgTreeCache& org_tree_;
 };
 
 }  // namespace
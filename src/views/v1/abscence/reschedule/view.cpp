@@ -13,6 +13,11 @@
 #include <userver/storages/postgres/component.hpp>
 #include <userver/utils/uuid4.hpp>
 
+#include "core/attendance_calendar/component.hpp"
+#include "core/org_tree/component.hpp"
+#include "core/read_routing/component.hpp"
+#include "core/tenant_query/query.hpp"
+
 using json = nlohmann::json;
 
 namespace views::v1::abscence::reschedule {
@@ -21,6 +26,34 @@ const std::string tz = "UTC";
 
 namespace {
 
+const core::tenant_query::TenantQuery kSelectAction{
+    "reschedule_action_select",
+    "SELECT id, type, start_date, end_date, status, user_id "
+    "FROM {schema}.actions "
+    "WHERE id = $1"};
+
+const core::tenant_query::TenantQuery kInsertAction{
+    "reschedule_action_insert",
+    "INSERT INTO {schema}.actions(id, type, user_id, start_date, "
+    "end_date, status, underlying_action_id) "
+    "VALUES($1, $2, $3, $4, $5, $6, $7) "
+    "ON CONFLICT (id) "
+    "DO NOTHING"};
+
+const core::tenant_query::TenantQuery kBlockAction{
+    "reschedule_action_block",
+    "UPDATE {schema}.actions "
+    "SET blocking_actions_ids = $2 "
+    "WHERE id = $1"};
+
+const core::tenant_query::TenantQuery kInsertNotification{
+    "reschedule_notification_insert",
+    "INSERT INTO {schema}.notifications(id, type, text, user_id, "
+    "sender_id, action_id) "
+    "VALUES($1, $2, $3, $4, $5, $6) "
+    "ON CONFLICT (id) "
+    "DO NOTHING"};
+
 class AbscenceRescheduleRequest {
  public:
   AbscenceRescheduleRequest(const std::string& body) {
@@ -48,11 +81,6 @@ class AbscenceRescheduleResponse {
   std::string action_id;
 };
 
-class HeadId {
- public:
-  std::optional<std::string> head_id;
-};
-
 class UserAction {
  public:
   std::string id, type;
@@ -85,7 +113,14 @@ class AbscenceRescheduleHandler final
         pg_cluster_(
             component_context
                 .FindComponent<userver::components::Postgres>("key-value")
-                .GetCluster()) {}
+                .GetCluster()),
+        calendar_(component_context.FindComponent<
+                  core::attendance_calendar::AttendanceCalendar>()),
+        read_router_(
+            component_context
+                .FindComponent<core::read_routing::ReadRouter>()),
+        org_tree_(
+            component_context.FindComponent<core::org_tree::OrgTreeCache>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -108,36 +143,21 @@ class AbscenceRescheduleHandler final
         userver::storages::postgres::ClusterHostType::kMaster, {});
 
     auto action_to_reschedule =
-        trx.Execute(
-               "SELECT id, type, start_date, end_date, status, user_id "
-               "FROM working_day_" +
-                   company_id +
-                   ".actions "
-                   "WHERE id = $1",
-               request_body.action_id)
+        trx.Execute(kSelectAction.For(company_id), request_body.action_id)
             .AsSingleRow<UserAction>(userver::storages::postgres::kRowTag);
     auto action_status = action_to_reschedule.status;
 
     auto new_action_id = userver::utils::generators::GenerateUuid();
 
     auto result = trx.Execute(
-        "INSERT INTO working_day_" + company_id +
-            ".actions(id, type, user_id, start_date, "
-            "end_date, status, underlying_action_id) "
-            "VALUES($1, $2, $3, $4, $5, $6, $7) "
-            "ON CONFLICT (id) "
-            "DO NOTHING",
-        new_action_id, action_to_reschedule.type, user_id,
-        request_body.reschedule_date,
+        kInsertAction.For(company_id), new_action_id,
+        action_to_reschedule.type, user_id, request_body.reschedule_date,
         request_body.reschedule_date +
             (action_to_reschedule.end_date - action_to_reschedule.start_date),
         action_status, request_body.action_id);
 
-    result = trx.Execute("UPDATE working_day_" + company_id +
-                             ".actions "
-                             "SET blocking_actions_ids = $2 "
-                             "WHERE id = $1",
-                         request_body.action_id, std::vector{new_action_id});
+    result = trx.Execute(kBlockAction.For(company_id), request_body.action_id,
+                         std::vector{new_action_id});
 
     std::string sender_id = user_id;
     if (user_id == action_to_reschedule.user_id) {
@@ -180,16 +200,7 @@ class AbscenceRescheduleHandler final
       action_id);
       } */
     } else {
-      auto head_id =
-          trx.Execute(
-                 "SELECT head_id "
-                 "FROM working_day_" +
-                     company_id +
-                     ".employees "
-                     "WHERE id = $1",
-                 user_id)
-              .AsSingleRow<HeadId>(userver::storages::postgres::kRowTag)
-              .head_id;
+      auto head_id = org_tree_.GetHead(company_id, user_id);
       if (head_id.has_value()) {
         sender_id = head_id.value();
       }
@@ -203,17 +214,14 @@ class AbscenceRescheduleHandler final
           ".";
     }
     auto notification_id = userver::utils::generators::GenerateUuid();
-    result = trx.Execute(
-        "INSERT INTO working_day_" + company_id +
-            ".notifications(id, type, text, user_id, "
-            "sender_id, action_id) "
-            "VALUES($1, $2, $3, $4, $5, $6) "
-            "ON CONFLICT (id) "
-            "DO NOTHING",
-        notification_id, action_to_reschedule.type + "_reschedule",
-        notification_text, user_id, sender_id, request_body.action_id);
+    result = trx.Execute(kInsertNotification.For(company_id), notification_id,
+                         action_to_reschedule.type + "_reschedule",
+                         notification_text, user_id, sender_id,
+                         request_body.action_id);
 
     trx.Commit();
+    calendar_.RefreshEmployee(company_id, user_id);
+    read_router_.MarkWrite(request, ctx);
 
     AbscenceRescheduleResponse response{new_action_id};
     return response.ToJSON();
@@ -221,6 +229,9 @@ class AbscenceRescheduleHandler final
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  core::attendance_calendar::AttendanceCalendar& calendar_;
+  core::read_routing::ReadRouter& read_router_;
+  core::org_tree::OrgTreeCache& org_tree_;
 };
 
 }  // namespace
@@ -13,6 +13,10 @@
 #include <userver/storages/postgres/component.hpp>
 #include <userver/utils/uuid4.hpp>
 
+#include "core/attendance_calendar/component.hpp"
+#include "core/read_routing/component.hpp"
+#include "core/tenant_query/query.hpp"
+
 using json = nlohmann::json;
 
 namespace views::v1::abscence::split {
@@ -21,6 +25,35 @@ const std::string tz = "UTC";
 
 namespace {
 
+const core::tenant_query::TenantQuery kSelectAction{
+    "split_action_select",
+    "SELECT id, type, start_date, end_date, status "
+    "FROM {schema}.actions "
+    "WHERE id = $1"};
+
+const core::tenant_query::TenantQuery kInsertActions{
+    "split_actions_insert",
+    "INSERT INTO {schema}.actions(id, type, user_id, start_date, "
+    "end_date, status, underlying_action_id) "
+    "VALUES($1, $2, $3, $4, $5, $6, $7), "
+    "($8, $9, $10, $11, $12, $13, $14) "
+    "ON CONFLICT (id) "
+    "DO NOTHING"};
+
+const core::tenant_query::TenantQuery kBlockAction{
+    "split_action_block",
+    "UPDATE {schema}.actions "
+    "SET blocking_actions_ids = $2 "
+    "WHERE id = $1"};
+
+const core::tenant_query::TenantQuery kInsertNotification{
+    "split_notification_insert",
+    "INSERT INTO {schema}.notifications(id, type, text, user_id, "
+    "sender_id, action_id) "
+    "VALUES($1, $2, $3, $4, $5, $6) "
+    "ON CONFLICT (id) "
+    "DO NOTHING"};
+
 class AbscenceSplitRequest {
  public:
   AbscenceSplitRequest(const std::string& body) {
@@ -85,7 +118,12 @@ class AbscenceSplitHandler final
         pg_cluster_(
             component_context
                 .FindComponent<userver::components::Postgres>("key-value")
-                .GetCluster()) {}
+                .GetCluster()),
+        calendar_(component_context.FindComponent<
+                  core::attendance_calendar::AttendanceCalendar>()),
+        read_router_(
+            component_context
+                .FindComponent<core::read_routing::ReadRouter>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -108,13 +146,7 @@ class AbscenceSplitHandler final
         {});
 
     auto action_to_split =
-        trx.Execute(
-               "SELECT id, type, start_date, end_date, status "
-               "FROM working_day_" +
-                   company_id +
-                   ".actions "
-                   "WHERE id = $1",
-               request_body.action_id)
+        trx.Execute(kSelectAction.For(company_id), request_body.action_id)
             .AsSingleRow<UserAction>(userver::storages::postgres::kRowTag);
     auto action_status = action_to_split.status;
 
@@ -130,40 +162,24 @@ class AbscenceSplitHandler final
     auto second_action_id = userver::utils::generators::GenerateUuid();
 
     auto result = trx.Execute(
-        "INSERT INTO working_day_" + company_id +
-            ".actions(id, type, user_id, start_date, "
-            "end_date, status, underlying_action_id) "
-            "VALUES($1, $2, $3, $4, $5, $6, $7), "
-            "($8, $9, $10, $11, $12, $13, $14) "
-            "ON CONFLICT (id) "
-            "DO NOTHING",
-        first_action_id, action_to_split.type, user_id,
-        action_to_split.start_date, request_body.split_date + 1439min,
+        kInsertActions.For(company_id), first_action_id, action_to_split.type,
+        user_id, action_to_split.start_date, request_body.split_date + 1439min,
         action_status, request_body.action_id, second_action_id,
         action_to_split.type, user_id, request_body.split_date + 1440min,
         action_to_split.end_date, action_status, request_body.action_id);
 
-    result = trx.Execute("UPDATE working_day_" + company_id +
-                             ".actions "
-                             "SET blocking_actions_ids = $2 "
-                             "WHERE id = $1",
-                         request_body.action_id,
+    result = trx.Execute(kBlockAction.For(company_id), request_body.action_id,
                          std::vector{first_action_id, second_action_id});
 
     auto notification_id = userver::utils::generators::GenerateUuid();
-    result =
-        trx.Execute("INSERT INTO working_day_" + company_id +
-                        ".notifications(id, type, text, user_id, "
-                        "sender_id, action_id) "
-                        "VALUES($1, $2, $3, $4, $5, $6) "
-                        "ON CONFLICT (id) "
-                        "DO NOTHING",
-                    notification_id, action_to_split.type + "_split",
-                    "Ваш отпуск с " +
-                        userver::utils::datetime::Timestring(
-                            action_to_split.start_date, "UTC", "%d.%m.%Y") +
-                        " был разделен на две части.",
-                    user_id, user_id, request_body.action_id);
+    result = trx.Execute(
+        kInsertNotification.For(company_id), notification_id,
+        action_to_split.type + "_split",
+        "Ваш отпуск с " +
+            userver::utils::datetime::Timestring(action_to_split.start_date,
+                                                 "UTC", "%d.%m.%Y") +
+            " был разделен на две части.",
+        user_id, user_id, request_body.action_id);
 
     /* TODO
     auto head_id =
@@ -197,6 +213,8 @@ class AbscenceSplitHandler final
     } */
 
     trx.Commit();
+    calendar_.RefreshEmployee(company_id, user_id);
+    read_router_.MarkWrite(request, ctx);
 
     AbscenceSplitResponse response{first_action_id, second_action_id};
     return response.ToJSON();
@@ -204,6 +222,8 @@ class AbscenceSplitHandler final
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  core::attendance_calendar::AttendanceCalendar& calendar_;
+  core::read_routing::ReadRouter& read_router_;
 };
 
 }  // namespace
@@ -2,22 +2,28 @@
 
 #include "view.hpp"
 
-#include <queue>
+#include <nlohmann/json.hpp>
 
 #include <userver/clients/dns/component.hpp>
 #include <userver/clients/http/component.hpp>
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
-#include <userver/engine/task/task.hpp>
-#include <userver/engine/task/task_with_result.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
-#include <userver/utils/async.hpp>
+#include <userver/utils/datetime.hpp>
 #include <userver/utils/uuid4.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
+#include "core/attendance_calendar/component.hpp"
+#include "core/docx_template/component.hpp"
+#include "core/docx_template/converter.hpp"
+#include "core/docx_template/vacation_macros.hpp"
+#include "core/job_queue/component.hpp"
+#include "core/org_tree/component.hpp"
+#include "core/read_routing/component.hpp"
+#include "core/tenant_query/query.hpp"
 #include "definitions/all.hpp"
 
 using json = nlohmann::json;
@@ -26,6 +32,61 @@ namespace views::v1::abscence::verdict {
 
 namespace {
 
+const core::tenant_query::TenantQuery kSelectAction{
+    "verdict_action_select",
+    "SELECT user_id, type, start_date, end_date "
+    "FROM {schema}.actions "
+    "WHERE id = $1"};
+
+const core::tenant_query::TenantQuery kSelectApprovedAction{
+    "verdict_approved_action_select",
+    "SELECT user_id, type, start_date, end_date "
+    "FROM {schema}.actions "
+    "WHERE id = $1 AND status = 'approved'"};
+
+const core::tenant_query::TenantQuery kSelectEmployee{
+    "verdict_employee_select",
+    "SELECT name, surname, subcompany, patronymic, position "
+    "FROM {schema}.employees "
+    "WHERE id = $1 "};
+
+const core::tenant_query::TenantQuery kInsertDocument{
+    "verdict_document_insert",
+    "INSERT INTO {schema}.documents(id, name, sign_required, type) "
+    "VALUES($1, $2, $3, $4) "
+    "ON CONFLICT (id) DO NOTHING"};
+
+const core::tenant_query::TenantQuery kInsertEmployeeDocuments{
+    "verdict_employee_document_insert",
+    "INSERT INTO {schema}.employee_document "
+    "(employee_id, document_id, signed) "
+    "VALUES ($1, $2, $3), ($4, $2, $3) "
+    "ON CONFLICT DO NOTHING"};
+
+const core::tenant_query::TenantQuery kApproveAction{
+    "verdict_action_approve",
+    "UPDATE {schema}.actions "
+    "SET status = $2 "
+    "WHERE id = $1 "};
+
+const core::tenant_query::TenantQuery kDeleteAction{
+    "verdict_action_delete",
+    "DELETE FROM {schema}.actions "
+    "WHERE id = $1 "};
+
+const core::tenant_query::TenantQuery kDeleteNotification{
+    "verdict_notification_delete",
+    "DELETE FROM {schema}.notifications "
+    "WHERE id = $1 "};
+
+const core::tenant_query::TenantQuery kInsertNotification{
+    "verdict_notification_insert",
+    "INSERT INTO {schema}.notifications(id, type, text, user_id, "
+    "sender_id, action_id) "
+    "VALUES($1, $2, $3, $4, $5, $6) "
+    "ON CONFLICT (id) "
+    "DO NOTHING"};
+
 std::optional<std::string> ActionTypeToName(const std::string& type) {
   if (type == "vacation") {
     return "отпуск";
@@ -48,91 +109,119 @@ struct ActionInfo {
 
 struct EmployeeInfo {
   std::string name, surname, subcompany;
-  std::optional<std::string> patronymic, head_id, position;
-};
-
-struct HeadInfo {
-  std::string name, surname;
   std::optional<std::string> patronymic, position;
 };
 
-struct VacationDocumentRequest {
-  std::string action_id, user_id, company_id;
+const std::string kRetryAfterHeader = "Retry-After";
+constexpr std::chrono::milliseconds kConverterBusyDelay{5000};
+constexpr std::string_view kDocumentType = "create";
+
+struct VacationInputs {
+  ActionInfo action_info;
+  EmployeeInfo employee_info;
 };
 
-void GenerateVacationDocument(
-    VacationDocumentRequest&& request,
-    userver::storages::postgres::ClusterPtr pg_cluster,
-    userver::clients::http::Client& http_client,
-    const std::string& pyservice_url) {
-  auto action_id = request.action_id;
-  auto request_type = "create";
-  auto user_id = request.user_id;
-  const auto& company_id = request.company_id;
-
-  auto trx =
-      pg_cluster->Begin("documents_vacation",
-                        userver::storages::postgres::ClusterHostType::kMaster,
-                        {});  // TODO: change to slave read tx
-
-  auto action_info =
-      trx.Execute(
-             "SELECT user_id, type, start_date, end_date "
-             "FROM working_day_" +
-                 company_id +
-                 ".actions "
-                 "WHERE id = $1",
-             action_id)
-          .AsSingleRow<ActionInfo>(userver::storages::postgres::kRowTag);
+std::optional<VacationInputs> ReadVacationInputs(
+    const userver::storages::postgres::ClusterPtr& pg_cluster,
+    userver::storages::postgres::ClusterHostType host,
+    const std::string& company_id, const std::string& action_id) {
+  auto trx = pg_cluster->Begin(
+      "documents_vacation", host,
+      userver::storages::postgres::TransactionOptions{
+          userver::storages::postgres::TransactionOptions::kReadOnly});
+
+  auto action_result =
+      trx.Execute(kSelectApprovedAction.For(company_id), action_id);
+  if (action_result.IsEmpty()) {
+    return std::nullopt;
+  }
+  auto action_info = action_result.AsSingleRow<ActionInfo>(
+      userver::storages::postgres::kRowTag);
 
   auto employee_info =
-      trx.Execute(
-             "SELECT name, surname, subcompany, patronymic, head_id, position "
-             "FROM working_day_" +
-                 company_id +
-                 ".employees "
-                 "WHERE id = $1 ",
-             action_info.employee_id)
+      trx.Execute(kSelectEmployee.For(company_id), action_info.employee_id)
           .AsSingleRow<EmployeeInfo>(userver::storages::postgres::kRowTag);
 
-  auto head_info =
-      trx.Execute(
-             "SELECT name, surname, patronymic, position "
-             "FROM working_day_" +
-                 company_id +
-                 ".employees "
-                 "WHERE id = $1 ",
-             employee_info.head_id.value_or(action_info.employee_id))
-          .AsSingleRow<HeadInfo>(userver::storages::postgres::kRowTag);
-
   trx.Commit();
+  return VacationInputs{std::move(action_info), std::move(employee_info)};
+}
 
-  PyserviceDocumentGenerateRequest link_request;
-  link_request.action_type = action_info.type;
-  link_request.request_type = request_type;
-  link_request.employee_id = action_info.employee_id;
-  link_request.employee_name = employee_info.name;
-  link_request.employee_surname = employee_info.surname;
-  link_request.subcompany = employee_info.subcompany;
-  link_request.company_id = company_id;
-  link_request.head_name = head_info.name;
-  link_request.head_surname = head_info.surname;
-  link_request.start_date = userver::utils::datetime::Timestring(
-      action_info.start_date, "UTC", "%d.%m.%Y");
-  link_request.end_date = userver::utils::datetime::Timestring(
-      action_info.end_date, "UTC", "%d.%m.%Y"),
-  link_request.employee_patronymic = employee_info.patronymic;
-  link_request.head_patronymic = head_info.patronymic;
-  link_request.employee_position = employee_info.position;
-  link_request.head_position = head_info.position;
-
-  auto file_key = userver::utils::generators::GenerateUuid();
-  auto response = http_client.CreateRequest()
-                      .post(pyservice_url + "?file_key=" + file_key)
-                      .data(link_request.ToJsonString())
-                      .retry(2)  // retry once in case of error
-                      .timeout(std::chrono::milliseconds{10000})
-                      .perform();  // start performing the request
+// The file is named after the job, so a retried job overwrites the file of
+// the failed run and adds its document only once. The job has no request to
+// route its reads by, so they go to a replica and to the master only while
+// the replica has not seen the approval yet.
+void GenerateVacationDocument(
+    const core::job_queue::Job& job,
+    userver::storages::postgres::ClusterPtr pg_cluster,
+    userver::clients::http::Client& http_client,
+    const core::docx_template::TemplateStore& templates,
+    core::org_tree::OrgTreeCache& org_tree, const std::string& pyservice_url) {
+  const auto& action_id = job.subject_id;
+  const auto& company_id = job.company_id;
+
+  auto inputs = ReadVacationInputs(
+      pg_cluster, userver::storages::postgres::ClusterHostType::kSlave,
+      company_id, action_id);
+  if (!inputs.has_value()) {
+    inputs = ReadVacationInputs(
+        pg_cluster, userver::storages::postgres::ClusterHostType::kMaster,
+        company_id, action_id);
+  }
+  if (!inputs.has_value()) {
+    throw std::runtime_error("Action " + action_id +
+                             " is not approved in company " + company_id);
+  }
+  auto& [action_info, employee_info] = *inputs;
+
+  auto head_id = org_tree.GetHead(company_id, action_info.employee_id)
+                     .value_or(action_info.employee_id);
+  auto head_info = org_tree.FindEmployee(company_id, head_id);
+  if (!head_info.has_value()) {
+    throw std::runtime_error("Head " + head_id + " not found in company " +
+                             company_id);
+  }
+
+  const auto* docx_template =
+      templates.Find(company_id, employee_info.subcompany, kDocumentType);
+  if (docx_template == nullptr) {
+    throw std::runtime_error("No document template for company " +
+                             company_id);
+  }
+
+  core::docx_template::VacationDocument document;
+  document.employee_name = employee_info.name;
+  document.employee_surname = employee_info.surname;
+  document.employee_patronymic = employee_info.patronymic;
+  document.employee_position = employee_info.position;
+  document.head_name = head_info->name;
+  document.head_surname = head_info->surname;
+  document.head_patronymic = head_info->patronymic;
+  document.head_position = head_info->position;
+  document.start_date = action_info.start_date;
+  document.end_date = action_info.end_date;
+  auto docx = docx_template->Render(core::docx_template::VacationMacros(
+      document, userver::utils::datetime::Now()));
+
+  auto file_key = job.id;
+  auto response = core::docx_template::RequestPdf(
+      http_client, pyservice_url, file_key,
+      {action_info.employee_id,
+       core::docx_template::Initials(employee_info.surname, employee_info.name,
+                                     employee_info.patronymic),
+       employee_info.subcompany},
+      std::move(docx), std::chrono::milliseconds{10000});
+  // The converter queue is full, the job waits instead of failing so that
+  // the documents are spread over the time the converters are free
+  if (static_cast<int>(response->status_code()) ==
+      core::docx_template::kConverterBusyStatus) {
+    const auto& headers = response->headers();
+    const auto retry_after = headers.find(kRetryAfterHeader);
+    throw core::job_queue::RetryLater(
+        "Document converter is busy",
+        core::job_queue::ParseRetryAfter(
+            retry_after != headers.end() ? retry_after->second : "",
+            kConverterBusyDelay));
+  }
   response->raise_for_status();
 
   auto action_name = ActionTypeToName(action_info.type);
@@ -147,20 +236,12 @@ void GenerateVacationDocument(
   file_key += ".pdf";
 
   pg_cluster->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                      "INSERT INTO working_day_" + company_id +
-                          ".documents(id, name, "
-                          "sign_required, type) "
-                          "VALUES($1, $2, $3, $4)",
-                      file_key, document_name, true, "employee_request");
+                      kInsertDocument.For(company_id), file_key, document_name,
+                      true, "employee_request");
 
   pg_cluster->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                      "INSERT INTO working_day_" + company_id +
-                          ".employee_document "
-                          "(employee_id, document_id, signed) "
-                          "VALUES ($1, $2, $3), ($4, $2, $3) "
-                          "ON CONFLICT DO NOTHING",
-                      action_info.employee_id, file_key, true,
-                      employee_info.head_id.value_or(action_info.employee_id));
+                      kInsertEmployeeDocuments.For(company_id),
+                      action_info.employee_id, file_key, true, head_id);
 }
 
 class AbscenceVerdictHandler final
@@ -179,7 +260,25 @@ class AbscenceVerdictHandler final
         http_client_(
             component_context.FindComponent<userver::components::HttpClient>()
                 .GetHttpClient()),
-        pyservice_url(config["pyservice-url"].As<std::string>()) {}
+        pyservice_url(config["pyservice-url"].As<std::string>()),
+        calendar_(component_context.FindComponent<
+                  core::attendance_calendar::AttendanceCalendar>()),
+        read_router_(
+            component_context
+                .FindComponent<core::read_routing::ReadRouter>()),
+        job_queue_(
+            component_context.FindComponent<core::job_queue::JobQueue>()),
+        templates_(component_context
+                       .FindComponent<core::docx_template::TemplateStore>()),
+        org_tree_(
+            component_context.FindComponent<core::org_tree::OrgTreeCache>()) {
+    job_queue_.RegisterHandler(
+        std::string(kVacationDocumentJob),
+        [this](const core::job_queue::Job& job) {
+          GenerateVacationDocument(job, pg_cluster_, http_client_,
+                                   templates_, org_tree_, pyservice_url);
+        });
+  }
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -200,13 +299,7 @@ class AbscenceVerdictHandler final
         userver::storages::postgres::ClusterHostType::kMaster, {});
 
     auto action_info =
-        trx.Execute(
-               "SELECT user_id, type, start_date, end_date "
-               "FROM working_day_" +
-                   company_id +
-                   ".actions "
-                   "WHERE id = $1",
-               request_body.action_id)
+        trx.Execute(kSelectAction.For(company_id), request_body.action_id)
             .AsSingleRow<ActionInfo>(userver::storages::postgres::kRowTag);
 
     auto action_name = ActionTypeToName(action_info.type);
@@ -226,57 +319,35 @@ class AbscenceVerdictHandler final
     }
 
     if (request_body.approve) {
-      auto result = trx.Execute("UPDATE working_day_" + company_id +
-                                    ".actions "
-                                    "SET status = $2 "
-                                    "WHERE id = $1 ",
+      auto result = trx.Execute(kApproveAction.For(company_id),
                                 request_body.action_id, action_status);
     } else {
-      auto result = trx.Execute("DELETE FROM working_day_" + company_id +
-                                    ".actions "
-                                    "WHERE id = $1 ",
-                                request_body.action_id);
+      auto result =
+          trx.Execute(kDeleteAction.For(company_id), request_body.action_id);
     }
 
     if (request_body.notification_id.has_value()) {
-      auto result = trx.Execute("DELETE FROM working_day_" + company_id +
-                                    ".notifications "
-                                    "WHERE id = $1 ",
+      auto result = trx.Execute(kDeleteNotification.For(company_id),
                                 request_body.notification_id.value());
     }
 
     auto notification_id = userver::utils::generators::GenerateUuid();
-    auto result =
-        trx.Execute("INSERT INTO working_day_" + company_id +
-                        ".notifications(id, type, text, user_id, "
-                        "sender_id, action_id) "
-                        "VALUES($1, $2, $3, $4, $5, $6) "
-                        "ON CONFLICT (id) "
-                        "DO NOTHING",
-                    notification_id, action_info.type + "_" + action_status,
-                    notification_text, action_info.employee_id, user_id,
-                    request_body.action_id);
+    auto result = trx.Execute(
+        kInsertNotification.For(company_id), notification_id,
+        action_info.type + "_" + action_status, notification_text,
+        action_info.employee_id, user_id, request_body.action_id);
+
+    if (request_body.approve) {
+      job_queue_.Enqueue(trx, kVacationDocumentJob, company_id,
+                         request_body.action_id);
+    }
 
     trx.Commit();
+    calendar_.RefreshEmployee(company_id, action_info.employee_id);
+    read_router_.MarkWrite(request, ctx);
 
     if (request_body.approve) {
-      auto tasks = tasks_.Lock();
-      while (!tasks->empty() && tasks->front().IsFinished()) {
-        tasks->pop();
-      }
-
-      VacationDocumentRequest request{.action_id = request_body.action_id,
-                                      .user_id = user_id,
-                                      .company_id = company_id};
-
-      tasks->push(userver::utils::AsyncBackground(
-          "GenerateVacationDocument",
-          userver::engine::current_task::GetTaskProcessor(),
-          [req = std::move(request), this]() mutable -> int {
-            GenerateVacationDocument(std::move(req), this->pg_cluster_,
-                                     this->http_client_, this->pyservice_url);
-            return 42;
-          }));
+      job_queue_.Notify();
     }
 
     return "";
@@ -297,10 +368,12 @@ properties:
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
   userver::clients::http::Client& http_client_;
-  mutable userver::concurrent::Variable<
-      std::queue<userver::engine::TaskWithResult<int>>>
-      tasks_;
   std::string pyservice_url;
+  core::attendance_calendar::AttendanceCalendar& calendar_;
+  core::read_routing::ReadRouter& read_router_;
+  core::job_queue::JobQueue& job_queue_;
+  const core::docx_template::TemplateStore& templates_;
+  core::org_tree::OrgTreeCache& org_tree_;
 };
 
 }  // namespace
@@ -7,6 +7,10 @@
 
 namespace views::v1::abscence::verdict {
 
+// Kind of the queued job that generates the document of an approved
+// abscence, the job subject is the action id
+inline constexpr std::string_view kVacationDocumentJob = "vacation_document";
+
 void AppendAbscenceVerdict(userver::components::ComponentList& component_list);
 
 }  // namespace views::v1::abscence::verdict
@@ -13,6 +13,7 @@
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
 
+#include "core/tenant_query/query.hpp"
 #include <definitions/all.hpp>
 #include "utils/s3_presigned_links.hpp"
 
@@ -22,6 +23,13 @@ namespace views::v1::actions {
 
 namespace {
 
+const core::tenant_query::TenantQuery kSelectActions{
+    "actions_select",
+    "SELECT id, type, start_date, end_date, status, blocking_actions_ids "
+    "FROM {schema}.actions "
+    "WHERE (user_id = $1 AND start_date >= $2 AND start_date <= $3) "
+    "OR (user_id = $1 AND end_date >= $2 AND end_date <= $3)"};
+
 class ActionsHandler final : public userver::server::handlers::HttpHandlerBase {
  public:
   static constexpr std::string_view kName = "handler-v1-actions";
@@ -49,13 +57,8 @@ class ActionsHandler final : public userver::server::handlers::HttpHandlerBase {
     request_body.ParseRegisteredFields(request.RequestBody());
 
     auto result = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kSlave,
-        "SELECT id, type, start_date, end_date, status, blocking_actions_ids "
-        "FROM working_day_" +
-            company_id +
-            ".actions "
-            "WHERE (user_id = $1 AND start_date >= $2 AND start_date <= $3) "
-            "OR (user_id = $1 AND end_date >= $2 AND end_date <= $3)",
+        ctx.GetData<userver::storages::postgres::ClusterHostType>("read_host"),
+        kSelectActions.For(company_id),
         request_body.employee_id.value_or(user_id), request_body.from,
         request_body.to);
 
@@ -13,12 +13,37 @@
 #include <userver/storages/postgres/component.hpp>
 #include <userver/utils/uuid4.hpp>
 
+#include "core/attendance_calendar/component.hpp"
+#include "core/read_routing/component.hpp"
+#include "core/tenant_query/query.hpp"
+
 using json = nlohmann::json;
 
 namespace views::v1::attendance::add {
 
 namespace {
 
+const core::tenant_query::TenantQuery kDeleteAttendance{
+    "attendance_delete",
+    "DELETE FROM {schema}.actions "
+    "WHERE user_id = $1 AND type = $2 AND DATE(start_date) = DATE($3)"};
+
+const core::tenant_query::TenantQuery kInsertAttendance{
+    "attendance_insert",
+    "INSERT INTO {schema}.actions(id, type, user_id, start_date, "
+    "end_date) "
+    "VALUES($1, $2, $3, $4, $5) "
+    "ON CONFLICT (id) "
+    "DO NOTHING"};
+
+const core::tenant_query::TenantQuery kInsertNotification{
+    "attendance_notification_insert",
+    "INSERT INTO {schema}.notifications(id, type, text, user_id, "
+    "sender_id) "
+    "VALUES($1, $2, $3, $4, $5) "
+    "ON CONFLICT (id) "
+    "DO NOTHING"};
+
 class AttendanceAddRequest {
  public:
   AttendanceAddRequest(const std::string& body) {
@@ -55,7 +80,12 @@ class AttendanceAddHandler final
         pg_cluster_(
             component_context
                 .FindComponent<userver::components::Postgres>("key-value")
-                .GetCluster()) {}
+                .GetCluster()),
+        calendar_(component_context.FindComponent<
+                  core::attendance_calendar::AttendanceCalendar>()),
+        read_router_(
+            component_context
+                .FindComponent<core::read_routing::ReadRouter>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -78,39 +108,31 @@ class AttendanceAddHandler final
         {});
 
     auto result =
-        trx.Execute("DELETE FROM working_day_" + company_id +
-                        ".actions "
-                        "WHERE user_id = $1 AND type = $2 AND DATE(start_date) "
-                        "= DATE($3)",
-                    employee_id, "attendance", request_body.start_date);
+        trx.Execute(kDeleteAttendance.For(company_id), employee_id,
+                    "attendance", request_body.start_date);
 
     auto action_id = userver::utils::generators::GenerateUuid();
-    result = trx.Execute("INSERT INTO working_day_" + company_id +
-                             ".actions(id, type, user_id, start_date, "
-                             "end_date) "
-                             "VALUES($1, $2, $3, $4, $5) "
-                             "ON CONFLICT (id) "
-                             "DO NOTHING",
-                         action_id, "attendance", employee_id,
-                         request_body.start_date, request_body.end_date);
+    result = trx.Execute(kInsertAttendance.For(company_id), action_id,
+                         "attendance", employee_id, request_body.start_date,
+                         request_body.end_date);
 
     auto notification_id = userver::utils::generators::GenerateUuid();
-    result = trx.Execute("INSERT INTO working_day_" + company_id +
-                             ".notifications(id, type, text, user_id, "
-                             "sender_id) "
-                             "VALUES($1, $2, $3, $4, $5) "
-                             "ON CONFLICT (id) "
-                             "DO NOTHING",
-                         notification_id, "attendance_added", notification_text,
-                         employee_id, user_id);
+    result = trx.Execute(kInsertNotification.For(company_id), notification_id,
+                         "attendance_added", notification_text, employee_id,
+                         user_id);
 
     trx.Commit();
 
+    calendar_.RefreshEmployee(company_id, employee_id);
+    read_router_.MarkWrite(request, ctx);
+
     return "";
   }
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  core::attendance_calendar::AttendanceCalendar& calendar_;
+  core::read_routing::ReadRouter& read_router_;
 };
 
 }  // namespace
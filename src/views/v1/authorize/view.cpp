@@ -13,6 +13,9 @@
 #include <userver/storages/postgres/component.hpp>
 #include <userver/utils/uuid4.hpp>
 
+#include "auth/token_signer.hpp"
+#include "auth/token_store.hpp"
+#include "core/tenant_query/query.hpp"
 #include "definitions/all.hpp"
 
 using json = nlohmann::json;
@@ -38,7 +41,9 @@ class AuthorizeHandler final
         pg_cluster_(
             component_context
                 .FindComponent<userver::components::Postgres>("key-value")
-                .GetCluster()) {}
+                .GetCluster()),
+        token_store_(component_context.FindComponent<auth::TokenStore>()),
+        token_signer_(component_context.FindComponent<auth::TokenSigner>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -52,10 +57,12 @@ class AuthorizeHandler final
     AuthorizeRequest request_body;
     request_body.ParseRegisteredFields(request.RequestBody());
 
+    // The company comes from an unauthenticated request, so its statement is
+    // not kept in a TenantQuery
     auto result = pg_cluster_->Execute(
         userver::storages::postgres::ClusterHostType::kSlave,
-        "SELECT id, password, role FROM working_day_" +
-            request_body.company_id +
+        "SELECT id, password, role FROM " +
+            core::tenant_query::Schema(request_body.company_id) +
             ".employees "
             "WHERE id = $1",
         request_body.login);
@@ -79,6 +86,13 @@ class AuthorizeHandler final
       scopes.push_back(user_info.role);
     }
 
+    auth::UserDbInfo token_info{{}, user_info.id, auth::ToScopeMask(scopes),
+                                request_body.company_id};
+    if (auto signed_token = token_signer_.Issue(token_info)) {
+      AuthorizeResponse response(*signed_token, user_info.role);
+      return response.ToJsonString();
+    }
+
     auto token = userver::utils::generators::GenerateUuid();
     auto auth_result = pg_cluster_->Execute(
         userver::storages::postgres::ClusterHostType::kMaster,
@@ -86,6 +100,8 @@ class AuthorizeHandler final
         "scopes) "
         "VALUES ($1, $2, $3, $4)",
         token, user_info.id, request_body.company_id, scopes);
+    token_info.token = userver::server::auth::UserAuthInfo::Ticket{token};
+    token_store_.Add(std::move(token_info));
 
     AuthorizeResponse response(token, user_info.role);
 
@@ -94,6 +110,8 @@ class AuthorizeHandler final
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  auth::TokenStore& token_store_;
+  const auth::TokenSigner& token_signer_;
 };
 
 }  // namespace
@@ -9,7 +9,7 @@
 #include <userver/storages/postgres/component.hpp>
 #include "userver/utils/async.hpp"
 
-#include "core/reverse_index/view.hpp"
+#include "core/reverse_index/pipeline.hpp"
 
 namespace views::v1::clear_tasks {
 
@@ -27,18 +27,22 @@ class ClearTasksHandler final
         pg_cluster_(
             component_context
                 .FindComponent<userver::components::Postgres>("key-value")
-                .GetCluster()) {}
+                .GetCluster()),
+        reverse_index_(
+            component_context
+                .FindComponent<core::reverse_index::Pipeline>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
       userver::server::request::RequestContext&) const override {
-    core::reverse_index::ClearTasks();
+    reverse_index_.Flush();
 
     return "";
   }
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  core::reverse_index::Pipeline& reverse_index_;
 };
 
 }  // namespace
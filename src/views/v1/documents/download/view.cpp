@@ -23,7 +23,10 @@ class DocumentsDownloadHandler final
   DocumentsDownloadHandler(
       const userver::components::ComponentConfig& config,
       const userver::components::ComponentContext& component_context)
-      : HttpHandlerBase(config, component_context) {}
+      : HttpHandlerBase(config, component_context),
+        presigner_(
+            component_context
+                .FindComponent<utils::s3_presigned_links::Presigner>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -38,14 +41,16 @@ class DocumentsDownloadHandler final
     // const auto& user_id = ctx.GetData<std::string>("user_id");
     const auto& document_id = request.GetArg("id");
 
-    auto download_link =
-        utils::s3_presigned_links::GenerateDocumentPresignedLink(
-            document_id, utils::s3_presigned_links::Download);
+    auto download_link = presigner_.GenerateDocumentPresignedLink(
+        document_id, utils::s3_presigned_links::Download);
 
     DownloadDocumentResponse response;
     response.url = download_link;
     return response.ToJsonString();
   }
+
+ private:
+  const utils::s3_presigned_links::Presigner& presigner_;
 };
 
 }  // namespace
@@ -12,12 +12,22 @@
 #include <userver/utils/boost_uuid4.hpp>
 #include <userver/utils/uuid4.hpp>
 
+#include "core/tenant_query/query.hpp"
 #include <definitions/all.hpp>
 
 namespace views::v1::documents::get_signs {
 
 namespace {
 
+const core::tenant_query::TenantQuery kSelectSigns{
+    "get_signs_select",
+    "SELECT ROW (e.id, e.name, e.surname, e.patronymic, e.photo_link), "
+    "ed.signed "
+    "FROM {schema}.employees e "
+    "JOIN {schema}.employee_document ed ON e.id = ed.employee_id "
+    "JOIN {schema}.documents d ON ed.document_id = d.id "
+    "WHERE d.parent_id = $1"};
+
 class DocumentsGetSignsHandler final
     : public userver::server::handlers::HttpHandlerBase {
  public:
@@ -46,22 +56,8 @@ class DocumentsGetSignsHandler final
     const auto& document_id = request.GetArg("document_id");
 
     auto result = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kMaster,
-        "SELECT ROW "
-        "(e.id, e.name, e.surname, e.patronymic, "
-        "e.photo_link), ed.signed "
-        "FROM working_day_" +
-            company_id +
-            ".employees e "
-            "JOIN working_day_" +
-            company_id +
-            ".employee_document ed ON e.id = "
-            "ed.employee_id "
-            "JOIN working_day_" +
-            company_id +
-            ".documents d ON ed.document_id = d.id "
-            "WHERE d.parent_id = $1",
-        document_id);
+        ctx.GetData<userver::storages::postgres::ClusterHostType>("read_host"),
+        kSelectSigns.For(company_id), document_id);
 
     DocumentsGetSignsResponse response;
     response.signs = result.AsContainer<std::vector<SignItem>>(
@@ -12,12 +12,24 @@
 #include <userver/utils/boost_uuid4.hpp>
 #include <userver/utils/uuid4.hpp>
 
+#include "core/tenant_query/query.hpp"
 #include <definitions/all.hpp>
 
 namespace views::v1::documents::list {
 
 namespace {
 
+const core::tenant_query::TenantQuery kSelectDocuments{
+    "documents_list_select",
+    "SELECT documents.id, documents.name, documents.type, "
+    "documents.sign_required, documents.description, "
+    "employee_document.signed, NULL::TEXT as parent_id "
+    "FROM {schema}.documents "
+    "JOIN {schema}.employee_document "
+    "ON documents.id = employee_document.document_id "
+    "WHERE employee_document.employee_id = $1 "
+    "ORDER BY documents.created_ts DESC"};
+
 class DocumentsListHandler final
     : public userver::server::handlers::HttpHandlerBase {
  public:
@@ -45,41 +57,16 @@ class DocumentsListHandler final
     const auto& company_id = ctx.GetData<std::string>("company_id");
 
     auto result = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kMaster,
-        "SELECT working_day_" + company_id + ".documents.id, working_day_" +
-            company_id +
-            ".documents.name, "
-            "working_day_" +
-            company_id + ".documents.type, working_day_" + company_id +
-            ".documents.sign_required, "
-            "working_day_" +
-            company_id +
-            ".documents.description, "
-            "working_day_" +
-            company_id +
-            ".employee_document.signed, "
-            "NULL::TEXT as parent_id "
-            "FROM working_day_" +
-            company_id +
-            ".documents "
-            "JOIN working_day_" +
-            company_id + ".employee_document ON working_day_" + company_id +
-            ".documents.id = "
-            "working_day_" +
-            company_id +
-            ".employee_document.document_id "
-            "WHERE working_day_" +
-            company_id +
-            ".employee_document.employee_id = $1 "
-            "ORDER BY working_day_" +
-            company_id + ".documents.created_ts DESC",
-        user_id);
-
-    DocumentsListResponse response;
-    response.documents = result.AsContainer<std::vector<DocumentItem>>(
-        userver::storages::postgres::kRowTag);
-
-    return response.ToJsonString();
+        ctx.GetData<userver::storages::postgres::ClusterHostType>("read_host"),
+        kSelectDocuments.For(company_id), user_id);
+
+    JsonListWriter response("documents");
+    for (const auto& document : result.AsSetOf<DocumentItem>(
+             userver::storages::postgres::kRowTag)) {
+      response.Append(document);
+    }
+
+    return std::move(response).Finish();
   }
 
  private:
@@ -12,12 +12,21 @@
 #include <userver/utils/boost_uuid4.hpp>
 #include <userver/utils/uuid4.hpp>
 
+#include "core/tenant_query/query.hpp"
 #include <definitions/all.hpp>
 
 namespace views::v1::documents::list_all {
 
 namespace {
 
+const core::tenant_query::TenantQuery kSelectDocuments{
+    "documents_list_all_select",
+    "SELECT id, name, "
+    "type, sign_required, "
+    "description, NULL::BOOLEAN as signed, NULL::TEXT as parent_id "
+    "FROM {schema}.documents "
+    "WHERE parent_id = id"};
+
 class DocumentsListAllHandler final
     : public userver::server::handlers::HttpHandlerBase {
  public:
@@ -45,14 +54,8 @@ class DocumentsListAllHandler final
     const auto& company_id = ctx.GetData<std::string>("company_id");
 
     auto result = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kMaster,
-        "SELECT id, name, "
-        "type, sign_required, "
-        "description, NULL::BOOLEAN as signed, NULL::TEXT as parent_id "
-        "FROM working_day_" +
-            company_id +
-            ".documents "
-            "WHERE parent_id = id");
+        ctx.GetData<userver::storages::postgres::ClusterHostType>("read_host"),
+        kSelectDocuments.For(company_id));
 
     DocumentsListAllResponse response;
     response.documents = result.AsContainer<std::vector<DocumentItem>>(
@@ -9,15 +9,64 @@
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
-#include <userver/utils/boost_uuid4.hpp>
 #include <userver/utils/uuid4.hpp>
 
+#include "core/read_routing/component.hpp"
+#include "core/tenant_query/query.hpp"
 #include <definitions/all.hpp>
 
 namespace views::v1::documents::send {
 
 namespace {
 
+const core::tenant_query::TenantQuery kInsertDocument{
+    "send_document_insert",
+    "INSERT INTO {schema}.documents(id, name, "
+    "sign_required, description, parent_id) "
+    "VALUES($1, $2, $3, $4, $5)"};
+
+// Recipients are resolved from the selectors in the database and both
+// tables are filled by set-based inserts, so the statement does not grow
+// with the number of recipients. Every recipient gets the document, only
+// the ones selected by id alone get a personal notification, the groups
+// are told by a broadcast.
+const core::tenant_query::TenantQuery kInsertRecipients{
+    "send_recipients_insert",
+    "WITH grouped AS ("
+    "SELECT id FROM {schema}.employees "
+    "WHERE $5 OR subcompany = ANY($4) "
+    "UNION "
+    "SELECT employee_id FROM {schema}.employee_team "
+    "WHERE team_id = ANY($3)"
+    "), recipients AS ("
+    "SELECT id FROM grouped "
+    "UNION "
+    "SELECT id FROM {schema}.employees WHERE id = ANY($2)"
+    "), sent AS ("
+    "INSERT INTO {schema}.employee_document (employee_id, document_id) "
+    "SELECT id, $1 FROM recipients "
+    "ON CONFLICT DO NOTHING "
+    "RETURNING employee_id"
+    ") "
+    "INSERT INTO {schema}.notifications(id, type, text, sender_id, user_id) "
+    "SELECT $6::TEXT || '_' || employee_id, 'generic', $7, $8, employee_id "
+    "FROM sent "
+    "WHERE employee_id NOT IN (SELECT id FROM grouped) "
+    "ON CONFLICT (id) DO NOTHING"};
+
+// One broadcast for all the selected groups, so an employee in several of
+// them is told once. whole_company replaces the other groups.
+const core::tenant_query::TenantQuery kInsertBroadcast{
+    "send_broadcast_insert",
+    "INSERT INTO {schema}.broadcasts"
+    "(id, type, text, sender_id, audience, team_ids, subcompanies) "
+    "SELECT $1, 'generic', $2, $3, "
+    "CASE WHEN $4 THEN 'company' ELSE 'groups' END, "
+    "CASE WHEN $4 THEN ARRAY []::TEXT[] ELSE $5 END, "
+    "CASE WHEN $4 THEN ARRAY []::TEXT[] ELSE $6 END "
+    "WHERE $4 OR cardinality($5::TEXT[]) > 0 OR cardinality($6::TEXT[]) > 0 "
+    "ON CONFLICT (id) DO NOTHING"};
+
 class DocumentsSendHandler final
     : public userver::server::handlers::HttpHandlerBase {
  public:
@@ -30,7 +79,10 @@ class DocumentsSendHandler final
         pg_cluster_(
             component_context
                 .FindComponent<userver::components::Postgres>("key-value")
-                .GetCluster()) {}
+                .GetCluster()),
+        read_router_(
+            component_context
+                .FindComponent<core::read_routing::ReadRouter>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -46,66 +98,48 @@ class DocumentsSendHandler final
 
     DocumentSendRequest request_body;
     request_body.ParseRegisteredFields(request.RequestBody());
-
-    pg_cluster_->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                         "INSERT INTO working_day_" + company_id +
-                             ".documents(id, name, "
-                             "sign_required, description, parent_id) "
-                             "VALUES($1, $2, $3, $4, $5)",
-                         request_body.document.id, request_body.document.name,
-                         request_body.document.sign_required,
-                         request_body.document.description,
-                         request_body.document.parent_id.value_or(""));
+    if (!request_body.employee_ids.has_value() &&
+        !request_body.team_ids.has_value() &&
+        !request_body.subcompanies.has_value() &&
+        !request_body.whole_company) {
+      request.GetHttpResponse().SetStatus(
+          userver::server::http::HttpStatus::kBadRequest);
+      return ErrorMessage{"No recipients are selected"}.ToJsonString();
+    }
 
     auto notification_text = "Вам отправлен новый документ \"" +
                              request_body.document.name +
                              "\". Его можно просмотреть в разделе Документы.";
-    auto notification_id = userver::utils::generators::GenerateUuid();
-
-    userver::storages::postgres::ParameterStore parameters,
-        parameters_notifications;
-    std::string filter, filter_notifications;
-    parameters_notifications.PushBack(notification_id);
-    parameters_notifications.PushBack("generic");
-    parameters_notifications.PushBack(notification_text);
-    parameters_notifications.PushBack(user_id);
-    for (const auto& employee_id : request_body.employee_ids) {
-      filter += "($" + std::to_string(parameters.Size() + 1) + ", $" +
-                std::to_string(parameters.Size() + 2) + "),";
-      parameters.PushBack(employee_id);
-      parameters.PushBack(request_body.document.id);
-
-      filter_notifications +=
-          "($1, $2, $3, $4, $" +
-          std::to_string(parameters_notifications.Size() + 1) + "),";
-      parameters_notifications.PushBack(employee_id);
-    }
-    filter.pop_back();
-    filter_notifications.pop_back();
-
-    pg_cluster_->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                         "INSERT INTO working_day_" + company_id +
-                             ".employee_document "
-                             "(employee_id, document_id) "
-                             "VALUES " +
-                             filter,
-                         parameters);
-
-    pg_cluster_->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                         "INSERT INTO working_day_" + company_id +
-                             ".notifications(id, type, "
-                             "text, sender_id, user_id) "
-                             "VALUES " +
-                             filter_notifications +
-                             " ON CONFLICT (id) "
-                             "DO NOTHING",
-                         parameters_notifications);
+
+    auto trx = pg_cluster_->Begin(
+        "send_document", userver::storages::postgres::ClusterHostType::kMaster,
+        {});
+    trx.Execute(kInsertDocument.For(company_id), request_body.document.id,
+                request_body.document.name,
+                request_body.document.sign_required,
+                request_body.document.description,
+                request_body.document.parent_id.value_or(""));
+    const auto team_ids =
+        request_body.team_ids.value_or(std::vector<std::string>{});
+    const auto subcompanies =
+        request_body.subcompanies.value_or(std::vector<std::string>{});
+    const auto notification_id = userver::utils::generators::GenerateUuid();
+    trx.Execute(kInsertRecipients.For(company_id), request_body.document.id,
+                request_body.employee_ids.value_or(std::vector<std::string>{}),
+                team_ids, subcompanies, request_body.whole_company,
+                notification_id, notification_text, user_id);
+    trx.Execute(kInsertBroadcast.For(company_id), notification_id,
+                notification_text, user_id, request_body.whole_company,
+                team_ids, subcompanies);
+    trx.Commit();
+    read_router_.MarkWrite(request, ctx);
 
     return "";
   }
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  core::read_routing::ReadRouter& read_router_;
 };
 
 }  // namespace
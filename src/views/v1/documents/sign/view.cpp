@@ -10,16 +10,47 @@
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
-#include <userver/utils/boost_uuid4.hpp>
-#include <userver/utils/uuid4.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
+#include "core/job_queue/component.hpp"
+#include "core/read_routing/component.hpp"
+#include "core/tenant_query/query.hpp"
 #include <definitions/all.hpp>
 
 namespace views::v1::documents::sign {
 
 namespace {
 
+const core::tenant_query::TenantQuery kSelectDocument{
+    "sign_document_select",
+    "SELECT id, name, type, sign_required, description "
+    "FROM {schema}.documents "
+    "WHERE id = $1"};
+
+const core::tenant_query::TenantQuery kSelectEmployee{
+    "sign_employee_select",
+    "SELECT id, name, surname, patronymic, photo_link, subcompany "
+    "FROM {schema}.employees "
+    "WHERE id = $1"};
+
+const core::tenant_query::TenantQuery kDeleteEmployeeDocument{
+    "sign_employee_document_delete",
+    "DELETE FROM {schema}.employee_document "
+    "WHERE employee_id = $1 AND document_id = $2"};
+
+const core::tenant_query::TenantQuery kInsertDocument{
+    "sign_document_insert",
+    "INSERT INTO {schema}.documents(id, name, type, "
+    "sign_required, description, parent_id) "
+    "VALUES($1, $2, $3, $4, $5, $6) "
+    "ON CONFLICT (id) DO NOTHING"};
+
+const core::tenant_query::TenantQuery kInsertEmployeeDocument{
+    "sign_employee_document_insert",
+    "INSERT INTO {schema}.employee_document (employee_id, document_id, signed) "
+    "VALUES ($1, $2, $3) "
+    "ON CONFLICT DO NOTHING"};
+
 class DocumentInfo {
  public:
   std::string id, name, type;
@@ -27,6 +58,60 @@ class DocumentInfo {
   std::optional<std::string> description;
 };
 
+// The signed file is named after the job, so a retried job overwrites the
+// file of the failed run and replaces the employee's document only once
+void SignDocument(const core::job_queue::Job& job,
+                  userver::storages::postgres::ClusterPtr pg_cluster,
+                  userver::clients::http::Client& http_client,
+                  const std::string& pyservice_url) {
+  const auto& company_id = job.company_id;
+  const auto separator = job.subject_id.find('/');
+  const auto user_id = job.subject_id.substr(0, separator);
+  const auto document_id = job.subject_id.substr(separator + 1);
+
+  // The job may run right after the document was sent or the employee was
+  // edited, a lagging replica would miss them
+  auto document_info =
+      pg_cluster
+          ->Execute(userver::storages::postgres::ClusterHostType::kMaster,
+                    kSelectDocument.For(company_id), document_id)
+          .AsSingleRow<DocumentInfo>(userver::storages::postgres::kRowTag);
+
+  auto employee_info =
+      pg_cluster
+          ->Execute(userver::storages::postgres::ClusterHostType::kMaster,
+                    kSelectEmployee.For(company_id), user_id)
+          .AsSingleRow<ListEmployeeWithSubcompany>(
+              userver::storages::postgres::kRowTag);
+
+  PyserviceDocumentSignRequest py_request;
+  py_request.employee_id = user_id;
+  py_request.employee_name = employee_info.name;
+  py_request.employee_surname = employee_info.surname;
+  py_request.employee_patronymic = employee_info.patronymic;
+  py_request.subcompany = employee_info.subcompany;
+  py_request.file_key = document_id;
+  py_request.signed_file_key = job.id + ".pdf";
+
+  auto response = http_client.CreateRequest()
+                      .post(pyservice_url)
+                      .data(py_request.ToJsonString())
+                      .timeout(std::chrono::milliseconds{10000})
+                      .perform();
+  response->raise_for_status();
+
+  auto trx = pg_cluster->Begin(
+      "sign_document", userver::storages::postgres::ClusterHostType::kMaster,
+      {});
+  trx.Execute(kDeleteEmployeeDocument.For(company_id), user_id, document_id);
+  trx.Execute(kInsertDocument.For(company_id), py_request.signed_file_key,
+              document_info.name, document_info.type, true,
+              document_info.description, document_id);
+  trx.Execute(kInsertEmployeeDocument.For(company_id), user_id,
+              py_request.signed_file_key, true);
+  trx.Commit();
+}
+
 class DocumentsSignHandler final
     : public userver::server::handlers::HttpHandlerBase {
  public:
@@ -55,7 +140,18 @@ properties:
         http_client_(
             component_context.FindComponent<userver::components::HttpClient>()
                 .GetHttpClient()),
-        pyservice_url_(config["pyservice-url"].As<std::string>()) {}
+        pyservice_url_(config["pyservice-url"].As<std::string>()),
+        read_router_(
+            component_context
+                .FindComponent<core::read_routing::ReadRouter>()),
+        job_queue_(
+            component_context.FindComponent<core::job_queue::JobQueue>()) {
+    job_queue_.RegisterHandler(
+        std::string(kDocumentSignJob),
+        [this](const core::job_queue::Job& job) {
+          SignDocument(job, pg_cluster_, http_client_, pyservice_url_);
+        });
+  }
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -71,13 +167,13 @@ properties:
     const auto& document_id = request.GetArg("document_id");
 
     auto result = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kSlave,
-        "SELECT id, name, type, sign_required, description "
-        "FROM working_day_" +
-            company_id +
-            ".documents "
-            "WHERE id = $1",
-        document_id);
+        ctx.GetData<userver::storages::postgres::ClusterHostType>("read_host"),
+        kSelectDocument.For(company_id), document_id);
+    if (result.IsEmpty()) {
+      request.GetHttpResponse().SetStatus(
+          userver::server::http::HttpStatus::kNotFound);
+      return ErrorMessage{"Document not found"}.ToJsonString();
+    }
     auto document_info =
         result.AsSingleRow<DocumentInfo>(userver::storages::postgres::kRowTag);
 
@@ -87,78 +183,16 @@ properties:
       return ErrorMessage{"Document doesn't require sign"}.ToJsonString();
     }
 
-    result = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kSlave,
-        "SELECT id, name, surname, patronymic, photo_link, subcompany "
-        "FROM working_day_" +
-            company_id +
-            ".employees "
-            "WHERE id = $1",
-        user_id);
-
-    auto employee_info = result.AsSingleRow<ListEmployeeWithSubcompany>(
-        userver::storages::postgres::kRowTag);
-
-    PyserviceDocumentSignRequest py_request;
-    py_request.employee_id = user_id;
-    py_request.employee_name = employee_info.name;
-    py_request.employee_surname = employee_info.surname;
-    py_request.employee_patronymic = employee_info.patronymic;
-    py_request.subcompany = employee_info.subcompany;
-    py_request.file_key = document_id;
-    py_request.signed_file_key =
-        userver::utils::generators::GenerateUuid() + ".pdf";
-
-    auto response = http_client_.CreateRequest()
-                        .post(pyservice_url_)
-                        .data(py_request.ToJsonString())
-                        .retry(2)  // retry once in case of error
-                        .timeout(std::chrono::milliseconds{5000})
-                        .perform();  // start performing the request
-    response->raise_for_status();
-
-    result = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kMaster,
-        "DELETE FROM working_day_" + company_id +
-            ".employee_document "
-            "WHERE employee_id = $1 AND document_id = $2",
-        user_id, document_id);
-
-    result = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kMaster,
-        "INSERT INTO working_day_" + company_id +
-            ".documents(id, name, type, "
-            "sign_required, description, parent_id) "
-            "VALUES($1, $2, $3, $4, $5, $6)",
-        py_request.signed_file_key, document_info.name, document_info.type,
-        true, document_info.description, document_id);
-
-    LOG_INFO() << "NEW ID " << py_request.signed_file_key;
-
-    result = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kMaster,
-        "SELECT id, name, type, sign_required, description "
-        "FROM working_day_" +
-            company_id +
-            ".documents "
-            "WHERE id = $1",
-        py_request.signed_file_key);
-
-    auto inserted_docs =
-        result.AsSingleRow<DocumentInfo>(userver::storages::postgres::kRowTag);
-    LOG_INFO() << "ROWS AFFECTED " << inserted_docs.id << " "
-               << inserted_docs.name << " " << inserted_docs.type << " "
-               << inserted_docs.sign_required << " "
-               << inserted_docs.description.value_or("") << " " << document_id;
-
-    result = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kMaster,
-        "INSERT INTO working_day_" + company_id +
-            ".employee_document (employee_id, document_id, signed) "
-            "VALUES ($1, $2, $3)",
-        user_id, py_request.signed_file_key, true);
-
-    LOG_INFO() << "&ROWS AFFECTED " << result.RowsAffected();
+    // The document is stamped by a job, its progress is reported by
+    // /v1/documents/sign-status
+    auto trx = pg_cluster_->Begin(
+        "sign_document_enqueue",
+        userver::storages::postgres::ClusterHostType::kMaster, {});
+    job_queue_.Enqueue(trx, kDocumentSignJob, company_id,
+                       SignJobSubject(user_id, document_id));
+    trx.Commit();
+    read_router_.MarkWrite(request, ctx);
+    job_queue_.Notify();
 
     return "";
   }
@@ -167,6 +201,8 @@ properties:
   userver::storages::postgres::ClusterPtr pg_cluster_;
   userver::clients::http::Client& http_client_;
   std::string pyservice_url_;
+  core::read_routing::ReadRouter& read_router_;
+  core::job_queue::JobQueue& job_queue_;
 };
 
 }  // namespace
@@ -7,6 +7,14 @@
 
 namespace views::v1::documents::sign {
 
+// Job kind of a signature, the subject is "<employee_id>/<document_id>"
+inline constexpr std::string_view kDocumentSignJob = "document_sign";
+
+inline std::string SignJobSubject(std::string_view employee_id,
+                                  std::string_view document_id) {
+  return std::string(employee_id) + "/" + std::string(document_id);
+}
+
 void AppendDocumentsSign(userver::components::ComponentList& component_list);
 
 }  // namespace views::v1::documents::sign
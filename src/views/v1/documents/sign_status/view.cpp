@@ -0,0 +1,72 @@
+#define V1_DOCUMENTS_SIGN_STATUS
+
+#include "view.hpp"
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/server/handlers/http_handler_base.hpp>
+
+#include "core/job_queue/component.hpp"
+#include "definitions/all.hpp"
+#include "views/v1/documents/sign/view.hpp"
+
+namespace views::v1::documents::sign_status {
+
+namespace {
+
+class DocumentsSignStatusHandler final
+    : public userver::server::handlers::HttpHandlerBase {
+ public:
+  static constexpr std::string_view kName = "handler-v1-documents-sign-status";
+
+  DocumentsSignStatusHandler(
+      const userver::components::ComponentConfig& config,
+      const userver::components::ComponentContext& component_context)
+      : HttpHandlerBase(config, component_context),
+        job_queue_(
+            component_context.FindComponent<core::job_queue::JobQueue>()) {}
+
+  std::string HandleRequestThrow(
+      const userver::server::http::HttpRequest& request,
+      userver::server::request::RequestContext& ctx) const override {
+    // CORS
+    request.GetHttpResponse().SetHeader(
+        static_cast<std::string>("Access-Control-Allow-Origin"), "*");
+    request.GetHttpResponse().SetHeader(
+        static_cast<std::string>("Access-Control-Allow-Headers"), "*");
+
+    const auto& user_id = ctx.GetData<std::string>("user_id");
+    const auto& company_id = ctx.GetData<std::string>("company_id");
+    const auto& document_id = request.GetArg("document_id");
+
+    const auto job =
+        job_queue_.GetStatus(sign::kDocumentSignJob, company_id,
+                             sign::SignJobSubject(user_id, document_id));
+    if (!job.has_value()) {
+      request.GetHttpResponse().SetStatus(
+          userver::server::http::HttpStatus::kNotFound);
+      return ErrorMessage{"Document is not being signed"}.ToJsonString();
+    }
+
+    DocumentsSignStatusResponse response;
+    response.status = job->status;
+    response.attempts = job->attempts;
+    response.error = job->error;
+    if (job->status == "done") {
+      response.signed_document_id = job->id + ".pdf";
+    }
+    return response.ToJsonString();
+  }
+
+ private:
+  const core::job_queue::JobQueue& job_queue_;
+};
+
+}  // namespace
+
+void AppendDocumentsSignStatus(
+    userver::components::ComponentList& component_list) {
+  component_list.Append<DocumentsSignStatusHandler>();
+}
+
+}  // namespace views::v1::documents::sign_status
@@ -25,7 +25,10 @@ class DocumentsUploadHandler final
   DocumentsUploadHandler(
       const userver::components::ComponentConfig& config,
       const userver::components::ComponentContext& component_context)
-      : HttpHandlerBase(config, component_context) {}
+      : HttpHandlerBase(config, component_context),
+        presigner_(
+            component_context
+                .FindComponent<utils::s3_presigned_links::Presigner>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -43,7 +46,7 @@ class DocumentsUploadHandler final
 
     auto document_id =
         userver::utils::generators::GenerateUuid() + request_body.extension;
-    auto upload_link = utils::s3_presigned_links::GenerateDocumentPresignedLink(
+    auto upload_link = presigner_.GenerateDocumentPresignedLink(
         document_id, utils::s3_presigned_links::Upload);
 
     UploadDocumentResponse response;
@@ -51,6 +54,9 @@ class DocumentsUploadHandler final
     response.url = upload_link;
     return response.ToJsonString();
   }
+
+ private:
+  const utils::s3_presigned_links::Presigner& presigner_;
 };
 
 }  // namespace
@@ -2,18 +2,28 @@
 
 #include "view.hpp"
 
+#include <nlohmann/json.hpp>
+
 #include <userver/clients/dns/component.hpp>
 #include <userver/clients/http/component.hpp>
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
-#include <userver/http/url.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
+#include <userver/utils/datetime.hpp>
 #include <userver/utils/uuid4.hpp>
-
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include "core/docx_template/component.hpp"
+#include "core/docx_template/converter.hpp"
+#include "core/docx_template/vacation_macros.hpp"
+#include "core/org_tree/component.hpp"
+#include "core/read_routing/component.hpp"
+#include "core/tenant_query/query.hpp"
 #include "definitions/all.hpp"
+#include "utils/s3_presigned_links.hpp"
 
 using json = nlohmann::json;
 
@@ -21,6 +31,32 @@ namespace views::v1::documents::vacation {
 
 namespace {
 
+const core::tenant_query::TenantQuery kSelectAction{
+    "vacation_action_select",
+    "SELECT user_id, type, start_date, end_date, blocking_actions_ids "
+    "FROM {schema}.actions "
+    "WHERE id = $1"};
+
+const core::tenant_query::TenantQuery kSelectEmployee{
+    "vacation_employee_select",
+    "SELECT name, surname, subcompany, patronymic, position "
+    "FROM {schema}.employees "
+    "WHERE id = $1 "};
+
+const core::tenant_query::TenantQuery kInsertDocument{
+    "vacation_document_insert",
+    "INSERT INTO {schema}.documents(id, name, sign_required, type) "
+    "VALUES($1, $2, $3, $4)"};
+
+const core::tenant_query::TenantQuery kInsertEmployeeDocuments{
+    "vacation_employee_document_insert",
+    "INSERT INTO {schema}.employee_document "
+    "(employee_id, document_id, signed) "
+    "VALUES ($1, $2, $3), ($4, $2, $3) "
+    "ON CONFLICT DO NOTHING"};
+
+constexpr std::string_view kPdfFormat = "pdf";
+
 class ActionInfo {
  public:
   std::string employee_id, type;
@@ -30,13 +66,7 @@ class ActionInfo {
 
 class EmployeeInfo {
  public:
-  std::string name, surname;
-  std::optional<std::string> patronymic, head_id, position;
-};
-
-class HeadInfo {
- public:
-  std::string name, surname;
+  std::string name, surname, subcompany;
   std::optional<std::string> patronymic, position;
 };
 
@@ -55,7 +85,18 @@ class DocumentsVacationHandler final
                 .GetCluster()),
         http_client_(
             component_context.FindComponent<userver::components::HttpClient>()
-                .GetHttpClient()) {}
+                .GetHttpClient()),
+        read_router_(
+            component_context
+                .FindComponent<core::read_routing::ReadRouter>()),
+        templates_(component_context
+                       .FindComponent<core::docx_template::TemplateStore>()),
+        org_tree_(
+            component_context.FindComponent<core::org_tree::OrgTreeCache>()),
+        presigner_(
+            component_context
+                .FindComponent<utils::s3_presigned_links::Presigner>()),
+        pyservice_url_(config["pyservice-url"].As<std::string>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -71,23 +112,20 @@ class DocumentsVacationHandler final
     if (request_type.empty()) {
       request_type = "create";
     }
+    // The DOCX is served as is, a PDF is converted and stamped by the python
+    // service
+    const auto& format = request.GetArg("format");
     auto user_id = ctx.GetData<std::string>("user_id");
     const auto& company_id = ctx.GetData<std::string>("company_id");
 
     auto trx = pg_cluster_->Begin(
         "documents_vacation",
-        userver::storages::postgres::ClusterHostType::kMaster,
-        {});  // TODO: change to slave read tx
+        ctx.GetData<userver::storages::postgres::ClusterHostType>("read_host"),
+        userver::storages::postgres::TransactionOptions{
+            userver::storages::postgres::TransactionOptions::kReadOnly});
 
     auto action_info =
-        trx.Execute(
-               "SELECT user_id, type, start_date, end_date, "
-               "blocking_actions_ids "
-               "FROM working_day_" +
-                   company_id +
-                   ".actions "
-                   "WHERE id = $1",
-               action_id)
+        trx.Execute(kSelectAction.For(company_id), action_id)
             .AsSingleRow<ActionInfo>(userver::storages::postgres::kRowTag);
 
     if (request_type == "split" &&
@@ -109,91 +147,89 @@ class DocumentsVacationHandler final
     LOG_INFO() << "Employee id: (" << action_info.employee_id << ")";
 
     auto employee_info =
-        trx.Execute(
-               "SELECT name, surname, patronymic, head_id, position "
-               "FROM working_day_" +
-                   company_id +
-                   ".employees "
-                   "WHERE id = $1 ",
-               action_info.employee_id)
+        trx.Execute(kSelectEmployee.For(company_id), action_info.employee_id)
             .AsSingleRow<EmployeeInfo>(userver::storages::postgres::kRowTag);
 
-    LOG_INFO() << "Head id: ("
-               << employee_info.head_id.value_or(action_info.employee_id)
-               << ")";
-
-    auto head_info =
-        trx.Execute(
-               "SELECT name, surname, patronymic, position "
-               "FROM working_day_" +
-                   company_id +
-                   ".employees "
-                   "WHERE id = $1 ",
-               employee_info.head_id.value_or(action_info.employee_id))
-            .AsSingleRow<HeadInfo>(userver::storages::postgres::kRowTag);
-
-    PyserviceDocumentGenerateRequest link_request;
-    link_request.request_type = request_type;
-    link_request.employee_id = action_info.employee_id;
-    link_request.employee_name = employee_info.name;
-    link_request.employee_surname = employee_info.surname;
-    link_request.head_name = head_info.name;
-    link_request.head_surname = head_info.surname;
-    link_request.start_date = userver::utils::datetime::Timestring(
-        action_info.start_date, "UTC", "%d.%m.%Y");
-    link_request.end_date = userver::utils::datetime::Timestring(
-        action_info.end_date, "UTC", "%d.%m.%Y"),
-    link_request.employee_patronymic = employee_info.patronymic;
-    link_request.head_patronymic = head_info.patronymic;
-    link_request.employee_position = employee_info.position;
-    link_request.head_position = head_info.position;
+    auto head_id = org_tree_.GetHead(company_id, action_info.employee_id)
+                       .value_or(action_info.employee_id);
+    LOG_INFO() << "Head id: (" << head_id << ")";
+
+    auto head_info = org_tree_.FindEmployee(company_id, head_id);
+    if (!head_info.has_value()) {
+      trx.Rollback();
+      request.GetHttpResponse().SetStatus(
+          userver::server::http::HttpStatus::kNotFound);
+      return ErrorMessage{"Head of the employee not found"}.ToJsonString();
+    }
+
+    core::docx_template::VacationDocument document;
+    document.employee_name = employee_info.name;
+    document.employee_surname = employee_info.surname;
+    document.employee_patronymic = employee_info.patronymic;
+    document.employee_position = employee_info.position;
+    document.head_name = head_info->name;
+    document.head_surname = head_info->surname;
+    document.head_patronymic = head_info->patronymic;
+    document.head_position = head_info->position;
+    document.start_date = action_info.start_date;
+    document.end_date = action_info.end_date;
 
     if (request_type == "split") {
       auto first_action =
-          trx.Execute(
-                 "SELECT user_id, type, start_date, end_date, "
-                 "blocking_actions_ids "
-                 "FROM working_day_" +
-                     company_id +
-                     ".actions "
-                     "WHERE id = $1",
-                 action_info.blocking_actions_ids[0])
+          trx.Execute(kSelectAction.For(company_id),
+                      action_info.blocking_actions_ids[0])
               .AsSingleRow<ActionInfo>(userver::storages::postgres::kRowTag);
       auto second_action =
-          trx.Execute(
-                 "SELECT user_id, type, start_date, end_date, "
-                 "blocking_actions_ids "
-                 "FROM working_day_" +
-                     company_id +
-                     ".actions "
-                     "WHERE id = $1",
-                 action_info.blocking_actions_ids[1])
+          trx.Execute(kSelectAction.For(company_id),
+                      action_info.blocking_actions_ids[1])
               .AsSingleRow<ActionInfo>(userver::storages::postgres::kRowTag);
 
-      using namespace userver::utils::datetime;
-      link_request.first_start_date =
-          Timestring(first_action.start_date, "UTC", "%d.%m.%Y");
-      link_request.first_end_date =
-          Timestring(first_action.end_date, "UTC", "%d.%m.%Y");
-      link_request.second_start_date =
-          Timestring(second_action.start_date, "UTC", "%d.%m.%Y");
-      link_request.second_end_date =
-          Timestring(second_action.end_date, "UTC", "%d.%m.%Y");
+      document.first_start_date = first_action.start_date;
+      document.first_end_date = first_action.end_date;
+      document.second_start_date = second_action.start_date;
+      document.second_end_date = second_action.end_date;
     }
 
     trx.Commit();
 
+    const auto* docx_template =
+        templates_.Find(company_id, employee_info.subcompany, request_type);
+    if (docx_template == nullptr) {
+      request.GetHttpResponse().SetStatus(
+          userver::server::http::HttpStatus::kNotFound);
+      return ErrorMessage{"No document template for the company"}
+          .ToJsonString();
+    }
+    auto docx = docx_template->Render(core::docx_template::VacationMacros(
+        document, userver::utils::datetime::Now()));
+
     auto file_key = userver::utils::generators::GenerateUuid();
-    auto response = http_client_.CreateRequest()
-                        .post(
-                            "http://python-service:3000/"
-                            "document/generate?file_key=" +
-                            file_key)
-                        .data(link_request.ToJsonString())
-                        .retry(2)  // retry once in case of error
-                        .timeout(std::chrono::milliseconds{5000})
-                        .perform();  // start performing the request
-    response->raise_for_status();
+    std::string link;
+    if (format == kPdfFormat) {
+      auto response = core::docx_template::RequestPdf(
+          http_client_, pyservice_url_, file_key,
+          {action_info.employee_id,
+           core::docx_template::Initials(employee_info.surname,
+                                         employee_info.name,
+                                         employee_info.patronymic),
+           employee_info.subcompany},
+          std::move(docx), std::chrono::milliseconds{5000});
+      response->raise_for_status();
+      link = response->body();
+      file_key += ".pdf";
+    } else {
+      file_key += ".docx";
+      http_client_.CreateRequest()
+          .put(presigner_.GenerateDocumentPresignedLink(
+                   file_key, utils::s3_presigned_links::Upload),
+               std::move(docx))
+          .retry(2)  // retry once in case of error
+          .timeout(std::chrono::milliseconds{5000})
+          .perform()
+          ->raise_for_status();
+      link = presigner_.GenerateDocumentPresignedLink(
+          file_key, utils::s3_presigned_links::Download);
+    }
 
     auto document_name = "Запрос на отпуск " + employee_info.surname + " " +
                          employee_info.name + " " +
@@ -202,31 +238,42 @@ class DocumentsVacationHandler final
                          " - " +
                          userver::utils::datetime::Timestring(
                              action_info.end_date, "UTC", "%d.%m.%Y");
-    file_key += ".pdf";
 
+    // Signatures are stamped on PDF documents only
     pg_cluster_->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                         "INSERT INTO working_day_" + company_id +
-                             ".documents(id, name, "
-                             "sign_required, type) "
-                             "VALUES($1, $2, $3, $4)",
-                         file_key, document_name, true, "employee_request");
+                         kInsertDocument.For(company_id), file_key,
+                         document_name, format == kPdfFormat,
+                         "employee_request");
 
     pg_cluster_->Execute(
         userver::storages::postgres::ClusterHostType::kMaster,
-        "INSERT INTO working_day_" + company_id +
-            ".employee_document "
-            "(employee_id, document_id, signed) "
-            "VALUES ($1, $2, $3), ($4, $2, $3) "
-            "ON CONFLICT DO NOTHING",
-        action_info.employee_id, file_key, true,
-        employee_info.head_id.value_or(action_info.employee_id));
-
-    return response->body();
+        kInsertEmployeeDocuments.For(company_id), action_info.employee_id,
+        file_key, true, head_id);
+    read_router_.MarkWrite(request, ctx);
+
+    return link;
+  }
+
+  static userver::yaml_config::Schema GetStaticConfigSchema() {
+    return userver::yaml_config::MergeSchemas<HandlerBase>(R"(
+type: object
+description: Vacation document handler schema
+additionalProperties: false
+properties:
+    pyservice-url:
+        type: string
+        description: Url of the python service conversion to PDF
+)");
   }
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
   userver::clients::http::Client& http_client_;
+  core::read_routing::ReadRouter& read_router_;
+  const core::docx_template::TemplateStore& templates_;
+  core::org_tree::OrgTreeCache& org_tree_;
+  const utils::s3_presigned_links::Presigner& presigner_;
+  const std::string pyservice_url_;
 };
 
 }  // namespace
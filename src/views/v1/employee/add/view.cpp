@@ -2,7 +2,6 @@
 
 #include "view.hpp"
 
-#include <fmt/format.h>
 #include <codecvt>
 #include <locale>
 
@@ -19,61 +18,34 @@
 
 #include "definitions/all.hpp"
 
+#include "auth/scopes.hpp"
+#include "core/attendance_calendar/component.hpp"
+#include "core/org_tree/component.hpp"
+#include "core/read_routing/component.hpp"
+#include "core/reverse_index/pipeline.hpp"
 #include "core/reverse_index/view.hpp"
+#include "core/search_index/component.hpp"
+#include "core/tenant_query/query.hpp"
 
 namespace views::v1::employee::add {
 
 namespace {
 
-core::reverse_index::ReverseIndexResponse AddReverseIndexFunc(
-    userver::storages::postgres::ClusterPtr cluster,
-    core::reverse_index::EmployeeAllData data) {
-  std::vector<std::optional<std::string>> fields = {
-      data.name,     data.surname,     data.patronymic, data.email,
-      data.birthday, data.telegram_id, data.vk_id,      data.team};
+const core::tenant_query::TenantQuery kSelectLogin{
+    "employee_add_login_select",
+    "SELECT id FROM {schema}.employees WHERE id = $1"};
 
-  if (data.phones.has_value()) {
-    fields.insert(fields.end(), data.phones.value().begin(),
-                  data.phones.value().end());
-  }
-
-  userver::storages::postgres::ParameterStore parameters;
-  std::string filter;
-
-  parameters.PushBack(data.employee_id);
-
-  for (auto& field : fields) {
-    if (field.has_value()) {
-      auto separator = (parameters.Size() == 1 ? "[" : ", ");
-      field.value() = core::reverse_index::ConvertToLower(field.value());
-      parameters.PushBack(field.value());
-      filter += fmt::format("{}${}", separator, parameters.Size());
-    }
-  }
+const core::tenant_query::TenantQuery kInsertEmployee{
+    "employee_add_insert",
+    "INSERT INTO {schema}.employees(id, name, surname, patronymic, "
+    "password, role) VALUES($1, $2, $3, $4, $5, $6) "
+    "ON CONFLICT (id) "
+    "DO NOTHING"};
 
-  auto result =
-      cluster->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                       "WITH input_data AS ( "
-                       "  SELECT ARRAY" +
-                           filter +
-                           "] AS keys, $1 AS id "
-                           ") "
-                           "INSERT INTO working_day_" +
-                           data.company_id.value() +
-                           ".reverse_index (key, ids) "
-                           "SELECT key, ARRAY[id] AS ids "
-                           "FROM input_data, LATERAL unnest(keys) AS key "
-                           "ON CONFLICT (key) DO UPDATE "
-                           "SET ids = array_append(working_day_" +
-                           data.company_id.value() +
-                           ".reverse_index.ids, "
-                           "EXCLUDED.ids[1]); ",
-                       parameters);
-
-  core::reverse_index::ReverseIndexResponse response(data.employee_id);
-
-  return response;
-}
+const core::tenant_query::TenantQuery kInsertEmployeeTeam{
+    "employee_add_team_insert",
+    "INSERT INTO {schema}.employee_team (employee_id, team_id) "
+    "VALUES ($1, $2)"};
 
 std::string Char32ToString(char32_t ch) {
   std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> convert;
@@ -124,11 +96,9 @@ std::string generateLogin(
   int counter = 0;
 
   while (true) {
-    auto query = fmt::format(
-        "SELECT id FROM working_day_{0}.employees WHERE id = $1", company_id);
     auto result =
         cluster->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                         std::move(query), newLogin);
+                         kSelectLogin.For(company_id), newLogin);
     if (result.Size() == 0) {
       break;
     }
@@ -150,7 +120,20 @@ class AddEmployeeHandler final
         pg_cluster_(
             component_context
                 .FindComponent<userver::components::Postgres>("key-value")
-                .GetCluster()) {}
+                .GetCluster()),
+        reverse_index_(
+            component_context
+                .FindComponent<core::reverse_index::Pipeline>()),
+        search_index_(
+            component_context
+                .FindComponent<core::search_index::SearchIndex>()),
+        calendar_(component_context.FindComponent<
+                  core::attendance_calendar::AttendanceCalendar>()),
+        read_router_(
+            component_context
+                .FindComponent<core::read_routing::ReadRouter>()),
+        org_tree_(
+            component_context.FindComponent<core::org_tree::OrgTreeCache>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -164,8 +147,9 @@ class AddEmployeeHandler final
     AddEmployeeRequest request_body;
     request_body.ParseRegisteredFields(request.RequestBody());
     auto company_id = ctx.GetData<std::string>("company_id");
-    auto user_role = ctx.GetData<std::string>("user_role");
-    if (user_role == "superuser" && request_body.company_id.has_value()) {
+    auto user_role = ctx.GetData<auth::Role>("user_role");
+    if (user_role == auth::Role::kSuperuser &&
+        request_body.company_id.has_value()) {
       company_id = request_body.company_id.value();
     }
 
@@ -173,36 +157,31 @@ class AddEmployeeHandler final
                             pg_cluster_);
     auto password = userver::utils::generators::GenerateUuid().substr(0, 16);
 
-    auto query = fmt::format(
-        "INSERT INTO working_day_{0}.employees(id, name, surname, patronymic, "
-        "password, role) VALUES($1, $2, $3, $4, $5, $6) "
-        "ON CONFLICT (id) "
-        "DO NOTHING",
-        company_id);
     auto result = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kMaster, std::move(query),
-        id, request_body.name, request_body.surname, request_body.patronymic,
-        password, request_body.role);
+        userver::storages::postgres::ClusterHostType::kMaster,
+        kInsertEmployee.For(company_id), id, request_body.name,
+        request_body.surname, request_body.patronymic, password,
+        request_body.role);
 
     core::reverse_index::EmployeeAllData data{
         id, request_body.name, request_body.surname, request_body.patronymic,
         request_body.role};
     data.company_id = company_id;
 
-    userver::storages::postgres::ClusterPtr cluster = pg_cluster_;
-    core::reverse_index::ReverseIndexRequest r_index_request{
-        [cluster, data]() -> core::reverse_index::ReverseIndexResponse {
-          return AddReverseIndexFunc(cluster, data);
-        }};
+    auto keys = core::reverse_index::IndexedKeys(data);
+    reverse_index_.Push({company_id, id, {}, keys});
 
-    core::reverse_index::ReverseIndexHandler(r_index_request);
+    search_index_.AddEmployee(
+        company_id,
+        {id, request_body.name, request_body.surname, request_body.patronymic},
+        keys);
 
     result = pg_cluster_->Execute(
         userver::storages::postgres::ClusterHostType::kMaster,
-        "INSERT INTO working_day_" + company_id +
-            ".employee_team (employee_id, team_id) "
-            "VALUES ($1, $2)",
-        id, "default_team");
+        kInsertEmployeeTeam.For(company_id), id, "default_team");
+    calendar_.RefreshEmployee(company_id, id);
+    org_tree_.RefreshEmployee(company_id, id);
+    read_router_.MarkWrite(request, ctx);
 
     AddEmployeeResponse response(id, password);
     return response.ToJsonString();
@@ -210,6 +189,11 @@ class AddEmployeeHandler final
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  core::reverse_index::Pipeline& reverse_index_;
+  core::search_index::SearchIndex& search_index_;
+  core::attendance_calendar::AttendanceCalendar& calendar_;
+  core::read_routing::ReadRouter& read_router_;
+  core::org_tree::OrgTreeCache& org_tree_;
 };
 
 }  // namespace
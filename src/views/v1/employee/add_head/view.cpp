@@ -10,12 +10,21 @@
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
 
+#include "core/org_tree/component.hpp"
+#include "core/read_routing/component.hpp"
+#include "core/tenant_query/query.hpp"
 using json = nlohmann::json;
 
 namespace views::v1::employee::add_head {
 
 namespace {
 
+const core::tenant_query::TenantQuery kUpdateHead{
+    "add_head_update",
+    "UPDATE {schema}.employees "
+    "SET head_id = $2 "
+    "WHERE id = $1"};
+
 class AddHeadEmployeeRequest {
  public:
   AddHeadEmployeeRequest(const std::string& employee, const std::string& body) {
@@ -51,7 +60,12 @@ class AddHeadEmployeeHandler final
         pg_cluster_(
             component_context
                 .FindComponent<userver::components::Postgres>("key-value")
-                .GetCluster()) {}
+                .GetCluster()),
+        read_router_(
+            component_context
+                .FindComponent<core::read_routing::ReadRouter>()),
+        org_tree_(
+            component_context.FindComponent<core::org_tree::OrgTreeCache>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -75,17 +89,18 @@ class AddHeadEmployeeHandler final
 
     auto result = pg_cluster_->Execute(
         userver::storages::postgres::ClusterHostType::kMaster,
-        "UPDATE working_day_" + company_id +
-            ".employees "
-            "SET head_id = $2 "
-            "WHERE id = $1",
-        request_body.employee_id, request_body.head_id);
+        kUpdateHead.For(company_id), request_body.employee_id,
+        request_body.head_id);
+    org_tree_.RefreshEmployee(company_id, request_body.employee_id);
+    read_router_.MarkWrite(request, ctx);
 
     return "";
   }
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  core::read_routing::ReadRouter& read_router_;
+  core::org_tree::OrgTreeCache& org_tree_;
 };
 
 }  // namespace
@@ -12,6 +12,7 @@
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
 
+#include "core/tenant_query/query.hpp"
 #include "utils/s3_presigned_links.hpp"
 
 #include "definitions/all.hpp"
@@ -20,6 +21,21 @@ namespace views::v1::employee::info {
 
 namespace {
 
+const core::tenant_query::TenantQuery kSelectEmployee{
+    "employee_info_select",
+    "SELECT employees.id, employees.name, employees.surname, "
+    "employees.patronymic, "
+    "employees.photo_link, employees.phones, employees.email, "
+    "employees.birthday, employees.password, employees.head_id, "
+    "employees.telegram_id, employees.vk_id, employees.team, "
+    "case when employees.head_id is null then null else ROW (heads.id, "
+    "heads.name, "
+    "heads.surname, NULL::TEXT, NULL::TEXT) end, employees.inventory "
+    "FROM {schema}.employees as employees "
+    "LEFT JOIN {schema}.employees as heads "
+    "ON employees.head_id = heads.id "
+    "WHERE employees.id = $1"};
+
 class InfoEmployeeHandler final
     : public userver::server::handlers::HttpHandlerBase {
  public:
@@ -32,7 +48,10 @@ class InfoEmployeeHandler final
         pg_cluster_(
             component_context
                 .FindComponent<userver::components::Postgres>("key-value")
-                .GetCluster()) {}
+                .GetCluster()),
+        presigner_(
+            component_context
+                .FindComponent<utils::s3_presigned_links::Presigner>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -52,24 +71,8 @@ class InfoEmployeeHandler final
     }
 
     auto result = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kSlave,
-        "SELECT employees.id, employees.name, employees.surname, "
-        "employees.patronymic, "
-        "employees.photo_link, employees.phones, employees.email, "
-        "employees.birthday, employees.password, employees.head_id, "
-        "employees.telegram_id, employees.vk_id, employees.team, "
-        "case when employees.head_id is null then null else ROW (heads.id, "
-        "heads.name, "
-        "heads.surname, NULL::TEXT, NULL::TEXT) end, employees.inventory "
-        "FROM working_day_" +
-            company_id +
-            ".employees as employees "
-            "LEFT JOIN working_day_" +
-            company_id +
-            ".employees as heads "
-            "ON employees.head_id = heads.id "
-            "WHERE employees.id = $1",
-        employee_id);
+        ctx.GetData<userver::storages::postgres::ClusterHostType>("read_host"),
+        kSelectEmployee.For(company_id), employee_id);
 
     if (result.IsEmpty()) {
       request.GetHttpResponse().SetStatus(
@@ -81,9 +84,8 @@ class InfoEmployeeHandler final
         result.AsSingleRow<Employee>(userver::storages::postgres::kRowTag)};
 
     if (response.photo_link.has_value()) {
-      response.photo_link =
-          utils::s3_presigned_links::GeneratePhotoPresignedLink(
-              response.photo_link.value(), utils::s3_presigned_links::Download);
+      response.photo_link = presigner_.GeneratePhotoPresignedLink(
+          response.photo_link.value(), utils::s3_presigned_links::Download);
     }
 
     return response.ToJsonString();
@@ -91,6 +93,7 @@ class InfoEmployeeHandler final
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  const utils::s3_presigned_links::Presigner& presigner_;
 };
 
 }  // namespace
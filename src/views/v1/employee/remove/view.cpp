@@ -9,10 +9,14 @@
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
-#include <userver/storages/postgres/parameter_store.hpp>
 
 #include "core/json_compatible/struct.hpp"
+#include "core/org_tree/component.hpp"
+#include "core/read_routing/component.hpp"
+#include "core/reverse_index/pipeline.hpp"
 #include "core/reverse_index/view.hpp"
+#include "core/search_index/component.hpp"
+#include "core/tenant_query/query.hpp"
 
 #include "definitions/all.hpp"
 
@@ -20,6 +24,13 @@ namespace views::v1::employee::remove {
 
 namespace {
 
+const core::tenant_query::TenantQuery kDeleteEmployee{
+    "employee_remove_delete",
+    "DELETE FROM {schema}.employees "
+    "WHERE id = $1 "
+    "RETURNING name, surname, role, patronymic, phones, email, "
+    "birthday, telegram_id, vk_id, team"};
+
 struct AllValuesRow {
   std::string name, surname, role;
   std::optional<std::string> patronymic;
@@ -27,62 +38,6 @@ struct AllValuesRow {
   std::optional<std::string> email, birthday, telegram_id, vk_id, team;
 };
 
-core::reverse_index::ReverseIndexResponse DeleteReverseIndexFunc(
-    userver::storages::postgres::ClusterPtr cluster,
-    core::reverse_index::EmployeeAllData data) {
-  auto result =
-      cluster->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                       "SELECT name, surname, role, patronymic, phones, "
-                       "email, birthday, telegram_id, vk_id, team "
-                       "FROM working_day_" +
-                           data.company_id.value() +
-                           ".employees "
-                           "WHERE id = $1;",
-                       data.employee_id);
-
-  auto values_res =
-      result.AsSingleRow<AllValuesRow>(userver::storages::postgres::kRowTag);
-
-  std::vector<std::optional<std::string>> old_values = {
-      values_res.name,        values_res.surname, values_res.role,
-      values_res.patronymic,  values_res.email,   values_res.birthday,
-      values_res.telegram_id, values_res.vk_id,   values_res.team};
-
-  old_values.insert(old_values.end(), values_res.phones.begin(),
-                    values_res.phones.end());
-
-  userver::storages::postgres::ParameterStore parameters;
-  std::string filter;
-
-  parameters.PushBack(data.employee_id);
-
-  for (const auto& field : old_values) {
-    if (field.has_value()) {
-      auto separator = (parameters.Size() == 1 ? "(" : ", ");
-      parameters.PushBack(field.value());
-      filter += fmt::format("{}${}", separator, parameters.Size());
-    }
-  }
-
-  auto result2 =
-      cluster->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                       "UPDATE working_day_" + data.company_id.value() +
-                           ".reverse_index "
-                           "SET ids = array_remove(ids, $1) "
-                           "WHERE key IN " +
-                           filter +
-                           "); "
-                           "DELETE FROM working_day_" +
-                           data.company_id.value() +
-                           ".reverse_index "
-                           "WHERE key IN " +
-                           filter + ") AND ids = '{}'; ",
-                       parameters);
-
-  core::reverse_index::ReverseIndexResponse response(data.employee_id);
-  return response;
-}
-
 class RemoveEmployeeHandler final
     : public userver::server::handlers::HttpHandlerBase {
  public:
@@ -95,7 +50,20 @@ class RemoveEmployeeHandler final
         pg_cluster_(
             component_context
                 .FindComponent<userver::components::Postgres>("key-value")
-                .GetCluster()) {}
+                .GetCluster()),
+        reverse_index_(
+            component_context
+                .FindComponent<core::reverse_index::Pipeline>()),
+        search_index_(
+            component_context
+                .FindComponent<core::search_index::SearchIndex>()),
+        calendar_(component_context.FindComponent<
+                  core::attendance_calendar::AttendanceCalendar>()),
+        read_router_(
+            component_context
+                .FindComponent<core::read_routing::ReadRouter>()),
+        org_tree_(
+            component_context.FindComponent<core::org_tree::OrgTreeCache>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -116,29 +84,47 @@ class RemoveEmployeeHandler final
       return err_msg.ToJsonString();
     }
 
-    core::reverse_index::EmployeeAllData data{employee_id};
-    data.company_id = company_id;
-
-    userver::storages::postgres::ClusterPtr cluster = pg_cluster_;
-    core::reverse_index::ReverseIndexRequest r_index_request{
-        [cluster, data]() -> core::reverse_index::ReverseIndexResponse {
-          return DeleteReverseIndexFunc(cluster, data);
-        }};
-
-    core::reverse_index::ReverseIndexHandler(r_index_request);
-
     auto result = pg_cluster_->Execute(
         userver::storages::postgres::ClusterHostType::kMaster,
-        "DELETE FROM working_day_" + company_id +
-            ".employees "
-            "WHERE id = $1",
-        employee_id);
+        kDeleteEmployee.For(company_id), employee_id);
+
+    if (!result.IsEmpty()) {
+      auto values = result.AsSingleRow<AllValuesRow>(
+          userver::storages::postgres::kRowTag);
+      core::reverse_index::EmployeeAllData data{
+          employee_id,     values.name,        values.surname,
+          values.patronymic, values.role,      values.email,
+          values.birthday, values.telegram_id, values.vk_id,
+          values.team,     company_id,         values.phones};
+      reverse_index_.Push({company_id, employee_id,
+                           core::reverse_index::IndexedKeys(data), {}});
+    }
+
+    // Signed tokens of the employee stay valid until they expire otherwise
+    pg_cluster_->Execute(
+        userver::storages::postgres::ClusterHostType::kMaster,
+        "INSERT INTO wd_general.revoked_tokens "
+        "(company_id, user_id, revoked_before) "
+        "VALUES ($1, $2, NOW()) "
+        "ON CONFLICT (company_id, user_id) "
+        "DO UPDATE SET revoked_before = NOW(), updated = NOW()",
+        company_id, employee_id);
+
+    search_index_.RemoveEmployee(company_id, employee_id);
+    calendar_.RemoveEmployee(company_id, employee_id);
+    org_tree_.RemoveEmployee(company_id, employee_id);
+    read_router_.MarkWrite(request, ctx);
 
     return "";
   }
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  core::reverse_index::Pipeline& reverse_index_;
+  core::search_index::SearchIndex& search_index_;
+  core::attendance_calendar::AttendanceCalendar& calendar_;
+  core::read_routing::ReadRouter& read_router_;
+  core::org_tree::OrgTreeCache& org_tree_;
 };
 
 }  // namespace
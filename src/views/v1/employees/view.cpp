@@ -7,9 +7,8 @@
 #include <userver/components/component_context.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
-#include <userver/storages/postgres/cluster.hpp>
-#include <userver/storages/postgres/component.hpp>
 
+#include "core/org_tree/component.hpp"
 #include "definitions/all.hpp"
 #include "utils/s3_presigned_links.hpp"
 
@@ -26,10 +25,11 @@ class EmployeesHandler final
       const userver::components::ComponentConfig& config,
       const userver::components::ComponentContext& component_context)
       : HttpHandlerBase(config, component_context),
-        pg_cluster_(
+        org_tree_(
+            component_context.FindComponent<core::org_tree::OrgTreeCache>()),
+        presigner_(
             component_context
-                .FindComponent<userver::components::Postgres>("key-value")
-                .GetCluster()) {}
+                .FindComponent<utils::s3_presigned_links::Presigner>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -43,31 +43,28 @@ class EmployeesHandler final
     const auto& user_id = ctx.GetData<std::string>("user_id");
     const auto& company_id = ctx.GetData<std::string>("company_id");
 
-    auto result = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kSlave,
-        "SELECT id, name, surname, patronymic, photo_link "
-        "FROM working_day_" +
-            company_id +
-            ".employees "
-            "WHERE head_id = $1",
-        user_id);
+    // Direct reports by default, every transitive report with subtree=true
+    auto cards = request.GetArg("subtree") == "true"
+                     ? org_tree_.GetSubtree(company_id, user_id)
+                     : org_tree_.GetReports(company_id, user_id);
 
     EmployeesResponse response;
-    response.employees = result.AsContainer<std::vector<ListEmployee>>(
-        userver::storages::postgres::kRowTag);
-    for (auto& employee : response.employees) {
-      if (employee.photo_link.has_value()) {
-        employee.photo_link =
-            utils::s3_presigned_links::GeneratePhotoPresignedLink(
-                employee.photo_link.value(),
-                utils::s3_presigned_links::Download);
-      }
+    for (auto& card : cards) {
+      auto& employee = response.employees.emplace_back();
+      employee.id = std::move(card.id);
+      employee.name = std::move(card.name);
+      employee.surname = std::move(card.surname);
+      employee.patronymic = std::move(card.patronymic);
+      employee.photo_link = std::move(card.photo_link);
     }
+    utils::s3_presigned_links::SetPhotoDownloadLinks(presigner_,
+                                                      response.employees);
     return response.ToJsonString();
   }
 
  private:
-  userver::storages::postgres::ClusterPtr pg_cluster_;
+  const core::org_tree::OrgTreeCache& org_tree_;
+  const utils::s3_presigned_links::Presigner& presigner_;
 };
 
 }  // namespace
@@ -10,12 +10,20 @@
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
 
+#include "core/read_routing/component.hpp"
+#include "core/tenant_query/query.hpp"
 #include "definitions/all.hpp"
 
 namespace views::v1::inventory::add {
 
 namespace {
 
+const core::tenant_query::TenantQuery kAppendItem{
+    "inventory_add_update",
+    "UPDATE {schema}.employees "
+    "SET inventory = inventory || $1 "
+    "WHERE id = $2"};
+
 class InventoryAddHandler final
     : public userver::server::handlers::HttpHandlerBase {
  public:
@@ -28,7 +36,10 @@ class InventoryAddHandler final
         pg_cluster_(
             component_context
                 .FindComponent<userver::components::Postgres>("key-value")
-                .GetCluster()) {}
+                .GetCluster()),
+        read_router_(
+            component_context
+                .FindComponent<core::read_routing::ReadRouter>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -47,20 +58,19 @@ class InventoryAddHandler final
 
     auto result = pg_cluster_->Execute(
         userver::storages::postgres::ClusterHostType::kMaster,
-        "UPDATE working_day_" + company_id +
-            ".employees "
-            "SET inventory = inventory || $1 "
-            "WHERE id = $2",
+        kAppendItem.For(company_id),
         InventoryItemPg{request_body.item.name,
                         request_body.item.description.value_or(""),
                         request_body.item.id.value_or("")},
         request_body.employee_id);
+    read_router_.MarkWrite(request, ctx);
 
     return "";
   }
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  core::read_routing::ReadRouter& read_router_;
 };
 
 }  // namespace
@@ -0,0 +1,119 @@
+#define V1_NOTIFICATIONS_READ
+
+#include "view.hpp"
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/component.hpp>
+
+#include "core/read_routing/component.hpp"
+#include "core/tenant_query/query.hpp"
+#include "definitions/all.hpp"
+
+namespace views::v1::notifications::read {
+
+namespace {
+
+const core::tenant_query::TenantQuery kMarkRead{
+    "notifications_mark_read",
+    "UPDATE {schema}.notifications "
+    "SET is_read = TRUE "
+    "WHERE user_id = $1 AND id = ANY($2) AND NOT is_read"};
+
+const core::tenant_query::TenantQuery kMarkAllRead{
+    "notifications_mark_all_read",
+    "UPDATE {schema}.notifications "
+    "SET is_read = TRUE "
+    "WHERE user_id = $1 AND NOT is_read"};
+
+// Broadcasts are read through the marker of the user, ids of broadcasts
+// already behind read_until are dropped from it. A new marker starts when
+// the user joined.
+const core::tenant_query::TenantQuery kMarkBroadcastsRead{
+    "notifications_mark_broadcasts_read",
+    "INSERT INTO {schema}.broadcast_read_markers AS markers "
+    "(user_id, read_until, read_ids) "
+    "SELECT id, created, ARRAY("
+    "SELECT b.id FROM {schema}.broadcasts b "
+    "WHERE b.id = ANY($2) AND b.created > employees.created) "
+    "FROM {schema}.employees WHERE id = $1 "
+    "ON CONFLICT (user_id) DO UPDATE "
+    "SET read_ids = ARRAY("
+    "SELECT id FROM {schema}.broadcasts "
+    "WHERE id = ANY(markers.read_ids || EXCLUDED.read_ids) "
+    "AND created > markers.read_until)"};
+
+const core::tenant_query::TenantQuery kMarkAllBroadcastsRead{
+    "notifications_mark_all_broadcasts_read",
+    "INSERT INTO {schema}.broadcast_read_markers AS markers "
+    "(user_id, read_until) "
+    "VALUES ($1, NOW()) "
+    "ON CONFLICT (user_id) DO UPDATE "
+    "SET read_until = NOW(), read_ids = ARRAY []::TEXT[]"};
+
+// Marks the listed notifications of the user as read, all of them if the
+// list is omitted
+class NotificationsReadHandler final
+    : public userver::server::handlers::HttpHandlerBase {
+ public:
+  static constexpr std::string_view kName = "handler-v1-notifications-read";
+
+  NotificationsReadHandler(
+      const userver::components::ComponentConfig& config,
+      const userver::components::ComponentContext& component_context)
+      : HttpHandlerBase(config, component_context),
+        pg_cluster_(
+            component_context
+                .FindComponent<userver::components::Postgres>("key-value")
+                .GetCluster()),
+        read_router_(
+            component_context
+                .FindComponent<core::read_routing::ReadRouter>()) {}
+
+  std::string HandleRequestThrow(
+      const userver::server::http::HttpRequest& request,
+      userver::server::request::RequestContext& ctx) const override {
+    // CORS
+    request.GetHttpResponse().SetHeader(
+        static_cast<std::string>("Access-Control-Allow-Origin"), "*");
+    request.GetHttpResponse().SetHeader(
+        static_cast<std::string>("Access-Control-Allow-Headers"), "*");
+
+    NotificationsReadRequest request_body;
+    request_body.ParseRegisteredFields(request.RequestBody());
+    const auto& user_id = ctx.GetData<std::string>("user_id");
+    const auto& company_id = ctx.GetData<std::string>("company_id");
+
+    auto trx = pg_cluster_->Begin(
+        "notifications_read",
+        userver::storages::postgres::ClusterHostType::kMaster, {});
+    if (request_body.ids.has_value()) {
+      trx.Execute(kMarkRead.For(company_id), user_id,
+                  request_body.ids.value());
+      trx.Execute(kMarkBroadcastsRead.For(company_id), user_id,
+                  request_body.ids.value());
+    } else {
+      trx.Execute(kMarkAllRead.For(company_id), user_id);
+      trx.Execute(kMarkAllBroadcastsRead.For(company_id), user_id);
+    }
+    trx.Commit();
+    read_router_.MarkWrite(request, ctx);
+
+    return "";
+  }
+
+ private:
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+  core::read_routing::ReadRouter& read_router_;
+};
+
+}  // namespace
+
+void AppendNotificationsRead(
+    userver::components::ComponentList& component_list) {
+  component_list.Append<NotificationsReadHandler>();
+}
+
+}  // namespace views::v1::notifications::read
@@ -0,0 +1,88 @@
+#define V1_NOTIFICATIONS_UNREAD
+
+#include "view.hpp"
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/component.hpp>
+
+#include "core/tenant_query/query.hpp"
+#include "definitions/all.hpp"
+
+namespace views::v1::notifications::unread {
+
+namespace {
+
+// The personal counter is kept by triggers on notifications, see
+// count_unread_notifications(). Broadcasts are counted, only the few newer
+// than the read marker of the user are looked at.
+const core::tenant_query::TenantQuery kSelectUnread{
+    "notifications_unread_select",
+    std::string("SELECT COALESCE((SELECT unread "
+                "FROM {schema}.notification_counters "
+                "WHERE user_id = $1), 0) + ("
+                "SELECT COUNT(*) FROM {schema}.broadcasts b "
+                "LEFT JOIN {schema}.broadcast_read_markers m "
+                "ON m.user_id = $1 "
+                "WHERE b.created > ") +
+        std::string(kBroadcastsReadUntil) +
+        " AND NOT b.id = ANY(COALESCE(m.read_ids, ARRAY []::TEXT[])) "
+        "AND " +
+        std::string(kVisibleBroadcasts) + ")"};
+
+class NotificationsUnreadHandler final
+    : public userver::server::handlers::HttpHandlerBase {
+ public:
+  static constexpr std::string_view kName = "handler-v1-notifications-unread";
+
+  NotificationsUnreadHandler(
+      const userver::components::ComponentConfig& config,
+      const userver::components::ComponentContext& component_context)
+      : HttpHandlerBase(config, component_context),
+        pg_cluster_(
+            component_context
+                .FindComponent<userver::components::Postgres>("key-value")
+                .GetCluster()) {}
+
+  std::string HandleRequestThrow(
+      const userver::server::http::HttpRequest& request,
+      userver::server::request::RequestContext& ctx) const override {
+    // CORS
+    request.GetHttpResponse().SetHeader(
+        static_cast<std::string>("Access-Control-Allow-Origin"), "*");
+    request.GetHttpResponse().SetHeader(
+        static_cast<std::string>("Access-Control-Allow-Headers"), "*");
+
+    const auto& user_id = ctx.GetData<std::string>("user_id");
+    const auto& company_id = ctx.GetData<std::string>("company_id");
+
+    NotificationsUnreadResponse response;
+    response.unread = CountUnread(
+        pg_cluster_,
+        ctx.GetData<userver::storages::postgres::ClusterHostType>("read_host"),
+        company_id, user_id);
+    return response.ToJsonString();
+  }
+
+ private:
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+};
+
+}  // namespace
+
+int CountUnread(const userver::storages::postgres::ClusterPtr& pg_cluster,
+                userver::storages::postgres::ClusterHostType host,
+                const std::string& company_id, const std::string& user_id) {
+  auto result =
+      pg_cluster->Execute(host, kSelectUnread.For(company_id), user_id);
+  return static_cast<int>(result.AsSingleRow<int64_t>());
+}
+
+void AppendNotificationsUnread(
+    userver::components::ComponentList& component_list) {
+  component_list.Append<NotificationsUnreadHandler>();
+}
+
+}  // namespace views::v1::notifications::unread
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <userver/components/component_list.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+
+namespace views::v1::notifications::unread {
+
+// Condition on broadcasts `b` addressed to the user $1: sent after the user
+// joined the company, and for a team after the user joined the team
+inline constexpr std::string_view kVisibleBroadcasts =
+    "EXISTS (SELECT 1 FROM {schema}.employees e "
+    "WHERE e.id = $1 AND e.created <= b.created "
+    "AND (b.audience = 'company' OR e.subcompany = ANY(b.subcompanies) "
+    "OR EXISTS (SELECT 1 FROM {schema}.employee_team et "
+    "WHERE et.employee_id = e.id AND et.team_id = ANY(b.team_ids) "
+    "AND et.created <= b.created)))";
+
+// Broadcasts created up to it are read by the user $1 with the marker `m`,
+// the user without a marker has read none sent after joining
+inline constexpr std::string_view kBroadcastsReadUntil =
+    "COALESCE(m.read_until, "
+    "(SELECT created FROM {schema}.employees WHERE id = $1), '-infinity')";
+
+// Unread personal notifications and broadcasts of the user
+int CountUnread(const userver::storages::postgres::ClusterPtr& pg_cluster,
+                userver::storages::postgres::ClusterHostType host,
+                const std::string& company_id, const std::string& user_id);
+
+void AppendNotificationsUnread(
+    userver::components::ComponentList& component_list);
+
+}  // namespace views::v1::notifications::unread
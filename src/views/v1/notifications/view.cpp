@@ -1,6 +1,8 @@
+#define V1_NOTIFICATIONS
+
 #include "view.hpp"
 
-#include <nlohmann/json.hpp>
+#include <charconv>
 
 #include <userver/clients/dns/component.hpp>
 #include <userver/components/component_config.hpp>
@@ -9,77 +11,63 @@
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
 
+#include "core/keyset_cursor/cursor.hpp"
+#include "core/tenant_query/query.hpp"
+#include "definitions/all.hpp"
 #include "utils/s3_presigned_links.hpp"
-
-using json = nlohmann::json;
+#include "views/v1/notifications/unread/view.hpp"
 
 namespace views::v1::notifications {
 
 namespace {
 
-class ListEmployee {
- public:
-  json ToJSONObject() const {
-    json j;
-    j["id"] = id;
-    j["name"] = name;
-    j["surname"] = surname;
-    if (patronymic) {
-      j["patronymic"] = patronymic.value();
-    }
-    if (photo_link) {
-      j["photo_link"] = utils::s3_presigned_links::GeneratePhotoPresignedLink(
-          photo_link.value(), utils::s3_presigned_links::LinkType::Download);
-    }
-
-    return j;
-  }
-
-  std::string id, name, surname;
-  std::optional<std::string> patronymic, photo_link;
-};
-
-class Notification {
- public:
-  json ToJSONObject() const {
-    json j;
-    j["id"] = id;
-    j["type"] = type;
-    j["text"] = text;
-    j["is_read"] = is_read;
-    if (sender) {
-      j["sender"] = sender.value().ToJSONObject();
-    }
-    if (action_id) {
-      j["action_id"] = action_id.value();
-    }
-    j["created"] = userver::utils::datetime::Timestring(created, "UTC",
-                                                        "%Y-%m-%dT%H:%M:%E6S");
-
-    return j;
-  }
+// Personal notifications and broadcasts to the user are merged by
+// (created, id) descending. Both sides walk their feed index, broadcasts
+// are few, one per send, and their audience is checked row by row
+std::string FeedQuery(std::string_view after) {
+  return std::string(
+             "(SELECT notifications.id, type, text, is_read, "
+             "ROW (employees.id, employees.name, employees.surname, "
+             "employees.patronymic, employees.photo_link), "
+             "action_id, created "
+             "FROM {schema}.notifications "
+             "LEFT JOIN {schema}.employees "
+             "ON employees.id = notifications.sender_id "
+             "WHERE user_id = $1 ") +
+         std::string(after.empty() ? "" : "AND (created, notifications.id) ") +
+         std::string(after) +
+         "ORDER BY created DESC, notifications.id DESC "
+         "LIMIT $2) "
+         "UNION ALL "
+         "(SELECT b.id, b.type, b.text, "
+         "b.created <= " +
+         std::string(unread::kBroadcastsReadUntil) +
+         " OR COALESCE(b.id = ANY(m.read_ids), FALSE), "
+         "ROW (employees.id, employees.name, employees.surname, "
+         "employees.patronymic, employees.photo_link), "
+         "NULL::TEXT, b.created "
+         "FROM {schema}.broadcasts b "
+         "LEFT JOIN {schema}.employees ON employees.id = b.sender_id "
+         "LEFT JOIN {schema}.broadcast_read_markers m ON m.user_id = $1 "
+         "WHERE " +
+         std::string(unread::kVisibleBroadcasts) + " " +
+         std::string(after.empty() ? "" : "AND (b.created, b.id) ") +
+         std::string(after) +
+         "ORDER BY b.created DESC, b.id DESC "
+         "LIMIT $2) "
+         "ORDER BY created DESC, id DESC "
+         "LIMIT $2";
+}
 
-  std::string id, type, text;
-  bool is_read;
-  std::optional<ListEmployee> sender;
-  std::optional<std::string> action_id;
-  userver::storages::postgres::TimePoint created;
-};
+const core::tenant_query::TenantQuery kSelectFirstPage{
+    "notifications_select_first_page", FeedQuery("")};
 
-class NotificationsResponse {
- public:
-  std::string ToJSON() const {
-    json j;
-    j["notifications"] = json::array();
-    for (const auto& notification : notifications) {
-      j["notifications"].push_back(notification.ToJSONObject());
-    }
-    return j.dump();
-  }
+const core::tenant_query::TenantQuery kSelectNextPage{
+    "notifications_select_next_page", FeedQuery("< ($3, $4) ")};
 
-  std::vector<Notification> notifications;
-};
+constexpr int kMaxPageSize = 100;
 
 class NotificationsHandler final
     : public userver::server::handlers::HttpHandlerBase {
@@ -93,7 +81,10 @@ class NotificationsHandler final
         pg_cluster_(
             component_context
                 .FindComponent<userver::components::Postgres>("key-value")
-                .GetCluster()) {}
+                .GetCluster()),
+        presigner_(
+            component_context
+                .FindComponent<utils::s3_presigned_links::Presigner>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -107,42 +98,81 @@ class NotificationsHandler final
     const auto& user_id = ctx.GetData<std::string>("user_id");
     const auto& company_id = ctx.GetData<std::string>("company_id");
 
-    auto result = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kSlave,
-        "SELECT working_day_" + company_id +
-            ".notifications.id, type, text, is_read, ROW "
-            "(working_day_" +
-            company_id + ".employees.id, working_day_" + company_id +
-            ".employees.name, "
-            "working_day_" +
-            company_id + ".employees.surname, working_day_" + company_id +
-            ".employees.patronymic, "
-            "working_day_" +
-            company_id +
-            ".employees.photo_link), "
-            "action_id, created "
-            "FROM working_day_" +
-            company_id +
-            ".notifications "
-            "LEFT JOIN working_day_" +
-            company_id +
-            ".employees "
-            "ON working_day_" +
-            company_id + ".employees.id = working_day_" + company_id +
-            ".notifications.sender_id "
-            "WHERE user_id = $1 "
-            "LIMIT 100",
-        user_id);
-
-    NotificationsResponse response{
-        result.AsContainer<std::vector<Notification>>(
-            userver::storages::postgres::kRowTag)};
-
-    return response.ToJSON();
+    int limit = kMaxPageSize;
+    if (request.HasArg("limit")) {
+      const auto& arg = request.GetArg("limit");
+      const auto [ptr, error] =
+          std::from_chars(arg.data(), arg.data() + arg.size(), limit);
+      if (error != std::errc{} || ptr != arg.data() + arg.size() ||
+          limit <= 0 || limit > kMaxPageSize) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kBadRequest);
+        return ErrorMessage{"limit must be from 1 to " +
+                            std::to_string(kMaxPageSize)}
+            .ToJsonString();
+      }
+    }
+
+    std::optional<core::keyset_cursor::Cursor> cursor;
+    if (request.HasArg("cursor")) {
+      cursor = core::keyset_cursor::Decode(request.GetArg("cursor"));
+      if (!cursor.has_value()) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kBadRequest);
+        return ErrorMessage{"Malformed cursor"}.ToJsonString();
+      }
+    }
+
+    // One row more than the page tells whether there is a next page
+    const auto host =
+        ctx.GetData<userver::storages::postgres::ClusterHostType>("read_host");
+    auto result =
+        cursor.has_value()
+            ? pg_cluster_->Execute(host, kSelectNextPage.For(company_id),
+                                   user_id, limit + 1,
+                                   userver::storages::postgres::TimePointTz{
+                                       cursor->created},
+                                   cursor->id)
+            : pg_cluster_->Execute(host, kSelectFirstPage.For(company_id),
+                                   user_id, limit + 1);
+
+    auto notifications = result.AsContainer<std::vector<Notification>>(
+        userver::storages::postgres::kRowTag);
+    const bool has_next_page =
+        notifications.size() > static_cast<size_t>(limit);
+    if (has_next_page) {
+      notifications.resize(limit);
+    }
+
+    std::vector<ListEmployee> senders;
+    for (const auto& notification : notifications) {
+      if (notification.sender.has_value()) {
+        senders.push_back(notification.sender.value());
+      }
+    }
+    utils::s3_presigned_links::SetPhotoDownloadLinks(presigner_, senders);
+
+    auto sender = senders.begin();
+    JsonListWriter response("notifications");
+    for (auto& notification : notifications) {
+      if (notification.sender.has_value()) {
+        notification.sender = std::move(*sender++);
+      }
+      response.Append(notification);
+    }
+
+    if (has_next_page) {
+      const auto& last = notifications.back();
+      return std::move(response).Finish(
+          "next_cursor",
+          core::keyset_cursor::Encode({last.created, last.id}));
+    }
+    return std::move(response).Finish();
   }
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  const utils::s3_presigned_links::Presigner& presigner_;
 };
 
 }  // namespace
@@ -0,0 +1,115 @@
+#define V1_NOTIFICATIONS_WAIT
+
+#include "view.hpp"
+
+#include <charconv>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/component.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include "core/notification_hub/component.hpp"
+#include "definitions/all.hpp"
+#include "views/v1/notifications/unread/view.hpp"
+
+namespace views::v1::notifications::wait {
+
+namespace {
+
+// Long poll of the unread counter. Answers at once if the counter differs
+// from `unread` known to the client, otherwise when it changes or after
+// wait-timeout, whichever comes first. The client calls again with the
+// counter it got.
+class NotificationsWaitHandler final
+    : public userver::server::handlers::HttpHandlerBase {
+ public:
+  static constexpr std::string_view kName = "handler-v1-notifications-wait";
+
+  static userver::yaml_config::Schema GetStaticConfigSchema() {
+    return userver::yaml_config::MergeSchemas<HandlerBase>(R"(
+type: object
+description: Long poll of the unread notifications counter
+additionalProperties: false
+properties:
+    wait-timeout:
+        type: string
+        description: longest time a request waits for a change
+)");
+  }
+
+  NotificationsWaitHandler(
+      const userver::components::ComponentConfig& config,
+      const userver::components::ComponentContext& component_context)
+      : HttpHandlerBase(config, component_context),
+        pg_cluster_(
+            component_context
+                .FindComponent<userver::components::Postgres>("key-value")
+                .GetCluster()),
+        hub_(component_context
+                 .FindComponent<core::notification_hub::NotificationHub>()),
+        wait_timeout_(
+            config["wait-timeout"].As<std::chrono::milliseconds>()) {}
+
+  std::string HandleRequestThrow(
+      const userver::server::http::HttpRequest& request,
+      userver::server::request::RequestContext& ctx) const override {
+    // CORS
+    request.GetHttpResponse().SetHeader(
+        static_cast<std::string>("Access-Control-Allow-Origin"), "*");
+    request.GetHttpResponse().SetHeader(
+        static_cast<std::string>("Access-Control-Allow-Headers"), "*");
+
+    const auto& user_id = ctx.GetData<std::string>("user_id");
+    const auto& company_id = ctx.GetData<std::string>("company_id");
+
+    std::optional<int> known;
+    if (request.HasArg("unread")) {
+      const auto& arg = request.GetArg("unread");
+      int value = 0;
+      const auto [ptr, error] =
+          std::from_chars(arg.data(), arg.data() + arg.size(), value);
+      if (error != std::errc{} || ptr != arg.data() + arg.size()) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kBadRequest);
+        return ErrorMessage{"unread must be a number"}.ToJsonString();
+      }
+      known = value;
+    }
+
+    const auto deadline =
+        userver::engine::Deadline::FromDuration(wait_timeout_);
+    auto subscription = hub_.Subscribe(company_id, user_id);
+
+    NotificationsUnreadResponse response;
+    response.unread = SelectUnread(company_id, user_id);
+    if (known == response.unread && subscription.WaitUntil(deadline)) {
+      response.unread = SelectUnread(company_id, user_id);
+    }
+    return response.ToJsonString();
+  }
+
+ private:
+  // The master, the counter is read right after the change was announced
+  int SelectUnread(const std::string& company_id,
+                   const std::string& user_id) const {
+    return unread::CountUnread(
+        pg_cluster_, userver::storages::postgres::ClusterHostType::kMaster,
+        company_id, user_id);
+  }
+
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+  core::notification_hub::NotificationHub& hub_;
+  std::chrono::milliseconds wait_timeout_;
+};
+
+}  // namespace
+
+void AppendNotificationsWait(
+    userver::components::ComponentList& component_list) {
+  component_list.Append<NotificationsWaitHandler>();
+}
+
+}  // namespace views::v1::notifications::wait
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <userver/components/component_list.hpp>
+
+namespace views::v1::notifications::wait {
+
+void AppendNotificationsWait(
+    userver::components::ComponentList& component_list);
+
+}  // namespace views::v1::notifications::wait
@@ -1,6 +1,10 @@
+#define V1_PAYMENTS_ADD_BULK
+
 #include "view.hpp"
 
-#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
 
 #include <userver/clients/dns/component.hpp>
 #include <userver/components/component_config.hpp>
@@ -9,50 +13,60 @@
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
-#include <userver/utils/boost_uuid4.hpp>
-#include <userver/utils/uuid4.hpp>
+#include <userver/storages/postgres/io/array_types.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
+#include <userver/utils/datetime.hpp>
 
-using json = nlohmann::json;
+#include "core/read_routing/component.hpp"
+#include "core/tenant_query/query.hpp"
+#include "definitions/all.hpp"
 
 namespace views::v1::payments::add_bulk {
 
 namespace {
 
-class Payment {
- public:
-  Payment(const json& body) {
-    id = body["id"];
-    user_id = body["user_id"];
-    amount = body["amount"];
-    payroll_date = userver::utils::datetime::Stringtime(
-        body["payroll_date"], "UTC", "%Y-%m-%dT%H:%M:%E6S");
-  }
-
-  std::string id, user_id;
-  double amount;
-  userver::storages::postgres::TimePoint payroll_date;
+// Rows of unknown employees are left out instead of failing the foreign key,
+// rows with an id that is already stored are skipped, so that a payroll can
+// be sent again as is
+const core::tenant_query::TenantQuery kInsertPayments{
+    "payments_add_bulk_insert",
+    "WITH rows AS ("
+    "SELECT * FROM unnest($1::text[], $2::text[], $3::float8[], "
+    "$4::timestamptz[]) AS r(id, user_id, amount, payroll_date)), "
+    "inserted AS ("
+    "INSERT INTO {schema}.payments (id, user_id, amount, payroll_date) "
+    "SELECT r.id, r.user_id, r.amount, r.payroll_date "
+    "FROM rows AS r JOIN {schema}.employees AS e ON e.id = r.user_id "
+    "ON CONFLICT (id) DO NOTHING "
+    "RETURNING id) "
+    "SELECT (SELECT count(*) FROM inserted), "
+    "ARRAY(SELECT r.id FROM rows AS r WHERE NOT EXISTS ("
+    "SELECT 1 FROM {schema}.employees AS e WHERE e.id = r.user_id))"};
+
+// Bounds the size of a single statement, all chunks share one transaction
+constexpr size_t kInsertChunkSize = 5000;
+
+struct InsertResult {
+  int64_t inserted;
+  std::vector<std::string> unknown_employee_ids;
 };
 
-class PaymentsAddBulkRequest {
+// Valid rows of one statement, stored column by column as they are bound
+class PaymentColumns {
  public:
-  PaymentsAddBulkRequest(const std::string& body) {
-    auto j = json::parse(body);
-    for (const auto& p : j["payments"]) {
-      Payment payment(p);
-
-      ids.push_back(payment.id);
-      user_ids.push_back(payment.user_id);
-      amounts.push_back(payment.amount);
-      payroll_dates.push_back(payment.payroll_date);
-
-      payments.push_back(std::move(payment));
-    }
+  void Append(const PaymentItem& payment,
+              userver::storages::postgres::TimePointTz payroll_date) {
+    ids.push_back(*payment.id);
+    user_ids.push_back(*payment.user_id);
+    amounts.push_back(*payment.amount);
+    payroll_dates.push_back(payroll_date);
   }
 
-  std::vector<Payment> payments;
+  size_t Size() const { return ids.size(); }
+
   std::vector<std::string> ids, user_ids;
   std::vector<double> amounts;
-  std::vector<userver::storages::postgres::TimePoint> payroll_dates;
+  std::vector<userver::storages::postgres::TimePointTz> payroll_dates;
 };
 
 class PaymentsAddBulkHandler final
@@ -67,7 +81,10 @@ class PaymentsAddBulkHandler final
         pg_cluster_(
             component_context
                 .FindComponent<userver::components::Postgres>("key-value")
-                .GetCluster()) {}
+                .GetCluster()),
+        read_router_(
+            component_context
+                .FindComponent<core::read_routing::ReadRouter>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -78,23 +95,95 @@ class PaymentsAddBulkHandler final
     request.GetHttpResponse().SetHeader(
         static_cast<std::string>("Access-Control-Allow-Headers"), "*");
 
-    PaymentsAddBulkRequest request_body(request.RequestBody());
+    const auto& company_id = ctx.GetData<std::string>("company_id");
+
+    PaymentsAddBulkRequest request_body;
+    request_body.ParseRegisteredFields(request.RequestBody());
+
+    PaymentsAddBulkResponse response;
+    std::vector<PaymentColumns> chunks;
+    std::unordered_map<std::string_view, int> row_by_id;
+    const auto reject = [&response](int index, const PaymentItem& payment,
+                                    std::string message) {
+      PaymentRowError error;
+      error.index = index;
+      error.id = payment.id;
+      error.message = std::move(message);
+      response.errors.push_back(std::move(error));
+    };
+
+    for (size_t i = 0; i < request_body.payments.size(); ++i) {
+      const auto& payment = request_body.payments[i];
+      const auto index = static_cast<int>(i);
+      if (!payment.id.has_value() || !payment.user_id.has_value() ||
+          !payment.amount.has_value() || !payment.payroll_date.has_value()) {
+        reject(index, payment,
+               "id, user_id, amount and payroll_date are required");
+        continue;
+      }
+      if (!std::isfinite(*payment.amount)) {
+        reject(index, payment, "amount is out of range");
+        continue;
+      }
+
+      userver::storages::postgres::TimePointTz payroll_date;
+      try {
+        payroll_date = userver::storages::postgres::TimePointTz{
+            userver::utils::datetime::Stringtime(
+                *payment.payroll_date, "UTC", "%Y-%m-%dT%H:%M:%E6S")};
+      } catch (const std::exception&) {
+        reject(index, payment, "payroll_date is malformed");
+        continue;
+      }
+
+      if (!row_by_id.emplace(*payment.id, index).second) {
+        reject(index, payment, "id is repeated in the request");
+        continue;
+      }
+      if (chunks.empty() || chunks.back().Size() == kInsertChunkSize) {
+        chunks.emplace_back();
+      }
+      chunks.back().Append(payment, payroll_date);
+    }
+
+    if (!chunks.empty()) {
+      auto trx = pg_cluster_->Begin(
+          "payments_add_bulk",
+          userver::storages::postgres::ClusterHostType::kMaster, {});
+      for (const auto& chunk : chunks) {
+        auto result =
+            trx.Execute(kInsertPayments.For(company_id), chunk.ids,
+                        chunk.user_ids, chunk.amounts, chunk.payroll_dates)
+                .AsSingleRow<InsertResult>(
+                    userver::storages::postgres::kRowTag);
+
+        response.inserted += static_cast<int>(result.inserted);
+        response.existing +=
+            static_cast<int>(chunk.Size() - result.inserted -
+                             result.unknown_employee_ids.size());
+        for (const auto& id : result.unknown_employee_ids) {
+          const auto index = row_by_id.at(id);
+          reject(index, request_body.payments[index], "Unknown employee");
+        }
+      }
+      trx.Commit();
+      read_router_.MarkWrite(request, ctx);
+    }
 
-    /*auto result = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kMaster,
-        "INSERT INTO working_day.payments(id, user_id, amount, payroll_date) "
-        "VALUES (UNNEST($1), UNNEST($2), UNNEST($3), UNNEST($4)) "
-        "ON CONFLICT (id) "
-        "DO NOTHING",
-        request_body.ids, request_body.user_ids, request_body.amounts,
-        request_body.payroll_dates);*/
-    throw std::runtime_error("Not implemented");
+    std::sort(response.errors.begin(), response.errors.end(),
+              [](const PaymentRowError& lhs, const PaymentRowError& rhs) {
+                return lhs.index < rhs.index;
+              });
+    LOG_INFO() << "Payments inserted: " << response.inserted
+               << ", existing: " << response.existing
+               << ", rejected: " << response.errors.size();
 
-    return "";
+    return response.ToJsonString();
   }
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  core::read_routing::ReadRouter& read_router_;
 };
 
 }  // namespace
@@ -103,4 +192,4 @@ void AppendPaymentsAddBulk(userver::components::ComponentList& component_list) {
   component_list.Append<PaymentsAddBulkHandler>();
 }
 
-}  // namespace views::v1::payments::add_bulk
\ No newline at end of file
+}  // namespace views::v1::payments::add_bulk
@@ -10,12 +10,20 @@
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
 
+#include "core/tenant_query/query.hpp"
 using json = nlohmann::json;
 
 namespace views::v1::payments {
 
 namespace {
 
+const core::tenant_query::TenantQuery kSelectPayments{
+    "payments_select",
+    "SELECT id, user_id, amount, payroll_date "
+    "FROM {schema}.payments "
+    "WHERE user_id = $1 "
+    "LIMIT 100"};
+
 class Payment {
  public:
   json ToJSONObject() const {
@@ -75,14 +83,8 @@ class PaymentsHandler final
     const auto& company_id = ctx.GetData<std::string>("company_id");
 
     auto result = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kSlave,
-        "SELECT id, user_id, amount, payroll_date "
-        "FROM working_day_" +
-            company_id +
-            ".payments "
-            "WHERE user_id = $1 "
-            "LIMIT 100",
-        user_id);
+        ctx.GetData<userver::storages::postgres::ClusterHostType>("read_host"),
+        kSelectPayments.For(company_id), user_id);
 
     PaymentsResponse response{result.AsContainer<std::vector<Payment>>(
         userver::storages::postgres::kRowTag)};
@@ -12,6 +12,10 @@
 #include <userver/utils/boost_uuid4.hpp>
 #include <userver/utils/uuid4.hpp>
 
+#include "core/org_tree/component.hpp"
+#include "core/read_routing/component.hpp"
+#include "core/search_index/component.hpp"
+#include "core/tenant_query/query.hpp"
 #include "utils/s3_presigned_links.hpp"
 
 using json = nlohmann::json;
@@ -20,6 +24,12 @@ namespace views::v1::profile::upload_photo {
 
 namespace {
 
+const core::tenant_query::TenantQuery kUpdatePhoto{
+    "upload_photo_update",
+    "UPDATE {schema}.employees "
+    "SET photo_link = $2 "
+    "WHERE id = $1"};
+
 class UploadPhotoResponse {
  public:
   std::string ToJSON() {
@@ -44,7 +54,18 @@ class ProfileUploadPhotoHandler final
         pg_cluster_(
             component_context
                 .FindComponent<userver::components::Postgres>("key-value")
-                .GetCluster()) {}
+                .GetCluster()),
+        search_index_(
+            component_context
+                .FindComponent<core::search_index::SearchIndex>()),
+        presigner_(
+            component_context
+                .FindComponent<utils::s3_presigned_links::Presigner>()),
+        read_router_(
+            component_context
+                .FindComponent<core::read_routing::ReadRouter>()),
+        org_tree_(
+            component_context.FindComponent<core::org_tree::OrgTreeCache>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -59,16 +80,16 @@ class ProfileUploadPhotoHandler final
     const auto& company_id = ctx.GetData<std::string>("company_id");
 
     auto photo_id = userver::utils::generators::GenerateUuid();
-    auto upload_link = utils::s3_presigned_links::GeneratePhotoPresignedLink(
+    auto upload_link = presigner_.GeneratePhotoPresignedLink(
         photo_id, utils::s3_presigned_links::Upload);
 
     auto result = pg_cluster_->Execute(
         userver::storages::postgres::ClusterHostType::kMaster,
-        "UPDATE working_day_" + company_id +
-            ".employees "
-            "SET photo_link = $2 "
-            "WHERE id = $1",
-        user_id, photo_id);
+        kUpdatePhoto.For(company_id), user_id, photo_id);
+
+    search_index_.SetPhotoLink(company_id, user_id, photo_id);
+    org_tree_.RefreshEmployee(company_id, user_id);
+    read_router_.MarkWrite(request, ctx);
 
     UploadPhotoResponse response{upload_link};
     return response.ToJSON();
@@ -76,6 +97,10 @@ class ProfileUploadPhotoHandler final
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  core::search_index::SearchIndex& search_index_;
+  const utils::s3_presigned_links::Presigner& presigner_;
+  core::read_routing::ReadRouter& read_router_;
+  core::org_tree::OrgTreeCache& org_tree_;
 };
 
 }  // namespace
@@ -9,9 +9,9 @@
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
-#include <userver/storages/postgres/parameter_store.hpp>
 
-#include "core/reverse_index/view.hpp"
+#include "core/reverse_index/case_folding.hpp"
+#include "core/tenant_query/query.hpp"
 #include "definitions/all.hpp"
 #include "utils/s3_presigned_links.hpp"
 
@@ -19,6 +19,14 @@ namespace views::v1::search_basic {
 
 namespace {
 
+const core::tenant_query::TenantQuery kSelectByKey{
+    "search_basic_select",
+    "SELECT e.id, e.name, e.surname, e.patronymic, e.photo_link "
+    "FROM {schema}.reverse_index_terms AS t "
+    "JOIN {schema}.reverse_index_postings AS p ON p.term_id = t.id "
+    "JOIN {schema}.employees AS e ON e.ordinal = p.ordinal "
+    "WHERE t.key = $1"};
+
 class SearchBasicHandler final
     : public userver::server::handlers::HttpHandlerBase {
  public:
@@ -31,11 +39,10 @@ class SearchBasicHandler final
         pg_cluster_(
             component_context
                 .FindComponent<userver::components::Postgres>("key-value")
-                .GetCluster()) {}
-
-  struct IDsRow {
-    std::vector<std::string> ids;
-  };
+                .GetCluster()),
+        presigner_(
+            component_context
+                .FindComponent<utils::s3_presigned_links::Presigner>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -52,66 +59,25 @@ class SearchBasicHandler final
     request_body.ParseRegisteredFields(request.RequestBody());
 
     request_body.search_key =
-        core::reverse_index::ConvertToLower(request_body.search_key);
-
-    auto result_ids = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kSlave,
-        "SELECT ids "
-        "FROM working_day_" +
-            company_id +
-            ".reverse_index "
-            "WHERE key = $1;",
-        request_body.search_key);
-
-    auto IDs = result_ids.AsOptionalSingleRow<IDsRow>(
-        userver::storages::postgres::kRowTag);
+        core::reverse_index::FoldCase(request_body.search_key);
+
+    auto result = pg_cluster_->Execute(
+        ctx.GetData<userver::storages::postgres::ClusterHostType>("read_host"),
+        kSelectByKey.For(company_id), request_body.search_key);
 
     SearchResponse response;
+    response.employees = result.AsContainer<std::vector<ListEmployee>>(
+        userver::storages::postgres::kRowTag);
 
-    if (IDs.has_value()) {
-      userver::storages::postgres::ParameterStore parameters;
-      std::string filter;
-
-      auto append = [&](const auto& value) {
-        auto separator = (parameters.IsEmpty() ? "(" : ", ");
-        parameters.PushBack(value);
-        filter += fmt::format("{}${}", separator, parameters.Size());
-      };
-
-      for (auto& val : IDs.value().ids) {
-        append(val);
-      }
-
-      if (parameters.Size() != 0) {
-        auto result = pg_cluster_->Execute(
-            userver::storages::postgres::ClusterHostType::kSlave,
-            "SELECT id, name, surname, patronymic, photo_link "
-            "FROM working_day_" +
-                company_id +
-                ".employees "
-                "WHERE id IN " +
-                filter + ");",
-            parameters);
-
-        response.employees = result.AsContainer<std::vector<ListEmployee>>(
-            userver::storages::postgres::kRowTag);
-      }
-    }
-
-    for (auto& employee : response.employees) {
-      if (employee.photo_link.has_value()) {
-        employee.photo_link =
-            utils::s3_presigned_links::GeneratePhotoPresignedLink(
-                employee.photo_link.value(),
-                utils::s3_presigned_links::Download);
-      }
-    }
+    utils::s3_presigned_links::SetPhotoDownloadLinks(presigner_,
+                                                      response.employees);
 
     return response.ToJsonString();
   }
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  const utils::s3_presigned_links::Presigner& presigner_;
 };
 
 }  // namespace
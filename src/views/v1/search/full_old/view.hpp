@@ -1,12 +0,0 @@
-#pragma once
-
-#include <string>
-#include <string_view>
-
-#include <userver/components/component_list.hpp>
-
-namespace views::v1::search_full {
-
-void AppendSearchFull(userver::components::ComponentList& component_list);
-
-}  // namespace views::v1::search_full
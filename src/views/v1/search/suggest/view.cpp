@@ -5,7 +5,6 @@
 #include <nlohmann/json.hpp>
 
 #include <algorithm>
-#include <set>
 #include <sstream>
 #include <userver/clients/dns/component.hpp>
 #include <userver/components/component_config.hpp>
@@ -13,12 +12,11 @@
 #include <userver/logging/log.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/storages/postgres/cluster.hpp>
-#include <userver/storages/postgres/component.hpp>
-#include <userver/storages/postgres/parameter_store.hpp>
 #include <vector>
 
 #include "core/json_compatible/struct.hpp"
-#include "core/reverse_index/view.hpp"
+#include "core/reverse_index/case_folding.hpp"
+#include "core/search_index/component.hpp"
 #include "definitions/all.hpp"
 
 #include "utils/s3_presigned_links.hpp"
@@ -27,40 +25,6 @@ namespace views::v1::search_suggest {
 
 namespace {
 
-std::set<std::string> GetSuggestIds(auto& id_sets, auto& suggest_ids,
-                                    size_t n_keys, const int limit) {
-  if (id_sets.size() != n_keys - 1 || suggest_ids.size() == 0) {
-    return {};
-  }
-
-  std::set<std::string> uni;
-  for (const auto& s : suggest_ids) {
-    std::set<std::string> t;
-    set_union(uni.begin(), uni.end(), s.ids.begin(), s.ids.end(),
-              std::inserter(t, t.begin()));
-    uni = t;
-  }
-
-  std::set<std::string> res = uni;
-
-  for (const auto& set : id_sets) {
-    std::set<std::string> t;
-    set_intersection(res.begin(), res.end(), set.ids.begin(), set.ids.end(),
-                     std::inserter(t, t.begin()));
-    res = t;
-  }
-
-  std::set<std::string> final;
-  for (int i = 0; i < limit; ++i) {
-    if (!res.empty())
-      final.insert(res.extract(res.begin()).value());
-    else
-      break;
-  }
-
-  return final;
-}
-
 std::vector<std::string> SplitBySpaces(std::string str) {
   if (str.empty()) {
     return {""};
@@ -69,7 +33,7 @@ std::vector<std::string> SplitBySpaces(std::string str) {
   std::stringstream ss(str);
   std::vector<std::string> v;
   while (std::getline(ss, s, ' ')) {
-    v.push_back(core::reverse_index::ConvertToLower(s));
+    v.push_back(core::reverse_index::FoldCase(s));
   }
   return v;
 }
@@ -83,14 +47,12 @@ class SearchSuggestHandler final
       const userver::components::ComponentConfig& config,
       const userver::components::ComponentContext& component_context)
       : HttpHandlerBase(config, component_context),
-        pg_cluster_(
+        search_index_(
             component_context
-                .FindComponent<userver::components::Postgres>("key-value")
-                .GetCluster()) {}
-
-  struct IDsRow {
-    std::set<std::string> ids;
-  };
+                .FindComponent<core::search_index::SearchIndex>()),
+        presigner_(
+            component_context
+                .FindComponent<utils::s3_presigned_links::Presigner>()) {}
 
   std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
@@ -103,103 +65,38 @@ class SearchSuggestHandler final
 
     const auto& company_id = ctx.GetData<std::string>("company_id");
 
-    // lambda to add parameters
-    auto append = [](const auto& value,
-                     userver::storages::postgres::ParameterStore& parameters,
-                     std::string& filter) {
-      auto separator = (parameters.IsEmpty() ? "(" : ", ");
-      parameters.PushBack(value);
-      filter += fmt::format("{}${}", separator, parameters.Size());
-    };
-
     SearchSuggestRequest request_body;
     request_body.ParseRegisteredFields(request.RequestBody());
 
     std::vector<std::string> search_keys =
         SplitBySpaces(request_body.search_key);
 
-    // Getting a vector of sets of ids
-    userver::storages::postgres::ParameterStore parameters;
-    std::string filter;
-    for (size_t i = 0; i < search_keys.size() - 1; ++i) {
-      append(search_keys[i], parameters, filter);
-    }
-
-    std::vector<IDsRow> id_sets;
-    if (parameters.Size() > 0) {
-      auto result1 = pg_cluster_->Execute(
-          userver::storages::postgres::ClusterHostType::kMaster,
-          "SELECT ids "
-          "FROM working_day_" +
-              company_id +
-              ".reverse_index "
-              "WHERE key IN " +
-              filter + ");",
-          parameters);
-
-      id_sets = result1.AsContainer<std::vector<IDsRow>>(
-          userver::storages::postgres::kRowTag);
-    }
-
-    auto result2 = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kMaster,
-        "SELECT ids "
-        "FROM working_day_" +
-            company_id +
-            ".reverse_index "
-            "WHERE key LIKE '" +
-            search_keys[search_keys.size() - 1] +
-            "%' "
-            "ORDER BY key;");
-
-    auto suggest_id_sets = result2.AsContainer<std::vector<IDsRow>>(
-        userver::storages::postgres::kRowTag);
-
-    // Intersecting sets
+    // All keys but the last one must match exactly, the last one is a prefix
+    std::string prefix = std::move(search_keys.back());
+    search_keys.pop_back();
 
-    std::set<std::string> final_ids = GetSuggestIds(
-        id_sets, suggest_id_sets, search_keys.size(), request_body.limit);
-
-    // fetching ids' values and returning them
+    auto cards = search_index_.Suggest(company_id, search_keys, prefix,
+                                       std::max(request_body.limit, 0));
 
     SearchResponse response;
-
-    userver::storages::postgres::ParameterStore parameters_fetch;
-    std::string filter_fetch;
-
-    for (auto& val : final_ids) {
-      append(val, parameters_fetch, filter_fetch);
+    for (auto& card : cards) {
+      auto& employee = response.employees.emplace_back();
+      employee.id = std::move(card.id);
+      employee.name = std::move(card.name);
+      employee.surname = std::move(card.surname);
+      employee.patronymic = std::move(card.patronymic);
+      employee.photo_link = std::move(card.photo_link);
     }
 
-    if (parameters_fetch.Size() != 0) {
-      auto result = pg_cluster_->Execute(
-          userver::storages::postgres::ClusterHostType::kMaster,
-          "SELECT id, name, surname, patronymic, photo_link "
-          "FROM working_day_" +
-              company_id +
-              ".employees "
-              "WHERE id IN " +
-              filter_fetch + ");",
-          parameters_fetch);
-
-      response.employees = result.AsContainer<std::vector<ListEmployee>>(
-          userver::storages::postgres::kRowTag);
-    }
-
-    for (auto& employee : response.employees) {
-      if (employee.photo_link.has_value()) {
-        employee.photo_link =
-            utils::s3_presigned_links::GeneratePhotoPresignedLink(
-                employee.photo_link.value(),
-                utils::s3_presigned_links::Download);
-      }
-    }
+    utils::s3_presigned_links::SetPhotoDownloadLinks(presigner_,
+                                                      response.employees);
 
     return response.ToJsonString();
   }
 
  private:
-  userver::storages::postgres::ClusterPtr pg_cluster_;
+  const core::search_index::SearchIndex& search_index_;
+  const utils::s3_presigned_links::Presigner& presigner_;
 };
 
 }  // namespace
@@ -12,12 +12,17 @@
 #include <userver/storages/postgres/parameter_store.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
+#include "core/tenant_query/query.hpp"
 #include "definitions/all.hpp"
 
 namespace views::v1::superuser::company::add {
 
 namespace {
 
+const core::tenant_query::TenantQuery kInsertTeam{
+    "company_team_insert",
+    "INSERT INTO {schema}.teams (id, name) VALUES($1, $2)"};
+
 class SuperuserCompanyAddHandler final
     : public userver::server::handlers::HttpHandlerBase {
  public:
@@ -51,9 +56,9 @@ class SuperuserCompanyAddHandler final
       script_path = std::filesystem::current_path().parent_path().string() +
                     "/scripts/setup_company_db.sh";
     }
-    auto shell_command = script_path + " working_day_" +
-                         request_body.company_id + " '" +
-                         request_body.company_name + "' " + db_address_;
+    auto shell_command = script_path + " " +
+                         core::tenant_query::Schema(request_body.company_id) +
+                         " '" + request_body.company_name + "' " + db_address_;
     auto err_code = system(shell_command.c_str());
 
     if (err_code != 0) {
@@ -69,9 +74,7 @@ class SuperuserCompanyAddHandler final
         request_body.company_id, request_body.company_name);
 
     pg_cluster_->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                         "INSERT INTO working_day_" + request_body.company_id +
-                             " .teams "
-                             "(id, name) VALUES($1, $2)",
+                         kInsertTeam.For(request_body.company_id),
                          "default_team", "Default team");
 
     return "";
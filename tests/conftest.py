@@ -10,6 +10,9 @@ from testsuite.databases.pgsql import discover
 
 USERVER_CONFIG_HOOKS = ['userver_config_pyservice']
 
+TEMPLATES_DIR = (pathlib.Path(__file__).parent.parent /
+                 'python_service' / 'generate_document' / 'templates')
+
 pytest_plugins = ['pytest_userver.plugins.postgresql']
 
 
@@ -44,12 +47,24 @@ def userver_config_pyservice(mockserver_info):
 
         components['handler-v1-abscence-verdict'][
             'pyservice-url'
-        ] = mockserver_info.url('document/generate')
+        ] = mockserver_info.url('document/convert')
+
+        components['handler-v1-documents-vacation'][
+            'pyservice-url'
+        ] = mockserver_info.url('document/convert')
 
         components['handler-v1-documents-sign'][
             'pyservice-url'
         ] = mockserver_info.url('document/sign')
 
+        components['job-queue']['poll-interval'] = '100ms'
+        components['job-queue']['retry-delay'] = '100ms'
+        components['job-queue']['max-retry-delay'] = '100ms'
+        components['handler-v1-notifications-wait']['wait-timeout'] = '5s'
+
+        components['docx-templates']['templates-dir'] = str(TEMPLATES_DIR)
+        components['docx-templates']['default-company'] = 'esv'
+
     return do_patch
     # /// [patch configs]
 
@@ -57,8 +72,11 @@ def userver_config_pyservice(mockserver_info):
 # /// [mockserver]
 @pytest.fixture(autouse=True)
 def mock_pyservice(mockserver) -> None:
-    @mockserver.json_handler('/document/generate')
+    @mockserver.json_handler('/document/convert')
     def mock(request):
+        # The document is rendered by the service, a DOCX is a zip archive
+        assert request.get_data()[:2] == b'PK'
+        assert request.query['employee_id']
         return {
             'response': 'OK'
         }
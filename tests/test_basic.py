@@ -107,6 +107,47 @@ async def test_add_head(service_client):
     assert head_id == 'first_id'
 
 
+@pytest.mark.pgsql('db_1', files=['initial_data.sql'])
+async def test_employees_subtree(service_client):
+    for employee_id, head_id in (('second_id', 'first_id'),
+                                 ('stranger_id', 'second_id')):
+        response = await service_client.post(
+            '/v1/employee/add-head',
+            params={'employee_id': employee_id},
+            headers={'Authorization': 'Bearer first_token'},
+            json={'head_id': head_id},
+        )
+        assert response.status == 200
+
+    response = await service_client.get(
+        '/v1/employees',
+        headers={'Authorization': 'Bearer first_token'},
+    )
+    assert response.status == 200
+    assert response.text == ('{"employees":[{"id":"second_id"'
+                             ',"name":"Second","surname":"B"}]}')
+
+    response = await service_client.get(
+        '/v1/employees',
+        params={'subtree': 'true'},
+        headers={'Authorization': 'Bearer first_token'},
+    )
+    assert response.status == 200
+    assert response.text == ('{"employees":[{"id":"second_id"'
+                             ',"name":"Second","surname":"B"},'
+                             '{"id":"stranger_id"'
+                             ',"name":"Stranger","surname":"S"}]}')
+
+    response = await service_client.get(
+        '/v1/employees',
+        params={'subtree': 'true'},
+        headers={'Authorization': 'Bearer second_token'},
+    )
+    assert response.status == 200
+    assert response.text == ('{"employees":[{"id":"stranger_id"'
+                             ',"name":"Stranger","surname":"S"}]}')
+
+
 @pytest.mark.pgsql('db_1', files=['initial_data.sql'])
 async def test_add(service_client):
     response = await service_client.post(
@@ -245,6 +286,16 @@ async def test_authorize(service_client):
 
     assert response.status == 200
 
+    # Fresh token works before the auth cache update
+    token = response.json()['token']
+    response = await service_client.get(
+        '/v1/employee/info',
+        params={'employee_id': 'first_id'},
+        headers={'Authorization': 'Bearer ' + token},
+    )
+
+    assert response.status == 200
+
     # Wrong password
     response = await service_client.post(
         '/v1/authorize',
@@ -263,6 +314,15 @@ async def test_authorize(service_client):
 
     assert response.status == 403
 
+    # Wrong token again, now remembered as unknown
+    response = await service_client.get(
+        '/v1/employee/info',
+        params={'employee_id': 'first_id'},
+        headers={'Authorization': 'Bearer wrong_token'},
+    )
+
+    assert response.status == 403
+
     # Authorization header without Bearer
     response = await service_client.get(
         '/v1/employee/info',
@@ -852,6 +912,25 @@ async def test_documents_send(service_client):
     )
     assert response.status == 200
 
+    await asyncio.sleep(1)
+
+    response = await service_client.get(
+        '/v1/documents/sign-status',
+        headers={'Authorization': 'Bearer first_token'},
+        params={'document_id': 'id1'}
+    )
+    assert response.status == 200
+    response_json = json.loads(response.text)
+    assert response_json['status'] == 'done'
+    assert response_json['signed_document_id'].endswith('.pdf')
+
+    response = await service_client.get(
+        '/v1/documents/sign-status',
+        headers={'Authorization': 'Bearer second_token'},
+        params={'document_id': 'id1'}
+    )
+    assert response.status == 404
+
     response = await service_client.get(
         '/v1/documents/list-all',
         headers={'Authorization': 'Bearer ' + token},
@@ -876,6 +955,428 @@ async def test_documents_send(service_client):
         ']}')
 
 
+@pytest.mark.pgsql('db_1', files=['initial_data.sql'])
+async def test_documents_sign_after_failure(service_client, mockserver):
+    sign_fails = True
+
+    @mockserver.json_handler('/document/sign')
+    def mock(request):
+        if sign_fails:
+            return mockserver.make_response('Storage is down', status=500)
+        return {'response': 'OK'}
+
+    async def sign_status():
+        for _ in range(50):
+            response = await service_client.get(
+                '/v1/documents/sign-status',
+                headers={'Authorization': 'Bearer first_token'},
+                params={'document_id': 'id1'}
+            )
+            assert response.status == 200
+            status = json.loads(response.text)
+            if status['status'] in ('done', 'failed'):
+                return status
+            await asyncio.sleep(0.2)
+        assert False, 'The sign job did not finish'
+
+    async def sign():
+        response = await service_client.post(
+            '/v1/documents/sign',
+            headers={'Authorization': 'Bearer first_token'},
+            params={'document_id': 'id1'}
+        )
+        assert response.status == 200
+
+    response = await service_client.post(
+        '/v1/documents/send',
+        headers={'Authorization': 'Bearer first_token'},
+        json={'employee_ids': ['first_id'], 'document': {
+            'id': 'id1', 'name': 'doc1', 'sign_required': True}}
+    )
+    assert response.status == 200
+
+    await sign()
+    status = await sign_status()
+    assert status['status'] == 'failed'
+    assert 'signed_document_id' not in status
+
+    # Signing again runs the failed job from scratch
+    sign_fails = False
+    await sign()
+    status = await sign_status()
+    assert status['status'] == 'done'
+    assert status['attempts'] == 1
+    assert status['signed_document_id'].endswith('.pdf')
+
+
+@pytest.mark.pgsql('db_1', files=['initial_data.sql'])
+async def test_documents_send_selectors(service_client):
+    async def unread(token):
+        response = await service_client.get(
+            '/v1/notifications/unread',
+            headers={'Authorization': 'Bearer ' + token}
+        )
+        assert response.status == 200
+        return json.loads(response.text)['unread']
+
+    response = await service_client.post(
+        '/v1/documents/send',
+        headers={'Authorization': 'Bearer first_token'},
+        json={'team_ids': ['default_team'], 'document': {
+            'id': 'id1', 'name': 'doc1', 'sign_required': False}}
+    )
+    assert response.status == 200
+    assert await unread('first_token') == 1
+    assert await unread('second_token') == 1
+
+    response = await service_client.post(
+        '/v1/documents/send',
+        headers={'Authorization': 'Bearer first_token'},
+        json={'employee_ids': ['second_id'], 'team_ids': ['default_team'],
+              'document': {'id': 'id2', 'name': 'doc2',
+                           'sign_required': False}}
+    )
+    assert response.status == 200
+    assert await unread('first_token') == 2
+    assert await unread('second_token') == 2
+
+    response = await service_client.post(
+        '/v1/documents/send',
+        headers={'Authorization': 'Bearer first_token'},
+        json={'whole_company': True, 'document': {
+            'id': 'id3', 'name': 'doc3', 'sign_required': False}}
+    )
+    assert response.status == 200
+    assert await unread('first_token') == 3
+    assert await unread('second_token') == 3
+
+    response = await service_client.get(
+        '/v1/documents/list',
+        headers={'Authorization': 'Bearer second_token'}
+    )
+    assert response.status == 200
+    assert len(json.loads(response.text)['documents']) == 3
+
+    # The groups were told by broadcasts, merged into the personal feed
+    response = await service_client.post(
+        '/v1/notifications',
+        headers={'Authorization': 'Bearer second_token'}
+    )
+    assert response.status == 200
+    notifications = json.loads(response.text)['notifications']
+    assert len(notifications) == 3
+    assert not any(notification['is_read'] for notification in notifications)
+
+    response = await service_client.post(
+        '/v1/notifications/read',
+        headers={'Authorization': 'Bearer second_token'},
+        json={'ids': [notifications[0]['id']]}
+    )
+    assert response.status == 200
+    assert await unread('second_token') == 2
+    assert await unread('first_token') == 3
+
+    response = await service_client.post(
+        '/v1/notifications/read',
+        headers={'Authorization': 'Bearer second_token'},
+        json={}
+    )
+    assert response.status == 200
+    assert await unread('second_token') == 0
+
+    response = await service_client.post(
+        '/v1/notifications',
+        headers={'Authorization': 'Bearer second_token'}
+    )
+    assert response.status == 200
+    notifications = json.loads(response.text)['notifications']
+    assert all(notification['is_read'] for notification in notifications)
+
+    response = await service_client.post(
+        '/v1/documents/send',
+        headers={'Authorization': 'Bearer first_token'},
+        json={'document': {'id': 'id4', 'name': 'doc4',
+                           'sign_required': False}}
+    )
+    assert response.status == 400
+
+
+@pytest.mark.pgsql('db_1', files=['initial_data.sql'])
+async def test_broadcasts_overlapping_selectors(service_client):
+    # Both are in default_team and in the first subcompany
+    response = await service_client.post(
+        '/v1/documents/send',
+        headers={'Authorization': 'Bearer first_token'},
+        json={'employee_ids': ['second_id'], 'team_ids': ['default_team'],
+              'subcompanies': ['first'], 'document': {
+                  'id': 'id1', 'name': 'doc1', 'sign_required': False}}
+    )
+    assert response.status == 200
+
+    for token in ['first_token', 'second_token']:
+        response = await service_client.get(
+            '/v1/notifications/unread',
+            headers={'Authorization': 'Bearer ' + token}
+        )
+        assert response.status == 200
+        assert response.text == '{"unread":1}'
+
+        response = await service_client.post(
+            '/v1/notifications',
+            headers={'Authorization': 'Bearer ' + token}
+        )
+        assert response.status == 200
+        assert len(json.loads(response.text)['notifications']) == 1
+
+
+@pytest.mark.pgsql('db_1', files=['initial_data.sql'])
+async def test_last_write_cookie(service_client):
+    response = await service_client.get(
+        '/v1/notifications/unread',
+        headers={'Authorization': 'Bearer first_token'}
+    )
+    assert response.status == 200
+    assert 'last_write=' not in response.headers.get('Set-Cookie', '')
+
+    # Carried to whichever instance serves the next request of the client
+    response = await service_client.post(
+        '/v1/notifications/read',
+        headers={'Authorization': 'Bearer first_token'},
+        json={}
+    )
+    assert response.status == 200
+    assert 'last_write=' in response.headers.get('Set-Cookie', '')
+
+
+@pytest.mark.pgsql('db_1', files=['initial_data.sql'])
+async def test_broadcasts_audience(service_client):
+    response = await service_client.post(
+        '/v1/documents/send',
+        headers={'Authorization': 'Bearer first_token'},
+        json={'team_ids': ['default_team'], 'document': {
+            'id': 'id1', 'name': 'doc1', 'sign_required': False}}
+    )
+    assert response.status == 200
+
+    # Joins default_team after the broadcast was sent
+    response = await service_client.post(
+        '/v1/employee/add',
+        headers={'Authorization': 'Bearer first_token'},
+        json={'name': 'Third', 'surname': 'C', 'role': 'user'},
+    )
+    assert response.status == 200
+    employee_id = json.loads(response.text)['login']
+    password = json.loads(response.text)['password']
+
+    response = await service_client.post(
+        '/v1/authorize',
+        json={'login': employee_id, 'company_id': 'first', 'password': password},
+    )
+    assert response.status == 200
+    token = json.loads(response.text)['token']
+
+    response = await service_client.get(
+        '/v1/notifications/unread',
+        headers={'Authorization': 'Bearer ' + token}
+    )
+    assert response.status == 200
+    assert response.text == '{"unread":0}'
+
+    response = await service_client.post(
+        '/v1/notifications',
+        headers={'Authorization': 'Bearer ' + token}
+    )
+    assert response.status == 200
+    assert json.loads(response.text)['notifications'] == []
+
+    response = await service_client.post(
+        '/v1/documents/send',
+        headers={'Authorization': 'Bearer first_token'},
+        json={'team_ids': ['default_team'], 'document': {
+            'id': 'id2', 'name': 'doc2', 'sign_required': False}}
+    )
+    assert response.status == 200
+
+    response = await service_client.post(
+        '/v1/notifications',
+        headers={'Authorization': 'Bearer ' + token}
+    )
+    assert response.status == 200
+    notifications = json.loads(response.text)['notifications']
+    assert len(notifications) == 1
+    assert not notifications[0]['is_read']
+
+    response = await service_client.post(
+        '/v1/notifications/read',
+        headers={'Authorization': 'Bearer ' + token},
+        json={'ids': [notifications[0]['id']]}
+    )
+    assert response.status == 200
+
+    response = await service_client.get(
+        '/v1/notifications/unread',
+        headers={'Authorization': 'Bearer ' + token}
+    )
+    assert response.status == 200
+    assert response.text == '{"unread":0}'
+
+    response = await service_client.get(
+        '/v1/notifications/unread',
+        headers={'Authorization': 'Bearer first_token'}
+    )
+    assert response.status == 200
+    assert response.text == '{"unread":2}'
+
+
+@pytest.mark.pgsql('db_1', files=['initial_data.sql'])
+async def test_notifications_feed(service_client):
+    response = await service_client.post(
+        '/v1/employee/add',
+        headers={'Authorization': 'Bearer first_token'},
+        json={'name': 'Third', 'surname': 'C', 'role': 'admin'},
+    )
+    assert response.status == 200
+    employee_id = json.loads(response.text)['login']
+    password = json.loads(response.text)['password']
+
+    response = await service_client.post(
+        '/v1/authorize',
+        json={'login': employee_id, 'company_id': 'first', 'password': password},
+    )
+    assert response.status == 200
+    token = json.loads(response.text)['token']
+
+    for document_id in ['id1', 'id2', 'id3']:
+        response = await service_client.post(
+            '/v1/documents/send',
+            headers={'Authorization': 'Bearer ' + token},
+            json={'employee_ids': ['first_id'], 'document': {
+                'id': document_id, 'name': document_id,
+                'description': 'text', 'sign_required': False}}
+        )
+        assert response.status == 200
+
+    response = await service_client.get(
+        '/v1/notifications/unread',
+        headers={'Authorization': 'Bearer first_token'}
+    )
+    assert response.status == 200
+    assert response.text == '{"unread":3}'
+
+    ids = []
+    params = {'limit': '2'}
+    while True:
+        response = await service_client.post(
+            '/v1/notifications',
+            headers={'Authorization': 'Bearer first_token'},
+            params=params
+        )
+        assert response.status == 200
+        page = json.loads(response.text)
+        ids += [notification['id'] for notification in page['notifications']]
+        if 'next_cursor' not in page:
+            break
+        assert len(page['notifications']) == 2
+        params['cursor'] = page['next_cursor']
+    assert len(ids) == 3
+    assert len(set(ids)) == 3
+
+    response = await service_client.post(
+        '/v1/notifications',
+        headers={'Authorization': 'Bearer first_token'},
+        params={'cursor': 'malformed'}
+    )
+    assert response.status == 400
+
+    response = await service_client.post(
+        '/v1/notifications/read',
+        headers={'Authorization': 'Bearer first_token'},
+        json={'ids': ids[:2]}
+    )
+    assert response.status == 200
+
+    response = await service_client.get(
+        '/v1/notifications/unread',
+        headers={'Authorization': 'Bearer first_token'}
+    )
+    assert response.status == 200
+    assert response.text == '{"unread":1}'
+
+    response = await service_client.post(
+        '/v1/notifications/read',
+        headers={'Authorization': 'Bearer first_token'},
+        json={}
+    )
+    assert response.status == 200
+
+    response = await service_client.get(
+        '/v1/notifications/unread',
+        headers={'Authorization': 'Bearer first_token'}
+    )
+    assert response.status == 200
+    assert response.text == '{"unread":0}'
+
+    response = await service_client.get(
+        '/v1/notifications/unread',
+        headers={'Authorization': 'Bearer second_token'}
+    )
+    assert response.status == 200
+    assert response.text == '{"unread":0}'
+
+
+@pytest.mark.pgsql('db_1', files=['initial_data.sql'])
+async def test_notifications_wait(service_client):
+    response = await service_client.post(
+        '/v1/employee/add',
+        headers={'Authorization': 'Bearer first_token'},
+        json={'name': 'Third', 'surname': 'C', 'role': 'admin'},
+    )
+    assert response.status == 200
+    employee_id = json.loads(response.text)['login']
+    password = json.loads(response.text)['password']
+
+    response = await service_client.post(
+        '/v1/authorize',
+        json={'login': employee_id, 'company_id': 'first', 'password': password},
+    )
+    assert response.status == 200
+    token = json.loads(response.text)['token']
+
+    response = await service_client.get(
+        '/v1/notifications/wait',
+        headers={'Authorization': 'Bearer first_token'}
+    )
+    assert response.status == 200
+    assert response.text == '{"unread":0}'
+
+    wait = asyncio.create_task(service_client.get(
+        '/v1/notifications/wait',
+        headers={'Authorization': 'Bearer first_token'},
+        params={'unread': '0'}
+    ))
+
+    response = await service_client.post(
+        '/v1/documents/send',
+        headers={'Authorization': 'Bearer ' + token},
+        json={'employee_ids': ['first_id'], 'document': {
+            'id': 'id1', 'name': 'doc1',
+            'description': 'text1', 'sign_required': False}}
+    )
+    assert response.status == 200
+
+    response = await wait
+    assert response.status == 200
+    assert response.text == '{"unread":1}'
+
+    response = await service_client.get(
+        '/v1/notifications/wait',
+        headers={'Authorization': 'Bearer first_token'},
+        params={'unread': '5'}
+    )
+    assert response.status == 200
+    assert response.text == '{"unread":1}'
+
+
 @pytest.mark.pgsql('db_1', files=['initial_data.sql'])
 async def test_search_suggest(service_client):
     response = await service_client.post(
@@ -989,6 +1490,24 @@ async def test_abscence_verdict(service_client):
     assert json.loads(response.text)[
         'documents'][0]['type'] == 'employee_request'
 
+    response = await service_client.get(
+        '/v1/abscence/document-status',
+        params={'action_id': action_id},
+        headers={'Authorization': 'Bearer first_token'}
+    )
+    assert response.status == 200
+    response_json = json.loads(response.text)
+    assert response_json['status'] == 'done'
+    assert response_json['attempts'] == 1
+    assert response_json['document_id'].endswith('.pdf')
+
+    response = await service_client.get(
+        '/v1/abscence/document-status',
+        params={'action_id': 'unknown'},
+        headers={'Authorization': 'Bearer first_token'}
+    )
+    assert response.status == 404
+
 
 @pytest.mark.pgsql('db_1', files=['initial_data.sql'])
 async def test_upload_document(service_client):
@@ -1027,6 +1546,69 @@ async def test_inventory(service_client):
     )) == True
 
 
+@pytest.mark.pgsql('db_1', files=['initial_data.sql'])
+async def test_payments_add_bulk(service_client):
+    payments = [
+        {'id': 'p1', 'user_id': 'first_id', 'amount': 100.5,
+         'payroll_date': '2024-05-31T00:00:00.000000'},
+        {'id': 'p2', 'user_id': 'second_id', 'amount': 200,
+         'payroll_date': '2024-05-31T00:00:00.000000'},
+        {'id': 'p3', 'amount': 300,
+         'payroll_date': '2024-05-31T00:00:00.000000'},
+        {'id': 'p4', 'user_id': 'unknown_id', 'amount': 400,
+         'payroll_date': '2024-05-31T00:00:00.000000'},
+        {'id': 'p1', 'user_id': 'first_id', 'amount': 500,
+         'payroll_date': '2024-05-31T00:00:00.000000'},
+        {'id': 'p5', 'user_id': 'first_id', 'amount': 600,
+         'payroll_date': '31.05.2024'},
+    ]
+    response = await service_client.post(
+        '/v1/payments/add-bulk',
+        headers={'Authorization': 'Bearer first_token'},
+        json={'payments': payments},
+    )
+
+    assert response.status == 200
+    response_json = json.loads(response.text)
+    assert response_json['inserted'] == 2
+    assert response_json['existing'] == 0
+    assert [(error['index'], error['id'])
+            for error in response_json['errors']] == [
+        (2, 'p3'), (3, 'p4'), (4, 'p1'), (5, 'p5')]
+
+    # Sending the same payroll again inserts nothing
+    response = await service_client.post(
+        '/v1/payments/add-bulk',
+        headers={'Authorization': 'Bearer first_token'},
+        json={'payments': payments[:2]},
+    )
+
+    assert response.status == 200
+    response_json = json.loads(response.text)
+    assert response_json['inserted'] == 0
+    assert response_json['existing'] == 2
+    assert response_json['errors'] == []
+
+    response = await service_client.post(
+        '/v1/payments',
+        headers={'Authorization': 'Bearer second_token'},
+    )
+
+    assert response.status == 200
+    response_json = json.loads(response.text)
+    assert [(payment['id'], payment['amount'])
+            for payment in response_json['payments']] == [('p2', 200)]
+
+    # Only admins upload payments
+    response = await service_client.post(
+        '/v1/payments/add-bulk',
+        headers={'Authorization': 'Bearer second_token'},
+        json={'payments': payments[:1]},
+    )
+
+    assert response.status == 403
+
+
 @pytest.mark.pgsql('db_1', files=['initial_data.sql'])
 async def test_end(service_client):
     response = await service_client.post(